@@ -0,0 +1,139 @@
+#include "harness.hpp"
+
+// C includes
+#include <stdlib.h>
+
+// C++ includes
+#include <iomanip>
+#include <atomic>
+#include <new>
+
+/* ALLOCATION COUNTERS */
+
+static atomic<uint64_t> n_allocations(0);
+static atomic<uint64_t> n_bytes(0);
+
+static inline void count_allocation(size_t s) {
+	n_allocations.fetch_add(1, memory_order_relaxed);
+	n_bytes.fetch_add(s, memory_order_relaxed);
+}
+
+#if defined (__GLIBC__)
+
+// The chromosomes allocate their genes with malloc, so the functions
+// of the C library are replaced. The default operator new calls malloc
+// and is counted as well.
+
+extern "C" {
+
+void *__libc_malloc(size_t s);
+void *__libc_calloc(size_t n, size_t s);
+void *__libc_realloc(void *p, size_t s);
+
+void *malloc(size_t s) {
+	count_allocation(s);
+	return __libc_malloc(s);
+}
+
+void *calloc(size_t n, size_t s) {
+	count_allocation(n*s);
+	return __libc_calloc(n, s);
+}
+
+void *realloc(void *p, size_t s) {
+	count_allocation(s);
+	return __libc_realloc(p, s);
+}
+
+} // -- extern "C"
+
+#else
+
+// Only the allocations made with operator new are counted.
+
+void *operator new(size_t s) {
+	count_allocation(s);
+	void *p = malloc(s == 0 ? 1 : s);
+	if (p == nullptr) {
+		throw bad_alloc();
+	}
+	return p;
+}
+
+void *operator new[](size_t s) {
+	return operator new(s);
+}
+
+void operator delete(void *p) noexcept {
+	free(p);
+}
+
+void operator delete[](void *p) noexcept {
+	free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+	free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept {
+	free(p);
+}
+
+#endif
+
+uint64_t allocations() {
+	return n_allocations.load(memory_order_relaxed);
+}
+
+uint64_t allocated_bytes() {
+	return n_bytes.load(memory_order_relaxed);
+}
+
+/* RESULTS */
+
+double kernel_result::ns_per_op() const {
+	return (ops == 0 ? 0.0 : 1e9*seconds/ops);
+}
+
+double kernel_result::allocs_per_op() const {
+	return (ops == 0 ? 0.0 : double(allocs)/ops);
+}
+
+double kernel_result::bytes_per_op() const {
+	return (ops == 0 ? 0.0 : double(bytes)/ops);
+}
+
+void print_header(ostream& os, bool csv) {
+	if (csv) {
+		os << "kernel,ops,ns_per_op,allocs_per_op,bytes_per_op" << endl;
+		return;
+	}
+	os << left << setw(44) << "kernel"
+	   << right << setw(12) << "ops"
+	   << setw(14) << "ns/op"
+	   << setw(12) << "allocs/op"
+	   << setw(14) << "bytes/op" << endl;
+}
+
+void print_result(ostream& os, const kernel_result& r, bool csv) {
+	if (csv) {
+		os << r.name << "," << r.ops << "," << r.ns_per_op() << ","
+		   << r.allocs_per_op() << "," << r.bytes_per_op() << endl;
+		return;
+	}
+	os << left << setw(44) << r.name
+	   << right << setw(12) << r.ops
+	   << fixed << setprecision(2)
+	   << setw(14) << r.ns_per_op()
+	   << setw(12) << r.allocs_per_op()
+	   << setw(14) << r.bytes_per_op() << endl;
+	os.unsetf(ios::fixed);
+}
+
+/* HARNESS */
+
+harness::harness(double mt, bool c, const string& f, ostream& o)
+	: min_time(mt), csv(c), filter(f), os(o)
+{
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+// C++ includes
+#include <iostream>
+#include <cstdint>
+#include <string>
+using namespace std;
+
+// metaheuristics includes
+#include <metaheuristics/misc/time.hpp>
+using namespace metaheuristics;
+
+/* ALLOCATION COUNTERS */
+
+// The allocation functions are replaced in harness.cpp so that every
+// allocation of the program is counted.
+
+// Number of allocations since the start of the program.
+uint64_t allocations();
+// Bytes requested since the start of the program.
+uint64_t allocated_bytes();
+
+/* OPTIMISATION BARRIERS */
+
+// Prevents the compiler from removing the computation of v.
+template<class T>
+inline void do_not_optimise(const T& v) {
+	asm volatile("" : : "r,m"(v) : "memory");
+}
+
+// Prevents the compiler from reordering memory accesses around it.
+inline void clobber_memory() {
+	asm volatile("" : : : "memory");
+}
+
+/* RESULTS */
+
+class kernel_result {
+	public:
+		string name;
+		uint64_t ops = 0;
+		double seconds = 0.0;
+		uint64_t allocs = 0;
+		uint64_t bytes = 0;
+
+		double ns_per_op() const;
+		double allocs_per_op() const;
+		double bytes_per_op() const;
+};
+
+void print_header(ostream& os, bool csv);
+void print_result(ostream& os, const kernel_result& r, bool csv);
+
+/* HARNESS */
+
+class harness {
+	public:
+		harness(double min_time, bool csv, const string& filter, ostream& os);
+		~harness() = default;
+
+		// Runs kernel 'f' in batches of increasing size until it has been
+		// running for at least 'min_time' seconds and prints the result.
+		// Kernels whose name does not contain 'filter' are skipped.
+		template<class F>
+		void run(const string& name, F f) {
+			if (name.find(filter) == string::npos) {
+				return;
+			}
+
+			// warm up
+			f();
+
+			kernel_result r;
+			r.name = name;
+
+			uint64_t batch = 1;
+			while (r.seconds < min_time) {
+				const uint64_t a0 = allocations();
+				const uint64_t b0 = allocated_bytes();
+				const timing::time_point begin = timing::now();
+
+				for (uint64_t k = 0; k < batch; ++k) {
+					f();
+					clobber_memory();
+				}
+
+				const timing::time_point end = timing::now();
+				r.allocs += allocations() - a0;
+				r.bytes += allocated_bytes() - b0;
+				r.seconds += timing::elapsed_seconds(begin, end);
+				r.ops += batch;
+				batch *= 2;
+			}
+
+			print_result(os, r, csv);
+		}
+
+	private:
+		double min_time;
+		bool csv;
+		string filter;
+		ostream& os;
+};
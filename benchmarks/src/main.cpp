@@ -0,0 +1,220 @@
+/// C includes
+#include <string.h>
+
+/// C++ includes
+#include <iostream>
+#include <vector>
+using namespace std;
+
+/// metaheuristics includes
+#include <metaheuristics/algorithms.hpp>
+#include <metaheuristics/structures.hpp>
+using namespace metaheuristics;
+using namespace structures;
+using namespace algorithms;
+using namespace random;
+
+/// Custom includes
+#include "trivial_problem.hpp"
+#include "harness.hpp"
+
+void print_usage() {
+	cout << "Micro-benchmarks of the kernels of the metaheuristics library" << endl;
+	cout << "Usage:" << endl;
+	cout << "    [-h, --help]:        shows this help" << endl;
+	cout << "    [--filter] s:        run only the kernels whose name contains s" << endl;
+	cout << "    [--min-time] t:      minimum time, in seconds, spent on each kernel. Default: 0.2" << endl;
+	cout << "    [--csv]:             print the results in CSV format" << endl;
+	cout << endl;
+}
+
+// Gives access to the protected kernels of the BRKGA with genes
+// of type T.
+template<typename T = double>
+class kernel_brkga : public brkga<default_random_engine, problem<>, T> {
+	private:
+		typedef brkga<default_random_engine, problem<>, T> base;
+
+	public:
+		kernel_brkga(size_t p_size, size_t e_size, size_t chrom_size)
+			: base(p_size, 1, e_size, 1, chrom_size, 0.7)
+		{
+		}
+
+		// Does what brkga<>::execute_algorithm does before the
+		// first generation.
+		void prepare(const problem<> *p) {
+			this->seed(1);
+			this->initialise_generators();
+			this->elite_rng.init_uniform(0, this->N_ELITE - 1);
+			this->reset_algorithm();
+			this->initialize_population(p);
+			this->elite_set.resize(this->N_ELITE);
+			track_elite_individuals();
+		}
+
+		void crossover(size_t i, size_t j, individual<T>& child) {
+			base::crossover(i, j, child);
+		}
+		void evaluate_individual(const problem<> *p, individual<T>& i) const {
+			base::evaluate_individual(p, i);
+		}
+		void track_elite_individuals() {
+			base::track_elite_individuals();
+		}
+
+		double best_elite_fitness() const {
+			return this->elite_set[0].first;
+		}
+};
+
+// Name of the type of the genes in the names of the kernels.
+template<typename T> string gene_name();
+template<> string gene_name<double>() { return ""; }
+template<> string gene_name<float>() { return "<float>"; }
+template<> string gene_name<fixed16>() { return "<fixed16>"; }
+
+/* KERNELS */
+
+template<typename T>
+void bench_chromosome(harness& h, size_t n) {
+	chromosome<T> a, b;
+	a.set_size(n);
+	a.init();
+	b.set_size(n);
+	b.init();
+	for (size_t i = 0; i < n; ++i) {
+		a[i] = double(i)/n;
+	}
+
+	h.run("chromosome" + gene_name<T>() + "::operator=/" + to_string(n), [&]() {
+		b = a;
+		do_not_optimise(b[n - 1]);
+	});
+}
+
+template<typename T>
+void bench_crossover(harness& h, size_t n) {
+	trivial_problem p;
+	kernel_brkga<T> br(100, 20, n);
+	br.prepare(&p);
+	individual<T> child(n);
+	child.init();
+
+	h.run("genetic_algorithm" + gene_name<T>() + "::crossover/" + to_string(n), [&]() {
+		br.crossover(0, 50, child);
+		do_not_optimise(child.get_chromosome()[n - 1]);
+	});
+}
+
+void bench_make_n_uniform(harness& h, size_t n) {
+	crandom_generator<> rng;
+	rng.init_uniform(0, 1);
+	rng.seed_random_engine(1);
+	vector<double> u(n);
+
+	h.run("crandom_generator::make_n_uniform/" + to_string(n), [&]() {
+		rng.make_n_uniform(&u[0], n);
+		do_not_optimise(u[n - 1]);
+	});
+}
+
+void bench_track_elite(harness& h, size_t pop_size) {
+	trivial_problem p;
+	kernel_brkga<> br(pop_size, pop_size/5, 16);
+	br.prepare(&p);
+
+	h.run("brkga::track_elite_individuals/" + to_string(pop_size), [&]() {
+		br.track_elite_individuals();
+		do_not_optimise(br.best_elite_fitness());
+	});
+}
+
+template<typename T>
+void bench_population_set(harness& h, size_t pop_size, size_t n) {
+	const string suffix = "/" + to_string(pop_size) + "x" + to_string(n);
+	const string name = "population_set" + gene_name<T>();
+
+	h.run(name + "::construct" + suffix, [&]() {
+		population_set<T> ps(pop_size, n);
+		do_not_optimise(ps[pop_size - 1].get_chromosome()[n - 1]);
+	});
+
+	population_set<T> a(pop_size, n);
+	population_set<T> b(pop_size, n);
+	h.run(name + "::swap" + suffix, [&]() {
+		a.swap(b);
+		do_not_optimise(a[0].get_chromosome()[0]);
+	});
+	// the genetic algorithms replace the population by copy assignment
+	h.run(name + "::operator=" + suffix, [&]() {
+		a = b;
+		do_not_optimise(a[0].get_chromosome()[0]);
+	});
+}
+
+void bench_evaluate_individual(harness& h, size_t n) {
+	trivial_problem p;
+	kernel_brkga<> br(100, 20, n);
+	br.prepare(&p);
+	individual<> i(n);
+	i.init();
+
+	h.run("genetic_algorithm::evaluate_individual/" + to_string(n), [&]() {
+		br.evaluate_individual(&p, i);
+		do_not_optimise(i.get_fitness());
+	});
+}
+
+int main(int argc, char *argv[]) {
+	string filter;
+	double min_time = 0.2;
+	bool csv = false;
+
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "-h") == 0 or strcmp(argv[i], "--help") == 0) {
+			print_usage();
+			return 0;
+		}
+		else if (strcmp(argv[i], "--filter") == 0) {
+			filter = string(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--min-time") == 0) {
+			min_time = atof(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--csv") == 0) {
+			csv = true;
+		}
+	}
+
+	harness h(min_time, csv, filter, cout);
+	print_header(cout, csv);
+
+	// the compact genes are measured along with the doubles
+	for (size_t n : {16, 256, 4096}) {
+		bench_chromosome<double>(h, n);
+		bench_chromosome<float>(h, n);
+		bench_chromosome<fixed16>(h, n);
+	}
+	for (size_t n : {16, 256, 4096}) {
+		bench_crossover<double>(h, n);
+		bench_crossover<float>(h, n);
+		bench_crossover<fixed16>(h, n);
+	}
+	for (size_t n : {16, 256, 4096}) {
+		bench_make_n_uniform(h, n);
+	}
+	for (size_t pop_size : {100, 1000, 10000}) {
+		bench_track_elite(h, pop_size);
+	}
+	for (size_t pop_size : {100, 1000}) {
+		bench_population_set<double>(h, pop_size, 256);
+		bench_population_set<float>(h, pop_size, 256);
+		bench_population_set<fixed16>(h, pop_size, 256);
+	}
+	for (size_t n : {16, 256, 4096}) {
+		bench_evaluate_individual(h, n);
+	}
+}
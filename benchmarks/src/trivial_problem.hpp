@@ -0,0 +1,72 @@
+#pragma once
+
+// C++ includes
+#include <iostream>
+#include <string>
+using namespace std;
+
+// metaheuristics includes
+#include <metaheuristics/structures.hpp>
+using namespace metaheuristics;
+using namespace structures;
+using namespace random;
+
+// A problem whose decoder only adds the genes of the chromosome,
+// so that the cost of the library's kernels is measured and not
+// the cost of the problem's.
+class trivial_problem : public problem<> {
+	public:
+		trivial_problem() = default;
+		~trivial_problem() = default;
+
+		problem<> *empty() const {
+			return new trivial_problem();
+		}
+
+		double greedy_construct() {
+			value = 0.0;
+			return value;
+		}
+
+		void best_neighbour(pair<problem<> *, double>&, const local_search_policy&) {
+			n_neighbours_explored = 0;
+		}
+
+		double random_construct(drandom_generator<> *, double) {
+			value = 0.0;
+			return value;
+		}
+
+		double decode(const chromosome<>& c) {
+			value = 0.0;
+			for (size_t i = 0; i < c.size(); ++i) {
+				value += c[i];
+			}
+			return value;
+		}
+
+		double evaluate() const {
+			return value;
+		}
+
+		void print(ostream&, const string&) const { }
+
+		bool sanity_check(ostream&, const string&) const {
+			return true;
+		}
+
+		problem<> *clone() const {
+			return new trivial_problem(*this);
+		}
+
+		void copy(const problem<> *p) {
+			value = static_cast<const trivial_problem *>(p)->value;
+		}
+
+		void clear() {
+			value = 0.0;
+		}
+
+	private:
+		double value = 0.0;
+};
@@ -0,0 +1,549 @@
+/// C includes
+#include <string.h>
+
+/// C++ includes
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <limits>
+#include <algorithm>
+#include <memory>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <deque>
+#include <map>
+using namespace std;
+
+/// metaheuristics includes
+#include <metaheuristics/algorithms.hpp>
+#include <metaheuristics/structures.hpp>
+using namespace metaheuristics;
+using namespace structures;
+using namespace algorithms;
+using namespace random;
+
+/// Custom includes
+#include "parameters.hpp"
+#include "solver.hpp"
+
+void print_usage() {
+	cout << "Locations, Cities, and Centres - batch solver" << endl;
+	cout << "Reads jobs from the standard input, one per line, and writes the result" << endl;
+	cout << "of every job into the standard output as one JSON object per line." << endl;
+	cout << "A job is made of the options of the cities executable, separated by" << endl;
+	cout << "blanks, for example:" << endl;
+	cout << "    -i ../inputs/big-1.dat -a grasp --alpha 0.3 --seed-value 7" << endl;
+	cout << "Checkpoints and metrics files are not supported. Empty lines and lines" << endl;
+	cout << "starting with '#' are ignored. The results are written as the jobs" << endl;
+	cout << "finish, and field \"job\" is the index of the job in the input." << endl;
+	cout << "Usage:" << endl;
+	cout << "    [-h, --help]:        shows this help" << endl;
+	cout << "    [--workers] n:       number of jobs solved at the same time. Default: 1" << endl;
+	cout << "    [--cache] n:         number of instances kept in memory after being read," << endl;
+	cout << "                         so that later jobs on them do not read them again." << endl;
+	cout << "                         Default: 64" << endl;
+	cout << endl;
+}
+
+/* ******************************** */
+/* JOBS                             */
+/* ******************************** */
+
+class job {
+	public:
+		size_t id;
+		// the options of the job, args[0] plays the role of argv[0]
+		vector<string> args;
+};
+
+class job_result {
+	public:
+		size_t id;
+		string instance;
+		string algorithm;
+		bool has_seed;
+		uint64_t seed;
+
+		bool finished;
+		bool sane;
+		double cost;
+		bool has_optimum;
+		double optimum;
+
+		double wall_time;
+		uint64_t decodes;
+		uint64_t neighbours_explored;
+
+		// empty if the job could be executed
+		string error;
+
+		job_result() {
+			id = 0;
+			seed = 0;
+			has_seed = finished = sane = has_optimum = false;
+			cost = optimum = wall_time = 0.0;
+			decodes = neighbours_explored = 0;
+		}
+};
+
+// Writes 's' as a JSON string.
+void print_json_string(const string& s, ostream& os) {
+	os << "\"";
+	for (char c : s) {
+		if (c == '"' or c == '\\') {
+			os << '\\' << c;
+		}
+		else if (c == '\n') {
+			os << "\\n";
+		}
+		else if (c == '\t') {
+			os << "\\t";
+		}
+		else if (static_cast<unsigned char>(c) < 0x20) {
+			const char *hex = "0123456789abcdef";
+			os << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+		}
+		else {
+			os << c;
+		}
+	}
+	os << "\"";
+}
+
+void print_json(const job_result& r, ostream& os) {
+	os << "{\"job\":" << r.id << ",\"instance\":";
+	print_json_string(r.instance, os);
+	os << ",\"algorithm\":";
+	print_json_string(r.algorithm, os);
+
+	os << ",\"seed\":";
+	if (r.has_seed) { os << r.seed; } else { os << "null"; }
+	os << ",\"finished\":" << (r.finished ? "true" : "false");
+	os << ",\"sane\":" << (r.sane ? "true" : "false");
+	os << ",\"cost\":";
+	if (r.finished) { os << r.cost; } else { os << "null"; }
+	os << ",\"optimum\":";
+	if (r.has_optimum) { os << r.optimum; } else { os << "null"; }
+	os << ",\"gap\":";
+	if (r.finished and r.has_optimum) { os << r.cost - r.optimum; } else { os << "null"; }
+
+	os << ",\"wall_time\":" << r.wall_time
+	   << ",\"decodes\":" << r.decodes
+	   << ",\"neighbours_explored\":" << r.neighbours_explored;
+
+	os << ",\"error\":";
+	if (r.error.empty()) { os << "null"; } else { print_json_string(r.error, os); }
+	os << "}" << endl;
+}
+
+// Reads the jobs from an input stream. Several workers can take
+// jobs from the same reader.
+class job_reader {
+	private:
+		istream& is;
+		size_t next_id;
+		mutex m;
+
+	public:
+		job_reader(istream& i) : is(i), next_id(0) { }
+
+		// Returns false if there are no jobs left.
+		bool next(job& j) {
+			lock_guard<mutex> lock(m);
+			string line;
+			while (getline(is, line)) {
+				istringstream ss(line);
+				j.args = vector<string>(1, "");
+				string a;
+				while (ss >> a) {
+					j.args.push_back(a);
+				}
+				if (j.args.size() > 1 and j.args[1][0] != '#') {
+					j.id = next_id;
+					++next_id;
+					return true;
+				}
+			}
+			return false;
+		}
+};
+
+/* ******************************** */
+/* INSTANCES                        */
+/* ******************************** */
+
+// Instances read so far, indexed by the name of their file. Every job
+// copies the solver of its instance: the copies share the data of the
+// instance, so that it is read and preprocessed only once. When the
+// cache is full the instance read first is discarded.
+//
+// An instance is read by the first job that needs it, without holding
+// the lock of the cache: the jobs on other instances are not stalled,
+// and the jobs on the same instance wait for the one reading it.
+class instance_cache {
+	private:
+		typedef shared_future<shared_ptr<const solver> > pending_solver;
+
+		// an instance, and the number of the read that produced it
+		class entry {
+			public:
+				pending_solver s;
+				size_t read_id;
+		};
+
+		size_t capacity;
+		map<string, entry> solvers;
+		deque<string> order;
+		size_t n_reads;
+		mutex m;
+
+		// Returns nullptr if file 'filename' could not be read.
+		static shared_ptr<const solver> read(const string& filename) {
+			shared_ptr<solver> s = make_shared<solver>();
+			if (interface::is_binary_file(filename)) {
+				if (not s->read_from_binary_file(filename)) {
+					return nullptr;
+				}
+			}
+			else {
+				ifstream fin(filename.c_str());
+				if (not fin.is_open()) {
+					return nullptr;
+				}
+				s->read_from_file(fin);
+			}
+			return s;
+		}
+
+	public:
+		instance_cache(size_t c) : capacity(c), n_reads(0) { }
+
+		// Returns nullptr if file 'filename' could not be read.
+		shared_ptr<const solver> get(const string& filename) {
+			promise<shared_ptr<const solver> > p;
+			pending_solver cached;
+			size_t read_id = 0;
+			{
+				lock_guard<mutex> lock(m);
+				auto it = solvers.find(filename);
+				if (it != solvers.end()) {
+					cached = it->second.s;
+				}
+				else {
+					read_id = n_reads;
+					++n_reads;
+					if (capacity > 0) {
+						if (order.size() == capacity) {
+							solvers.erase(order.front());
+							order.pop_front();
+						}
+						solvers[filename] = entry{p.get_future().share(), read_id};
+						order.push_back(filename);
+					}
+				}
+			}
+
+			// the instance was read, or is being read, by another job:
+			// wait for it without holding the lock
+			if (cached.valid()) {
+				return cached.get();
+			}
+
+			// the jobs waiting for this read must be woken up even if
+			// it fails with an exception
+			shared_ptr<const solver> s = nullptr;
+			try {
+				s = read(filename);
+			}
+			catch (const exception&) {
+				s = nullptr;
+			}
+			p.set_value(s);
+			if (s == nullptr) {
+				// the file is read again by the next job that needs it,
+				// unless the entry was already replaced by another read
+				lock_guard<mutex> lock(m);
+				auto it = solvers.find(filename);
+				if (it != solvers.end() and it->second.read_id == read_id) {
+					solvers.erase(it);
+					order.erase(find(order.begin(), order.end(), filename));
+				}
+			}
+			return s;
+		}
+};
+
+/* ******************************** */
+/* EXECUTION                        */
+/* ******************************** */
+
+// Seeds algorithm 'a' as the cities executable does.
+template<class A>
+void seed_algorithm(A& a, bool seed, const job_result& r) {
+	if (seed) {
+		a.seed();
+	}
+	if (r.has_seed) {
+		a.seed(r.seed);
+	}
+}
+
+// Checks the size 'n' given to option 'option'. The options are parsed
+// with atoi, so negative values wrap around to sizes larger than INT_MAX.
+// Sets 'error' and returns false if 'n' is negative, or if it is zero
+// and it must be 'positive'.
+bool check_size(size_t n, const char *option, bool positive, string& error) {
+	if (n > size_t(numeric_limits<int>::max())) {
+		error = string("The value of option ") + option + " must not be negative";
+		return false;
+	}
+	if (positive and n == 0) {
+		error = string("The value of option ") + option + " must be positive";
+		return false;
+	}
+	return true;
+}
+
+// Executes job 'j'. The options are parsed like those of the cities
+// executable.
+job_result execute(job& j, instance_cache& cache) {
+	job_result r;
+	r.id = j.id;
+
+	vector<char *> argv;
+	for (string& a : j.args) {
+		argv.push_back(a.data());
+	}
+	const int argc = int(argv.size());
+	// an option missing its value at the end of the line reads an
+	// empty value instead of going past the end of argv
+	char empty_value[] = "";
+	argv.push_back(empty_value);
+
+	bool seed = false;
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "-s") == 0 or strcmp(argv[i], "--seed") == 0) {
+			seed = true;
+		}
+		else if (strcmp(argv[i], "--seed-value") == 0) {
+			r.has_seed = true;
+			r.seed = strtoull(argv[i + 1], nullptr, 10);
+			++i;
+		}
+		else if (strcmp(argv[i], "-i") == 0 or strcmp(argv[i], "--input") == 0) {
+			r.instance = string(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--optimal") == 0) {
+			r.has_optimum = true;
+			r.optimum = atof(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "-a") == 0 or strcmp(argv[i], "--algorithm") == 0) {
+			r.algorithm = string(argv[i + 1]);
+			++i;
+		}
+	}
+
+	if (r.algorithm.empty()) {
+		r.error = "Missing value for algorithm";
+		return r;
+	}
+	if (r.instance.empty()) {
+		r.error = "Missing input filename";
+		return r;
+	}
+	if (r.algorithm != "local-search" and r.algorithm != "grasp" and
+		r.algorithm != "rkga" and r.algorithm != "brkga")
+	{
+		r.error = "Wrong value for algorithm parameter";
+		return r;
+	}
+
+	shared_ptr<const solver> instance = cache.get(r.instance);
+	if (instance == nullptr) {
+		r.error = "Could not read file " + r.instance;
+		return r;
+	}
+	solver s(*instance);
+
+	profiling::metrics stats;
+	double eval = 0.0;
+
+	try {
+		if (r.algorithm == "local-search") {
+			local_search_params params;
+			parse_local_search_params(argc, argv.data(), params);
+			if (not check_size(params.MAX_ITERATIONS, "--iter-local", false, r.error)) {
+				return r;
+			}
+
+			local_search<default_random_engine, solver> ls(params.MAX_ITERATIONS, params.POLICY);
+			seed_algorithm(ls, seed, r);
+			ls.set_metrics(&stats);
+
+			eval = s.greedy_construct();
+			ls.execute_algorithm(&s, eval);
+			r.finished = true;
+		}
+		else if (r.algorithm == "grasp") {
+			grasp_params params;
+			parse_grasp_params(argc, argv.data(), params);
+			if (not check_size(params.MAX_IT_GRASP, "--iter-grasp", true, r.error) or
+				not check_size(params.MAX_IT_LOCAL, "--iter-local", false, r.error))
+			{
+				return r;
+			}
+
+			grasp<default_random_engine, solver> gs(params.MAX_IT_GRASP, params.MAX_IT_LOCAL, params.ALPHA, params.POLICY);
+			seed_algorithm(gs, seed, r);
+			gs.set_metrics(&stats);
+			r.finished = gs.execute_algorithm(&s, eval);
+			if (not r.finished) {
+				r.error = "The execution of the GRASP did not finish";
+			}
+		}
+		else if (r.algorithm == "rkga") {
+			rkga_params params;
+			parse_rkga_params(argc, argv.data(), params);
+			if (not check_size(params.POPULATION_SIZE, "--pop-size", true, r.error) or
+				not check_size(params.MUTANT_POPULATION_SIZE, "--mut-size", false, r.error) or
+				not check_size(params.NUM_GENERATIONS, "--num-gen", false, r.error))
+			{
+				return r;
+			}
+
+			rkga<default_random_engine, solver> rk
+			(
+				params.POPULATION_SIZE, params.MUTANT_POPULATION_SIZE,
+				params.NUM_GENERATIONS, s.get_n_cities(), params.INHER_PROB
+			);
+			seed_algorithm(rk, seed, r);
+			rk.set_metrics(&stats);
+			r.finished = rk.execute_algorithm(&s, eval);
+			if (not r.finished) {
+				if (params.MUTANT_POPULATION_SIZE >= params.POPULATION_SIZE) {
+					r.error = "The number of mutants must be smaller than the size of the population";
+				}
+				else {
+					r.error = "The execution of the RKGA did not finish";
+				}
+			}
+		}
+		else if (r.algorithm == "brkga") {
+			brkga_params params;
+			parse_brkga_params(argc, argv.data(), params);
+			if (not check_size(params.POPULATION_SIZE, "--pop-size", true, r.error) or
+				not check_size(params.MUTANT_POPULATION_SIZE, "--mut-size", false, r.error) or
+				not check_size(params.ELITE_SET_SIZE, "--elite-size", false, r.error) or
+				not check_size(params.NUM_GENERATIONS, "--num-gen", false, r.error))
+			{
+				return r;
+			}
+
+			brkga<default_random_engine, solver> br
+			(
+				params.POPULATION_SIZE, params.MUTANT_POPULATION_SIZE, params.ELITE_SET_SIZE,
+				params.NUM_GENERATIONS, s.get_n_cities(), params.INHER_PROB
+			);
+			seed_algorithm(br, seed, r);
+			br.set_adaptive_parameters(params.ADAPTIVE);
+			br.set_metrics(&stats);
+			r.finished = br.execute_algorithm(&s, eval);
+			if (not r.finished) {
+				if (params.MUTANT_POPULATION_SIZE + params.ELITE_SET_SIZE >= params.POPULATION_SIZE) {
+					r.error = "The number of mutants plus the size of the elite set must be "
+							  "smaller than the size of the population";
+				}
+				else {
+					r.error = "The execution of the BRKGA did not finish";
+				}
+			}
+		}
+	}
+	catch (const infeasible_exception& e) {
+		r.finished = false;
+		r.error = e.what();
+	}
+	// a job that fails must not stop the jobs after it
+	catch (const exception& e) {
+		r.finished = false;
+		r.error = string("Exception thrown: ") + e.what();
+	}
+	catch (...) {
+		r.finished = false;
+		r.error = "Unknown exception thrown";
+	}
+
+	if (r.finished) {
+		// the reasons why a solution is not sane are not reported
+		ostringstream discard;
+		r.sane = s.sanity_check(discard);
+		r.cost = -eval;
+	}
+	r.wall_time = stats.get_wall_time();
+	r.decodes = stats.get_counter(profiling::metrics::counter::decodes);
+	r.neighbours_explored =
+		stats.get_counter(profiling::metrics::counter::neighbours_explored);
+	return r;
+}
+
+int main(int argc, char *argv[]) {
+	/* ******************************** */
+	// ------- PARSE PARAMATERS ------- //
+	/* ******************************** */
+
+	size_t n_workers = 1;
+	size_t cache_size = 64;
+
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "-h") == 0 or strcmp(argv[i], "--help") == 0) {
+			print_usage();
+			return 0;
+		}
+		else if (strcmp(argv[i], "--workers") == 0) {
+			n_workers = atoi(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--cache") == 0) {
+			cache_size = atoi(argv[i + 1]);
+			++i;
+		}
+	}
+
+	if (n_workers == 0) {
+		cerr << "Error: The number of workers must be at least 1" << endl;
+		return 1;
+	}
+
+	cout.precision(numeric_limits<double>::max_digits10);
+
+	/* ******************************** */
+	// --------- SOLVE THE JOBS ------- //
+	/* ******************************** */
+
+	job_reader reader(cin);
+	instance_cache cache(cache_size);
+	mutex out_mutex;
+
+	auto work =
+	[&]() -> void {
+		job j;
+		while (reader.next(j)) {
+			const job_result r = execute(j, cache);
+
+			lock_guard<mutex> lock(out_mutex);
+			print_json(r, cout);
+		}
+	};
+
+	vector<thread> workers;
+	for (size_t w = 1; w < n_workers; ++w) {
+		workers.push_back(thread(work));
+	}
+	work();
+	for (thread& t : workers) {
+		t.join();
+	}
+}
@@ -0,0 +1,419 @@
+/// C includes
+#include <string.h>
+
+/// C++ includes
+#include <filesystem>
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <limits>
+#include <vector>
+using namespace std;
+
+/// metaheuristics includes
+#include <metaheuristics/algorithms.hpp>
+#include <metaheuristics/structures.hpp>
+using namespace metaheuristics;
+using namespace structures;
+using namespace algorithms;
+using namespace random;
+
+/// Custom includes
+#include "solver.hpp"
+
+void print_usage() {
+	cout << "Locations, Cities, and Centres - benchmark" << endl;
+	cout << "Runs every algorithm over every instance with fixed seeds" << endl;
+	cout << "and reports one line per execution." << endl;
+	cout << "Usage:" << endl;
+	cout << "    [-h, --help]:        shows this help" << endl;
+	cout << "    [--inputs] d:        directory with the instances (*.dat) and the" << endl;
+	cout << "                         ILP solutions (*-ILP.sol). Default: ../inputs" << endl;
+	cout << "    [-a, --algorithm] a: execute only algorithm a. Can be given several" << endl;
+	cout << "                         times. Default: local-search, grasp, rkga, brkga" << endl;
+	cout << "    [--reps] r:          repetitions of each algorithm on each instance. Default: 5" << endl;
+	cout << "    [--seed] s:          seed of the first repetition. Repetition k uses" << endl;
+	cout << "                         seed s + k. Default: 1" << endl;
+	cout << "    [--target-gap] g:    relative gap to the optimum used for the" << endl;
+	cout << "                         time-to-target. Default: 0.01" << endl;
+	cout << "    [--format] f:        output format: csv or json (one object per line). Default: csv" << endl;
+	cout << "    [-o, --output] f:    write the results into file f. Default: standard output" << endl;
+	cout << endl;
+}
+
+/* ******************************** */
+/* BENCHMARK CONFIGURATION          */
+/* ******************************** */
+
+// The parameters of the algorithms are fixed so that the results of
+// different builds can be compared.
+
+const size_t LS_MAX_ITERATIONS = 10;
+
+const size_t GS_MAX_IT_GRASP = 10;
+const size_t GS_MAX_IT_LOCAL = 10;
+const double GS_ALPHA = 0.3;
+
+const size_t GA_NUM_GENERATIONS = 40;
+const size_t GA_POPULATION_SIZE = 40;
+const size_t GA_MUTANT_POPULATION_SIZE = 8;
+const size_t GA_ELITE_SET_SIZE = 8;
+const double GA_INHER_PROB = 0.7;
+
+/* ******************************** */
+/* TIME-TO-TARGET                   */
+/* ******************************** */
+
+// Records the first moment at which the cost of the best solution
+// found reaches the target. The cities' fitness is minus their cost.
+class target_observer : public observer<> {
+	public:
+		double target;
+		bool reached;
+		double time_to_target;
+		timing::time_point begin;
+		
+		target_observer(double t) {
+			target = t;
+			reached = false;
+			time_to_target = 0.0;
+			begin = timing::now();
+		}
+		
+		void on_improvement(double best) {
+			if (not reached and -best <= target) {
+				reached = true;
+				time_to_target = timing::elapsed_seconds(begin, timing::now());
+			}
+		}
+};
+
+/* ******************************** */
+/* RESULTS                          */
+/* ******************************** */
+
+class run_result {
+	public:
+		string instance;
+		string algorithm;
+		size_t rep;
+		uint64_t seed;
+		
+		bool finished;
+		bool has_optimum;
+		double optimum;
+		double cost;
+		
+		bool reached_target;
+		double time_to_target;
+		
+		double wall_time;
+		uint64_t decodes;
+		double decodes_per_second;
+		uint64_t neighbours_explored;
+		
+		run_result() {
+			rep = 0;
+			seed = 0;
+			finished = has_optimum = reached_target = false;
+			optimum = cost = time_to_target = 0.0;
+			wall_time = decodes_per_second = 0.0;
+			decodes = neighbours_explored = 0;
+		}
+};
+
+void print_csv_header(ostream& os) {
+	os << "instance,algorithm,rep,seed,finished,cost,optimum,gap,gap_pct,"
+	   << "reached_target,time_to_target,wall_time,decodes,decodes_per_second,"
+	   << "neighbours_explored" << endl;
+}
+
+void print_csv(const run_result& r, ostream& os) {
+	os << r.instance << "," << r.algorithm << "," << r.rep << "," << r.seed << ","
+	   << (r.finished ? 1 : 0) << ",";
+	
+	if (r.finished) {
+		os << r.cost;
+	}
+	os << ",";
+	if (r.has_optimum) {
+		os << r.optimum;
+	}
+	os << ",";
+	if (r.finished and r.has_optimum) {
+		os << r.cost - r.optimum << "," << 100.0*(r.cost - r.optimum)/r.optimum;
+	}
+	else {
+		os << ",";
+	}
+	os << "," << (r.reached_target ? 1 : 0) << ",";
+	if (r.reached_target) {
+		os << r.time_to_target;
+	}
+	os << "," << r.wall_time << "," << r.decodes << "," << r.decodes_per_second
+	   << "," << r.neighbours_explored << endl;
+}
+
+void print_json(const run_result& r, ostream& os) {
+	os << "{\"instance\":\"" << r.instance << "\","
+	   << "\"algorithm\":\"" << r.algorithm << "\","
+	   << "\"rep\":" << r.rep << ","
+	   << "\"seed\":" << r.seed << ","
+	   << "\"finished\":" << (r.finished ? "true" : "false") << ",";
+	
+	os << "\"cost\":";
+	if (r.finished) { os << r.cost; } else { os << "null"; }
+	os << ",\"optimum\":";
+	if (r.has_optimum) { os << r.optimum; } else { os << "null"; }
+	os << ",\"gap\":";
+	if (r.finished and r.has_optimum) { os << r.cost - r.optimum; } else { os << "null"; }
+	os << ",\"gap_pct\":";
+	if (r.finished and r.has_optimum) {
+		os << 100.0*(r.cost - r.optimum)/r.optimum;
+	}
+	else {
+		os << "null";
+	}
+	os << ",\"time_to_target\":";
+	if (r.reached_target) { os << r.time_to_target; } else { os << "null"; }
+	
+	os << ",\"wall_time\":" << r.wall_time
+	   << ",\"decodes\":" << r.decodes
+	   << ",\"decodes_per_second\":" << r.decodes_per_second
+	   << ",\"neighbours_explored\":" << r.neighbours_explored
+	   << "}" << endl;
+}
+
+/* ******************************** */
+/* INSTANCES                        */
+/* ******************************** */
+
+// Reads the value of the objective function in an ILP solution file.
+bool read_optimum(const string& filename, double& opt) {
+	ifstream fin(filename.c_str());
+	if (not fin.is_open()) {
+		return false;
+	}
+	
+	const string key = "Objective function=";
+	string line;
+	while (getline(fin, line)) {
+		size_t p = line.find(key);
+		if (p != string::npos) {
+			opt = atof(line.c_str() + p + key.size());
+			return true;
+		}
+	}
+	return false;
+}
+
+// Returns the instances in directory 'dir' sorted by name.
+vector<string> find_instances(const string& dir) {
+	vector<string> instances;
+	for (const auto& e : filesystem::directory_iterator(dir)) {
+		if (e.path().extension() == ".dat") {
+			instances.push_back(e.path().stem().string());
+		}
+	}
+	sort(instances.begin(), instances.end());
+	return instances;
+}
+
+/* ******************************** */
+/* EXECUTION                        */
+/* ******************************** */
+
+// Executes algorithm 'algorithm' on solution 's' seeding the
+// algorithm with 'seed'. Returns false if the execution did not finish.
+bool execute
+(
+	const string& algorithm, uint64_t seed, solver *s,
+	target_observer& obs, profiling::metrics& stats, double& eval
+)
+{
+	if (algorithm == "local-search") {
+		local_search<default_random_engine, solver> ls(LS_MAX_ITERATIONS, Best_Improvement);
+		ls.seed(seed);
+		ls.set_observer(&obs);
+		ls.set_metrics(&stats);
+		
+		eval = s->greedy_construct();
+		obs.on_improvement(eval);
+		ls.execute_algorithm(s, eval);
+		return true;
+	}
+	if (algorithm == "grasp") {
+		grasp<default_random_engine, solver> gs(GS_MAX_IT_GRASP, GS_MAX_IT_LOCAL, GS_ALPHA, Best_Improvement);
+		gs.seed(seed);
+		gs.set_observer(&obs);
+		gs.set_metrics(&stats);
+		return gs.execute_algorithm(s, eval);
+	}
+	if (algorithm == "rkga") {
+		rkga<default_random_engine, solver> r
+		(
+			GA_POPULATION_SIZE, GA_MUTANT_POPULATION_SIZE,
+			GA_NUM_GENERATIONS, s->get_n_cities(), GA_INHER_PROB
+		);
+		r.seed(seed);
+		r.set_observer(&obs);
+		r.set_metrics(&stats);
+		return r.execute_algorithm(s, eval);
+	}
+	if (algorithm == "brkga") {
+		brkga<default_random_engine, solver> br
+		(
+			GA_POPULATION_SIZE, GA_MUTANT_POPULATION_SIZE, GA_ELITE_SET_SIZE,
+			GA_NUM_GENERATIONS, s->get_n_cities(), GA_INHER_PROB
+		);
+		br.seed(seed);
+		br.set_observer(&obs);
+		br.set_metrics(&stats);
+		return br.execute_algorithm(s, eval);
+	}
+	return false;
+}
+
+int main(int argc, char *argv[]) {
+	/* ******************************** */
+	// ------- PARSE PARAMATERS ------- //
+	/* ******************************** */
+	
+	string inputs_dir = "../inputs";
+	vector<string> algs;
+	size_t reps = 5;
+	uint64_t base_seed = 1;
+	double target_gap = 0.01;
+	string format = "csv";
+	string output_filename;
+	
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "-h") == 0 or strcmp(argv[i], "--help") == 0) {
+			print_usage();
+			return 0;
+		}
+		else if (strcmp(argv[i], "--inputs") == 0) {
+			inputs_dir = string(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "-a") == 0 or strcmp(argv[i], "--algorithm") == 0) {
+			algs.push_back(string(argv[i + 1]));
+			++i;
+		}
+		else if (strcmp(argv[i], "--reps") == 0) {
+			reps = atoi(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--seed") == 0) {
+			base_seed = strtoull(argv[i + 1], nullptr, 10);
+			++i;
+		}
+		else if (strcmp(argv[i], "--target-gap") == 0) {
+			target_gap = atof(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--format") == 0) {
+			format = string(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "-o") == 0 or strcmp(argv[i], "--output") == 0) {
+			output_filename = string(argv[i + 1]);
+			++i;
+		}
+	}
+	
+	if (algs.empty()) {
+		algs = {"local-search", "grasp", "rkga", "brkga"};
+	}
+	for (const string& a : algs) {
+		if (a != "local-search" and a != "grasp" and a != "rkga" and a != "brkga") {
+			cerr << "Error: Wrong value '" << a << "' for algorithm parameter" << endl;
+			return 1;
+		}
+	}
+	if (format != "csv" and format != "json") {
+		cerr << "Error: Wrong value '" << format << "' for format parameter" << endl;
+		return 1;
+	}
+	if (not filesystem::is_directory(inputs_dir)) {
+		cerr << "Error: Directory " << inputs_dir << " does not exist" << endl;
+		return 1;
+	}
+	
+	ofstream fout;
+	if (not output_filename.empty()) {
+		fout.open(output_filename.c_str());
+		if (not fout.is_open()) {
+			cerr << "Error: Could not open output file " << output_filename << endl;
+			return 1;
+		}
+	}
+	ostream& os = (output_filename.empty() ? cout : fout);
+	os.precision(numeric_limits<double>::max_digits10);
+	
+	/* ******************************** */
+	// ------- RUN THE BENCHMARK ------ //
+	/* ******************************** */
+	
+	if (format == "csv") {
+		print_csv_header(os);
+	}
+	
+	for (const string& instance : find_instances(inputs_dir)) {
+		const string dat_file = inputs_dir + "/" + instance + ".dat";
+		const string sol_file = inputs_dir + "/" + instance + "-ILP.sol";
+		
+		double optimum = 0.0;
+		const bool has_optimum = read_optimum(sol_file, optimum);
+		
+		for (const string& algorithm : algs) {
+			for (size_t k = 0; k < reps; ++k) {
+				run_result r;
+				r.instance = instance;
+				r.algorithm = algorithm;
+				r.rep = k;
+				r.seed = base_seed + k;
+				r.has_optimum = has_optimum;
+				r.optimum = optimum;
+				
+				ifstream fin(dat_file.c_str());
+				solver *s = new solver();
+				s->read_from_file(fin);
+				fin.close();
+				
+				const double target =
+					(has_optimum ? optimum*(1.0 + target_gap) : -numeric_limits<double>::max());
+				target_observer obs(target);
+				profiling::metrics stats;
+				
+				double eval = 0.0;
+				try {
+					r.finished = execute(algorithm, r.seed, s, obs, stats, eval);
+				}
+				catch (const infeasible_exception& e) {
+					cerr << "Warning: infeasible solution in " << instance
+						 << " with " << algorithm << " (rep " << k << ")" << endl;
+					r.finished = false;
+				}
+				
+				r.cost = -eval;
+				r.reached_target = obs.reached;
+				r.time_to_target = obs.time_to_target;
+				r.wall_time = stats.get_wall_time();
+				r.decodes = stats.get_counter(profiling::metrics::counter::decodes);
+				r.decodes_per_second = stats.get_decodes_per_second();
+				r.neighbours_explored =
+					stats.get_counter(profiling::metrics::counter::neighbours_explored);
+				
+				if (format == "csv") {
+					print_csv(r, os);
+				}
+				else {
+					print_json(r, os);
+				}
+				
+				delete s;
+			}
+		}
+	}
+}
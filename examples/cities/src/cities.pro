@@ -28,6 +28,7 @@ CONFIG(release, debug|release) {
 	LIBS += -L$${MH_DIR}/mh-release/ -lmetaheuristics
 	PRE_TARGETDEPS += $${MH_DIR}/mh-release/libmetaheuristics.a
 }
+LIBS += -lpthread
 INCLUDEPATH += $${MH_DIR}/
 DEPENDPATH += $${MH_DIR}/
 
@@ -37,6 +38,7 @@ SOURCES += \
 	interface.cpp \
 	impl/interface_constraints.cpp \
 	impl/interface_inout.cpp \
+	impl/interface_binary.cpp \
 	impl/interface_memory.cpp \
 	solver.cpp \
 	impl/solver_decode.cpp \
@@ -44,12 +46,17 @@ SOURCES += \
 	impl/solver_greedy_costs.cpp \
 	impl/solver_neighbourhood.cpp \
 	impl/solver_random_construct.cpp \
+	instance.cpp \
 	main.cpp \
+	parameters.cpp \
 	point.cpp
 
 HEADERS += \
 	centre_type.hpp \
 	city.hpp \
+	instance.hpp \
+	instance_binary.hpp \
 	interface.hpp \
+	parameters.hpp \
 	point.hpp \
 	solver.hpp
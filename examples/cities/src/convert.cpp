@@ -0,0 +1,69 @@
+/// C includes
+#include <string.h>
+
+/// C++ includes
+#include <iostream>
+#include <fstream>
+using namespace std;
+
+/// Custom includes
+#include "solver.hpp"
+
+void print_usage() {
+	cout << "Locations, Cities, and Centres - instance converter" << endl;
+	cout << "Converts an instance in the text format of the files in the inputs" << endl;
+	cout << "directory into the binary format (see instance_binary.hpp), which" << endl;
+	cout << "the solver reads by mapping the file into memory." << endl;
+	cout << "Usage:" << endl;
+	cout << "    [-h, --help]:           shows this help" << endl;
+	cout << "    * [-i, --input] f:      the instance in text format" << endl;
+	cout << "    * [-o, --output] f:     the file where the binary instance is written" << endl;
+	cout << endl;
+	cout << "Parameters marked with '*' are mandatory" << endl;
+	cout << endl;
+}
+
+int main(int argc, char *argv[]) {
+	string input_filename, output_filename;
+
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "-h") == 0 or strcmp(argv[i], "--help") == 0) {
+			print_usage();
+			return 0;
+		}
+		else if (strcmp(argv[i], "-i") == 0 or strcmp(argv[i], "--input") == 0) {
+			input_filename = string(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "-o") == 0 or strcmp(argv[i], "--output") == 0) {
+			output_filename = string(argv[i + 1]);
+			++i;
+		}
+	}
+
+	if (input_filename.empty() or output_filename.empty()) {
+		cerr << "Error: Missing input or output file" << endl;
+		print_usage();
+		return 1;
+	}
+
+	ifstream fin(input_filename.c_str());
+	if (not fin.is_open()) {
+		cerr << "Error: File " << input_filename << " does not exist" << endl;
+		return 1;
+	}
+
+	solver s;
+	s.read_from_file(fin);
+
+	ofstream fout(output_filename.c_str(), ios::binary);
+	if (not fout.is_open()) {
+		cerr << "Error: Could not open output file " << output_filename << endl;
+		return 1;
+	}
+	if (not s.write_binary(fout)) {
+		cerr << "Error: Could not write the instance into " << output_filename << endl;
+		return 1;
+	}
+	return 0;
+}
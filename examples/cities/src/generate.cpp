@@ -0,0 +1,116 @@
+/// C includes
+#include <string.h>
+
+/// C++ includes
+#include <iostream>
+#include <fstream>
+using namespace std;
+
+/// Custom includes
+#include "generator.hpp"
+
+void print_usage() {
+	cout << "Locations, Cities, and Centres - instance generator" << endl;
+	cout << "Writes a random instance in the format of the files in the inputs directory." << endl;
+	cout << "Usage:" << endl;
+	cout << "    [-h, --help]:           shows this help" << endl;
+	cout << "    [-o, --output] f:       write the instance into file f. Default: standard output" << endl;
+	cout << "    [--cities] n:           number of cities. Default: 30" << endl;
+	cout << "    [--locations] n:        number of locations. Default: 5/4 of the number of cities" << endl;
+	cout << "    [--centres] n:          number of centre types. Default: 13" << endl;
+	cout << "    [--city-dist] d:        spatial distribution of the cities. Default: uniform" << endl;
+	cout << "    [--location-dist] d:    spatial distribution of the locations. Default: uniform" << endl;
+	cout << "        Possible values:" << endl;
+	cout << "        - uniform:          uniformly at random" << endl;
+	cout << "        - clustered:        around cluster centres placed uniformly at random" << endl;
+	cout << "        - gaussian:         normally distributed around the centre of the area" << endl;
+	cout << "    [--clusters] n:         number of clusters. Default: one every 50 cities" << endl;
+	cout << "    [--spacing] s:          average distance between neighbouring cities. Default: 5" << endl;
+	cout << "    [--D] d:                minimum distance between centres, relative to the spacing. Default: 0.4" << endl;
+	cout << "    [--min-pop] p:          minimum population of a city. Default: 30" << endl;
+	cout << "    [--max-pop] p:          maximum population of a city. Default: 300" << endl;
+	cout << "    [--seed] s:             seed of the random number generator. Default: 1" << endl;
+	cout << endl;
+}
+
+int main(int argc, char *argv[]) {
+	generator_params params;
+	string output_filename;
+
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "-h") == 0 or strcmp(argv[i], "--help") == 0) {
+			print_usage();
+			return 0;
+		}
+		else if (strcmp(argv[i], "-o") == 0 or strcmp(argv[i], "--output") == 0) {
+			output_filename = string(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--cities") == 0) {
+			params.N_CITIES = atoi(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--locations") == 0) {
+			params.N_LOCATIONS = atoi(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--centres") == 0) {
+			params.N_CENTRES = atoi(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--city-dist") == 0 or strcmp(argv[i], "--location-dist") == 0) {
+			spatial_distribution& d =
+				(strcmp(argv[i], "--city-dist") == 0 ? params.CITY_DIST : params.LOCATION_DIST);
+			if (not parse_distribution(string(argv[i + 1]), d)) {
+				cerr << "Error: Unknown spatial distribution '" << argv[i + 1] << "'" << endl;
+				return 1;
+			}
+			++i;
+		}
+		else if (strcmp(argv[i], "--clusters") == 0) {
+			params.N_CLUSTERS = atoi(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--spacing") == 0) {
+			params.SPACING = atof(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--D") == 0) {
+			params.D = atof(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--min-pop") == 0) {
+			params.MIN_POPULATION = atoi(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--max-pop") == 0) {
+			params.MAX_POPULATION = atoi(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--seed") == 0) {
+			params.SEED = strtoull(argv[i + 1], nullptr, 10);
+			++i;
+		}
+	}
+
+	if (params.N_CITIES == 0 or params.N_CENTRES == 0) {
+		cerr << "Error: The number of cities and of centre types must be positive" << endl;
+		return 1;
+	}
+	if (params.MIN_POPULATION > params.MAX_POPULATION) {
+		cerr << "Error: The minimum population is larger than the maximum" << endl;
+		return 1;
+	}
+
+	if (output_filename.empty()) {
+		generate_instance(params, cout);
+		return 0;
+	}
+
+	ofstream fout(output_filename.c_str());
+	if (not fout.is_open()) {
+		cerr << "Error: Could not open output file " << output_filename << endl;
+		return 1;
+	}
+	generate_instance(params, fout);
+}
@@ -0,0 +1,136 @@
+#include "generator.hpp"
+
+// C++ includes
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <cmath>
+
+bool parse_distribution(const string& s, spatial_distribution& d) {
+	if (s == "uniform") {
+		d = spatial_distribution::uniform;
+	}
+	else if (s == "clustered") {
+		d = spatial_distribution::clustered;
+	}
+	else if (s == "gaussian") {
+		d = spatial_distribution::gaussian;
+	}
+	else {
+		return false;
+	}
+	return true;
+}
+
+// Places 'n' points in the square [0,L]x[0,L] following distribution 'd'.
+// Points that fall outside the square are clamped to its border.
+static void make_points
+(
+	size_t n, double L, spatial_distribution d, size_t n_clusters,
+	mt19937_64& gen, vector<double>& xs, vector<double>& ys
+)
+{
+	xs.resize(n);
+	ys.resize(n);
+
+	uniform_real_distribution<double> U(0.0, L);
+
+	if (d == spatial_distribution::uniform) {
+		for (size_t i = 0; i < n; ++i) {
+			xs[i] = U(gen);
+			ys[i] = U(gen);
+		}
+		return;
+	}
+
+	vector<double> cx, cy;
+	double sigma;
+	if (d == spatial_distribution::gaussian) {
+		cx.push_back(L/2.0);
+		cy.push_back(L/2.0);
+		sigma = L/6.0;
+	}
+	else {
+		for (size_t c = 0; c < n_clusters; ++c) {
+			cx.push_back(U(gen));
+			cy.push_back(U(gen));
+		}
+		sigma = L/(4.0*sqrt(double(n_clusters)));
+	}
+
+	uniform_int_distribution<size_t> C(0, cx.size() - 1);
+	normal_distribution<double> N(0.0, sigma);
+	for (size_t i = 0; i < n; ++i) {
+		const size_t c = C(gen);
+		xs[i] = min(L, max(0.0, cx[c] + N(gen)));
+		ys[i] = min(L, max(0.0, cy[c] + N(gen)));
+	}
+}
+
+template<class T>
+static void write_values(ostream& os, const string& field, const vector<T>& v) {
+	os << field << "[";
+	for (size_t i = 0; i < v.size(); ++i) {
+		os << (i > 0 ? " " : "") << v[i];
+	}
+	os << "];" << endl;
+}
+
+void generate_instance(const generator_params& params, ostream& os) {
+	mt19937_64 gen(params.SEED);
+
+	const size_t n_cities = params.N_CITIES;
+	const size_t n_locations =
+		(params.N_LOCATIONS > 0 ? params.N_LOCATIONS : n_cities + n_cities/4);
+	const size_t n_clusters =
+		(params.N_CLUSTERS > 0 ? params.N_CLUSTERS : max<size_t>(1, n_cities/50));
+
+	const double L = params.SPACING*sqrt(double(n_cities));
+
+	// cities
+	vector<double> city_x, city_y;
+	make_points(n_cities, L, params.CITY_DIST, n_clusters, gen, city_x, city_y);
+
+	vector<int> city_pop(n_cities);
+	uniform_int_distribution<int> P(params.MIN_POPULATION, params.MAX_POPULATION);
+	for (size_t i = 0; i < n_cities; ++i) {
+		city_pop[i] = P(gen);
+	}
+
+	// locations
+	vector<double> loc_x, loc_y;
+	make_points(n_locations, L, params.LOCATION_DIST, n_clusters, gen, loc_x, loc_y);
+
+	// centre types: a centre serves a few cities within a few spacings
+	const double avg_pop = (params.MIN_POPULATION + params.MAX_POPULATION)/2.0;
+	uniform_real_distribution<double> WD(6.0*params.SPACING, 10.5*params.SPACING);
+	uniform_real_distribution<double> CAP(2.3*avg_pop, 2.7*avg_pop);
+	uniform_real_distribution<double> IC(100.0, 1000.0);
+
+	vector<double> work_dist(params.N_CENTRES), instal_cost(params.N_CENTRES);
+	vector<int> centre_cap(params.N_CENTRES);
+	for (size_t i = 0; i < params.N_CENTRES; ++i) {
+		work_dist[i] = WD(gen);
+		centre_cap[i] = int(CAP(gen));
+		instal_cost[i] = IC(gen);
+	}
+
+	// write instance
+	os << fixed << setprecision(3);
+
+	os << "D\t\t\t= " << params.D*params.SPACING << ";" << endl;
+	os << endl;
+	os << "nLocations\t= " << n_locations << ";" << endl;
+	write_values(os, "loc_x\t\t= ", loc_x);
+	write_values(os, "loc_y\t\t= ", loc_y);
+	os << endl;
+	os << "nCities\t\t= " << n_cities << ";" << endl;
+	write_values(os, "city_x\t\t= ", city_x);
+	write_values(os, "city_y\t\t= ", city_y);
+	write_values(os, "city_pop\t= ", city_pop);
+	os << endl;
+	os << "nCentres\t= " << params.N_CENTRES << ";" << endl;
+	write_values(os, "work_dist\t= ", work_dist);
+	write_values(os, "centre_cap\t= ", centre_cap);
+	write_values(os, "instal_cost\t= ", instal_cost);
+}
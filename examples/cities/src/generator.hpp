@@ -0,0 +1,71 @@
+#pragma once
+
+// C++ includes
+#include <iostream>
+#include <cstdint>
+#include <string>
+using namespace std;
+
+// Spatial distribution of the cities or of the locations.
+enum class spatial_distribution {
+	// uniformly at random within the area
+	uniform,
+	// around a number of cluster centres placed uniformly at random
+	clustered,
+	// normally distributed around the centre of the area
+	gaussian
+};
+
+// Parses a spatial distribution. Returns false if 's' is not the
+// name of any distribution.
+bool parse_distribution(const string& s, spatial_distribution& d);
+
+// Parameters of a randomly generated instance.
+//
+// The cities are placed within a square whose side grows with the
+// square root of the number of cities, so that the density of cities
+// (and the number of cities within the working distance of a centre)
+// does not depend on the size of the instance. The default values
+// produce instances similar to the 'big' instances.
+class generator_params {
+	public:
+		size_t N_CITIES;
+		// 0 means 5/4 of the number of cities
+		size_t N_LOCATIONS;
+		size_t N_CENTRES;
+
+		spatial_distribution CITY_DIST;
+		spatial_distribution LOCATION_DIST;
+		// 0 means one cluster every 50 cities
+		size_t N_CLUSTERS;
+
+		// average distance between neighbouring cities
+		double SPACING;
+		// minimum distance between locations with a centre, relative
+		// to the spacing
+		double D;
+
+		int MIN_POPULATION;
+		int MAX_POPULATION;
+
+		uint64_t SEED;
+
+		generator_params() {
+			N_CITIES = 30;
+			N_LOCATIONS = 0;
+			N_CENTRES = 13;
+			CITY_DIST = spatial_distribution::uniform;
+			LOCATION_DIST = spatial_distribution::uniform;
+			N_CLUSTERS = 0;
+			SPACING = 5.0;
+			D = 0.4;
+			MIN_POPULATION = 30;
+			MAX_POPULATION = 300;
+			SEED = 1;
+		}
+		~generator_params() { }
+};
+
+// Writes into 'os' an instance generated with parameters 'params'
+// in the format read by interface::read_from_file.
+void generate_instance(const generator_params& params, ostream& os);
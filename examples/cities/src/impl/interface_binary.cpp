@@ -0,0 +1,202 @@
+#include "interface.hpp"
+
+// C includes
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// C++ includes
+#include <cstring>
+
+// Custom includes
+#include "instance_binary.hpp"
+
+// auxiliary functions
+
+inline
+size_t __align(size_t offset) {
+	return (offset + BINARY_ALIGNMENT - 1)/BINARY_ALIGNMENT*BINARY_ALIGNMENT;
+}
+
+inline
+void __write_padding(ostream& os, size_t& offset) {
+	static const char zeros[BINARY_ALIGNMENT] = {0};
+	const size_t aligned = __align(offset);
+	os.write(zeros, aligned - offset);
+	offset = aligned;
+}
+
+// Places an array of 'n' values of 'size' bytes at the first aligned
+// offset from 'offset', and moves 'offset' past its end. Returns the
+// offset of the array, or 0 and sets 'valid' to false if it does not
+// fit in a size_t.
+inline
+size_t __place_array(size_t& offset, uint64_t n, size_t size, bool& valid) {
+	if (not valid or offset > SIZE_MAX - (BINARY_ALIGNMENT - 1)) {
+		valid = false;
+		return 0;
+	}
+	const size_t start = __align(offset);
+	if (n > (SIZE_MAX - start)/size) {
+		valid = false;
+		return 0;
+	}
+	offset = start + n*size;
+	return start;
+}
+
+template<typename T>
+inline
+void __write_array(ostream& os, size_t& offset, const vector<T>& values) {
+	__write_padding(os, offset);
+	os.write(reinterpret_cast<const char *>(values.data()), values.size()*sizeof(T));
+	offset += values.size()*sizeof(T);
+}
+
+// BINARY LAYOUT
+
+binary_layout::binary_layout(uint64_t NL, uint64_t NC, uint64_t NT) {
+	// the sizes are stored in ints once the instance is read
+	valid = NL <= INT_MAX and NC <= INT_MAX and NT <= INT_MAX;
+	size_t offset = sizeof(binary_header);
+	
+	loc_x = __place_array(offset, NL, sizeof(double), valid);
+	loc_y = __place_array(offset, NL, sizeof(double), valid);
+	city_x = __place_array(offset, NC, sizeof(double), valid);
+	city_y = __place_array(offset, NC, sizeof(double), valid);
+	city_pop = __place_array(offset, NC, sizeof(int32_t), valid);
+	work_dist = __place_array(offset, NT, sizeof(double), valid);
+	centre_cap = __place_array(offset, NT, sizeof(double), valid);
+	instal_cost = __place_array(offset, NT, sizeof(double), valid);
+	
+	file_size = (valid ? offset : 0);
+}
+
+// PUBLIC
+
+bool interface::read_from_binary_file(const string& filename) {
+	int fd = open(filename.c_str(), O_RDONLY);
+	if (fd == -1) {
+		cerr << "Error (interface::read_from_binary_file): cannot open file " << filename << endl;
+		return false;
+	}
+	
+	struct stat st;
+	if (fstat(fd, &st) == -1 or size_t(st.st_size) < sizeof(binary_header)) {
+		cerr << "Error (interface::read_from_binary_file): file " << filename << " is too small" << endl;
+		close(fd);
+		return false;
+	}
+	
+	const size_t size = size_t(st.st_size);
+	void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (addr == MAP_FAILED) {
+		cerr << "Error (interface::read_from_binary_file): cannot map file " << filename << endl;
+		return false;
+	}
+	
+	const char *data = static_cast<const char *>(addr);
+	binary_header h;
+	memcpy(&h, data, sizeof(binary_header));
+	
+	bool valid =
+		memcmp(h.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0 and
+		h.version == BINARY_VERSION and h.byte_order == BINARY_BYTE_ORDER;
+	if (not valid) {
+		cerr << "Error (interface::read_from_binary_file): file " << filename
+			 << " is not an instance in binary format" << endl;
+	}
+	
+	if (valid) {
+		const binary_layout L(h.n_locations, h.n_cities, h.n_centres);
+		if (not L.valid) {
+			cerr << "Error (interface::read_from_binary_file): the sizes of the instance in file "
+				 << filename << " are too large" << endl;
+			valid = false;
+		}
+		else if (L.file_size > size) {
+			cerr << "Error (interface::read_from_binary_file): file " << filename << " is truncated" << endl;
+			valid = false;
+		}
+		else {
+			// the arrays are aligned within the mapping, so they are
+			// read in place
+			set_input_data
+			(
+				h.D,
+				int(h.n_locations),
+				reinterpret_cast<const double *>(data + L.loc_x),
+				reinterpret_cast<const double *>(data + L.loc_y),
+				int(h.n_cities),
+				reinterpret_cast<const double *>(data + L.city_x),
+				reinterpret_cast<const double *>(data + L.city_y),
+				reinterpret_cast<const int32_t *>(data + L.city_pop),
+				int(h.n_centres),
+				reinterpret_cast<const double *>(data + L.work_dist),
+				reinterpret_cast<const double *>(data + L.centre_cap),
+				reinterpret_cast<const double *>(data + L.instal_cost)
+			);
+		}
+	}
+	
+	munmap(addr, size);
+	return valid;
+}
+
+bool interface::write_binary(ostream& os) const {
+	binary_header h;
+	memset(&h, 0, sizeof(binary_header));
+	memcpy(h.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+	h.version = BINARY_VERSION;
+	h.byte_order = BINARY_BYTE_ORDER;
+	h.D = D;
+	h.n_locations = uint64_t(n_locations);
+	h.n_cities = uint64_t(n_cities);
+	h.n_centres = uint64_t(n_centres);
+	
+	// gather the fields of the instance into arrays
+	vector<double> loc_x(n_locations), loc_y(n_locations);
+	for (int i = 0; i < n_locations; ++i) {
+		loc_x[i] = inst->locations[i].get_x();
+		loc_y[i] = inst->locations[i].get_y();
+	}
+	
+	vector<double> city_x(n_cities), city_y(n_cities);
+	vector<int32_t> city_pop(n_cities);
+	for (int i = 0; i < n_cities; ++i) {
+		city_x[i] = inst->cities[i].get_position().get_x();
+		city_y[i] = inst->cities[i].get_position().get_y();
+		city_pop[i] = inst->cities[i].get_population();
+	}
+	
+	vector<double> work_dist(n_centres), centre_cap(n_centres), instal_cost(n_centres);
+	for (int i = 0; i < n_centres; ++i) {
+		work_dist[i] = inst->centres[i].get_working_distance();
+		centre_cap[i] = inst->centres[i].get_capacity();
+		instal_cost[i] = inst->centres[i].get_installation_cost();
+	}
+	
+	os.write(reinterpret_cast<const char *>(&h), sizeof(binary_header));
+	size_t offset = sizeof(binary_header);
+	__write_array(os, offset, loc_x);
+	__write_array(os, offset, loc_y);
+	__write_array(os, offset, city_x);
+	__write_array(os, offset, city_y);
+	__write_array(os, offset, city_pop);
+	__write_array(os, offset, work_dist);
+	__write_array(os, offset, centre_cap);
+	__write_array(os, offset, instal_cost);
+	
+	return os.good();
+}
+
+bool interface::is_binary_file(const string& filename) {
+	ifstream fin(filename.c_str(), ios::binary);
+	char magic[sizeof(BINARY_MAGIC)];
+	if (not fin.read(magic, sizeof(magic))) {
+		return false;
+	}
+	return memcmp(magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0;
+}
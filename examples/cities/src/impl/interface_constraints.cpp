@@ -5,150 +5,142 @@
 /* Constraint checking */
 
 bool interface::separated_by_D(int loc_idx) const {
-	const point& FOCUS = locations[loc_idx];
-	bool separated = true;
+	const int begin = inst->close_begin[loc_idx];
+	const int end = inst->close_begin[loc_idx + 1];
 	
-	// check for every location ...
-	int l = 0;
-	while (l < n_locations and separated) {
+	// check for every location closer than D to 'loc_idx' ...
+	for (int i = begin; i < end; ++i) {
 		
-		// ... that is not 'loc_idx' and has a centre installed ...
-		if (l != loc_idx and location_centre_type[l] != -1) {
-			
-			// ... that is not at least at a distance of D to 'loc_idx' ...
-			if (locations[l].distance(FOCUS) < D) {
-				
-				// ... then 'loc_idx' is not separated enough from the other
-				// locations with a centre installed
-				separated = false;
-			}
+		// ... that it does not have a centre installed
+		if (location_centre_type[ inst->close_locations[i] ] != -1) {
+			return false;
 		}
-		++l;
 	}
 	
-	return separated;
+	return true;
 }
 
-bool interface::separated_by_D(int loc_idx, const set<int>& locs) const {
-	const point& FOCUS = locations[loc_idx];
-	bool separated = true;
-	
-	// check for every location in 'locs' ...
-	set<int>::const_iterator cit = locs.begin();
-	while (cit != locs.end() and separated) {
-		
-		// ... that is not at least at a distance of D to 'loc_idx' ...
-		if (*cit != loc_idx and locations[*cit].distance(FOCUS) < D) {
-			
-			// ... then 'loc_idx' is not separated enough from the other
-			// locations with a centre installed
-			separated = false;
-		}
-		++cit;
+void interface::block_close_locations(int loc_idx, vector<char>& blocked) const {
+	const int begin = inst->close_begin[loc_idx];
+	const int end = inst->close_begin[loc_idx + 1];
+	for (int i = begin; i < end; ++i) {
+		blocked[ inst->close_locations[i] ] = 1;
 	}
-	
-	return separated;
 }
 
 bool interface::working_distance_exceeded(int loc_idx, int centre_idx) const {
-	const double wd = centres[centre_idx].get_working_distance();
-	const point& loc_pos = locations[loc_idx];
+	const double wd = inst->centres[centre_idx].get_working_distance();
+	const vector<int>& served = loc_cities[loc_idx];
 	
 	bool distance_execeeded = false;
 	
-	int city_idx = 0;
-	while (city_idx < n_cities and not distance_execeeded) {
-		if (cit_by_prim[city_idx] == loc_idx or cit_by_sec[city_idx] == loc_idx) {
-			
-			const point& city_pos = cities[city_idx].get_position();
-			double df;
-			
-			if (cit_by_prim[city_idx] == loc_idx) {
-				df = 1.0;
-			}
-			else if (cit_by_sec[city_idx] == loc_idx) {
-				df = 3.0;
-			}
-			else {
-				cerr << "Error (interface::working_distance_exceeded): city " << city_idx << " not served by a location" << endl;
-				df = -1.0;
-			}
-			
-			double dist = city_pos.distance(loc_pos);
-			if (dist > df*wd) {
-				distance_execeeded = true;
-			}
+	size_t i = 0;
+	while (i < served.size() and not distance_execeeded) {
+		int city_idx = served[i];
+		
+		assert(cit_by_prim[city_idx] == loc_idx or cit_by_sec[city_idx] == loc_idx);
+		double df = (cit_by_prim[city_idx] == loc_idx ? 1.0 : 3.0);
+		double dist = dist_city_loc(city_idx, loc_idx);
+		if (dist > df*wd) {
+			distance_execeeded = true;
 		}
 		
-		++city_idx;
+		++i;
 	}
 	
 	return distance_execeeded;
 }
 
 bool interface::capacity_exceeded(int loc_idx, int centre_idx) const {
+	const vector<int>& served = loc_cities[loc_idx];
+	
 	bool cap_exceeded = false;
 	
-	double max_cap = centres[centre_idx].get_capacity();
+	double max_cap = inst->centres[centre_idx].get_capacity();
 	double loc_cap = 0.0;
 	
-	int city_idx = 0;
-	while (city_idx < n_cities and not cap_exceeded) {
+	size_t i = 0;
+	while (i < served.size() and not cap_exceeded) {
+		int city_idx = served[i];
+		
 		if (cit_by_prim[city_idx] == loc_idx) {
-			loc_cap += cities[city_idx].get_population();
+			loc_cap += inst->cities[city_idx].get_population();
 		}
-		else if (cit_by_sec[city_idx] == loc_idx) {
-			loc_cap += 0.10*cities[city_idx].get_population();
+		else {
+			assert(cit_by_sec[city_idx] == loc_idx);
+			loc_cap += 0.10*inst->cities[city_idx].get_population();
 		}
 		
 		if (loc_cap > max_cap) {
 			cap_exceeded = true;
 		}
 		
-		++city_idx;
+		++i;
 	}
 	
 	return cap_exceeded;
 }
 
 bool interface::joined_constraints_satisfied(int loc_idx, int centre_idx) const {
-	const double max_cap = centres[centre_idx].get_capacity();
-	const double wd = centres[centre_idx].get_working_distance();
-	const point& loc_pos = locations[loc_idx];
+	const double max_cap = inst->centres[centre_idx].get_capacity();
+	const double wd = inst->centres[centre_idx].get_working_distance();
+	const vector<int>& served = loc_cities[loc_idx];
 	
 	double loc_cap = 0.0;
 	bool constraints_satisfied = true;
 	
-	int city_idx = 0;
-	while (city_idx < n_cities and constraints_satisfied) {
+	size_t i = 0;
+	while (i < served.size() and constraints_satisfied) {
+		int city_idx = served[i];
+		
+		double df;
+		if (cit_by_prim[city_idx] == loc_idx) {
+			loc_cap += inst->cities[city_idx].get_population();
+			df = 1.0;
+		}
+		else {
+			assert(cit_by_sec[city_idx] == loc_idx);
+			loc_cap += 0.10*inst->cities[city_idx].get_population();
+			df = 3.0;
+		}
 		
-		if (cit_by_prim[city_idx] == loc_idx or cit_by_sec[city_idx] == loc_idx) {
-			
-			const point& city_pos = cities[city_idx].get_position();
-			double df;
-			
-			if (cit_by_prim[city_idx] == loc_idx) {
-				loc_cap += cities[city_idx].get_population();
-				df = 1.0;
-			}
-			else if (cit_by_sec[city_idx] == loc_idx) {
-				loc_cap += 0.10*cities[city_idx].get_population();
-				df = 3.0;
-			}
-			else {
-				cerr << "Error (interface::joined_constraints_satisfied): city " << city_idx << " not served by a location" << endl;
-				df = -1.0;
-			}
-			
-			double dist = city_pos.distance(loc_pos);
-			if (dist > df*wd or loc_cap > max_cap) {
-				constraints_satisfied = false;
-			}
+		double dist = dist_city_loc(city_idx, loc_idx);
+		if (dist > df*wd or loc_cap > max_cap) {
+			constraints_satisfied = false;
 		}
 		
-		++city_idx;
+		++i;
 	}
 	
 	return constraints_satisfied;
 }
 
+int interface::cheapest_centre(int loc_idx) const {
+	// capacity used at the location (added up as in
+	// joined_constraints_satisfied) and the largest distance to the
+	// cities it serves, for each role
+	double loc_cap = 0.0;
+	double max_prim_dist = 0.0;
+	double max_sec_dist = 0.0;
+	
+	for (int city_idx : loc_cities[loc_idx]) {
+		if (cit_by_prim[city_idx] == loc_idx) {
+			loc_cap += inst->cities[city_idx].get_population();
+			max_prim_dist = max(max_prim_dist, dist_city_loc(city_idx, loc_idx));
+		}
+		else {
+			assert(cit_by_sec[city_idx] == loc_idx);
+			loc_cap += 0.10*inst->cities[city_idx].get_population();
+			max_sec_dist = max(max_sec_dist, dist_city_loc(city_idx, loc_idx));
+		}
+	}
+	
+	const size_t NF = inst->centre_frontier.size();
+	for (size_t f = 0; f < NF; ++f) {
+		const double wd = inst->frontier_working_distance[f];
+		if (loc_cap <= inst->frontier_capacity[f] and max_prim_dist <= wd and max_sec_dist <= 3.0*wd) {
+			return inst->centre_frontier[f];
+		}
+	}
+	return -1;
+}
@@ -1,5 +1,8 @@
 #include "interface.hpp"
 
+// metaheuristics includes
+#include <metaheuristics/misc/checkpoint.hpp>
+
 // auxiliary functions
 
 inline
@@ -42,8 +45,7 @@ void interface::read_from_file(istream& in) {
 	vector<double> city_x, city_y;
 	vector<int> city_pop;
 	
-	vector<double> centres_wd, centres_ic;
-	vector<int> centres_cc;
+	vector<double> centres_wd, centres_cc, centres_ic;
 
 /*
 /// 1
@@ -117,86 +119,43 @@ instal_cost	= [1 2 3 4];	// 4.4
 	__read_line_values(in, centres_ic);	// 4.4
 	
 	// -- Finish reading file
-	// move data from raw vectors into this object
-	locations.resize(n_locations);
-	for (int i = 0; i < n_locations; ++i) {
-		locations[i].set(locations_x[i], locations_y[i]);
-	}
-	
-	cities.resize(n_cities);
-	for (int i = 0; i < n_cities; ++i) {
-		cities[i].get_position().set(city_x[i], city_y[i]);
-		cities[i].set_population(city_pop[i]);
-	}
-	
-	centres.resize(n_centres);
-	for (int i = 0; i < n_centres; ++i) {
-		centres[i].set_working_distance(centres_wd[i]);
-		centres[i].set_capacity(centres_cc[i]);
-		centres[i].set_installation_cost(centres_ic[i]);
-	}
-	
-	location_centre_type = vector<int>(n_locations, -1);
-	cap_location = vector<double>(n_locations, 0.0);
-	cit_by_prim = vector<int>(n_cities, -1);
-	cit_by_sec = vector<int>(n_cities, -1);
-	
-	/// postprocess data
-	
-	// sort cities by population, store the ordering in sorted_cities
-	sorted_cities.resize(n_cities);
-	vector<pair<int, int> > cities_pop(n_cities);
-	for (int c = 0; c < n_cities; ++c) {
-		cities_pop[c].first = cities[c].get_population();
-		cities_pop[c].second = c;
-	}
-	sort(cities_pop.begin(), cities_pop.end());
-	for (int c = 0; c < n_cities; ++c) {
-		sorted_cities[c] = cities_pop[c].second;
-	}
-	
-	// sort centre types by installation cost, store the ordering in
-	// sorted_centres
-	sorted_centres.resize(n_centres);
-	vector<pair<double, int> > centres_price(n_centres);
-	for (int c = 0; c < n_centres; ++c) {
-		centres_price[c].first = centres[c].get_installation_cost();
-		centres_price[c].second = c;
-	}
-	sort(centres_price.begin(), centres_price.end());
-	for (int c = 0; c < n_centres; ++c) {
-		sorted_centres[c] = centres_price[c].second;
-	}
+	set_input_data
+	(
+		D,
+		n_locations, locations_x.data(), locations_y.data(),
+		n_cities, city_x.data(), city_y.data(), city_pop.data(),
+		n_centres, centres_wd.data(), centres_cc.data(), centres_ic.data()
+	);
 }
 
 void interface::print_input_data(ostream& os) {
 	os << "D= " << D << endl;
 	os << endl;
 	
-	os << "Locations: " << locations.size() << endl;
-	for (size_t i = 0; i < locations.size(); ++i) {
+	os << "Locations: " << inst->locations.size() << endl;
+	for (size_t i = 0; i < inst->locations.size(); ++i) {
 		os << "    Location " << i << ":" << endl;
-		os << "        Position: (" << locations[i].get_x() << ", "
-		   << locations[i].get_y() << ")" << endl;
+		os << "        Position: (" << inst->locations[i].get_x() << ", "
+		   << inst->locations[i].get_y() << ")" << endl;
 	}
 	os << endl;
 	
-	os << "Cities: " << cities.size() << endl;
-	for (size_t i = 0; i < cities.size(); ++i) {
+	os << "Cities: " << inst->cities.size() << endl;
+	for (size_t i = 0; i < inst->cities.size(); ++i) {
 		os << "    City " << i << ":" << endl;
-		os << "        Position: (" << cities[i].get_position().get_x() << ", "
-		   << cities[i].get_position().get_y() << ")" << endl;
+		os << "        Position: (" << inst->cities[i].get_position().get_x() << ", "
+		   << inst->cities[i].get_position().get_y() << ")" << endl;
 		   
-		os << "        Population: " << cities[i].get_population() << endl;
+		os << "        Population: " << inst->cities[i].get_population() << endl;
 		os << endl;
 	}
 	
-	os << "Centre types: " << centres.size() << endl;
-	for (size_t i = 0; i < centres.size(); ++i) {
+	os << "Centre types: " << inst->centres.size() << endl;
+	for (size_t i = 0; i < inst->centres.size(); ++i) {
 		os << "    Type " << i << ":" << endl;
-		os << "        Working distance: " << centres[i].get_working_distance() << endl;
-		os << "        Centre capacity: " << centres[i].get_capacity() << endl;
-		os << "        Installation cost: " << centres[i].get_installation_cost() << endl;
+		os << "        Working distance: " << inst->centres[i].get_working_distance() << endl;
+		os << "        Centre capacity: " << inst->centres[i].get_capacity() << endl;
+		os << "        Installation cost: " << inst->centres[i].get_installation_cost() << endl;
 		os << endl;
 	}
 }
@@ -220,24 +179,24 @@ void interface::print(ostream& os, const string& tab) const {
 	for (int l = 0; l < n_locations; ++l) {
 		if (location_centre_type[l] != -1) {
 			int centre_idx = location_centre_type[l];
-			double instal_cost = centres[ centre_idx ].get_installation_cost();
+			double instal_cost = inst->centres[ centre_idx ].get_installation_cost();
 			
 			os << tab << "    At location " << l << " a centre of type: " << centre_idx << ". "
 			          << "Cost= " << instal_cost << ". "
-			          << "Max capacity= " << centres[centre_idx].get_capacity() << ". "
-			          << "Working distance= " << centres[centre_idx].get_working_distance() << "." << endl;
+			          << "Max capacity= " << inst->centres[centre_idx].get_capacity() << ". "
+			          << "Working distance= " << inst->centres[centre_idx].get_working_distance() << "." << endl;
 			os << tab << "    Location's occupation= " << cap_location[l] << endl;
 			
 			os << tab << "    This location serves:" << endl;
 			os << tab << "    " << "    -> As primary:";
-			for (int c = 0; c < n_cities; ++c) {
+			for (int c : loc_cities[l]) {
 				if (cit_by_prim[c] == l) {
 					os << " " << c;
 				}
 			}
 			os << endl;
 			os << tab << "    " << "    -> As secondary:";
-			for (int c = 0; c < n_cities; ++c) {
+			for (int c : loc_cities[l]) {
 				if (cit_by_sec[c] == l) {
 					os << " " << c;
 				}
@@ -258,17 +217,110 @@ void interface::print(ostream& os, const string& tab) const {
 		os << tab << "    - Primary location: ";
 		if (cit_by_prim[c] != -1) {
 			os << cit_by_prim[c] << ". Distance= "
-			   << cities[c].get_position().distance( locations[cit_by_prim[c]] );
+			   << dist_city_loc(c, cit_by_prim[c]);
 		}
 		os << endl;
 		
 		os << tab << "    - Secondary location: ";
 		if (cit_by_prim[c] != -1) {
 			os << cit_by_sec[c] << ". Distance= "
-			   << cities[c].get_position().distance( locations[cit_by_sec[c]] );
+			   << dist_city_loc(c, cit_by_sec[c]);
 		}
 		os << endl << endl;
 	}
 	os << endl;
 }
 
+bool interface::write_solution(ostream& os) const {
+	checkpointing::write_value(os, n_locations);
+	checkpointing::write_value(os, n_cities);
+	checkpointing::write_values(os, &cap_location[0], n_locations);
+	checkpointing::write_values(os, &location_centre_type[0], n_locations);
+	checkpointing::write_values(os, &cit_by_prim[0], n_cities);
+	checkpointing::write_values(os, &cit_by_sec[0], n_cities);
+	return os.good();
+}
+
+bool interface::read_solution(istream& is) {
+	int nl, nc;
+	if (not checkpointing::read_value(is, nl) or not checkpointing::read_value(is, nc)) {
+		return false;
+	}
+	if (nl != n_locations or nc != n_cities) {
+		return false;
+	}
+	
+	empty_interface();
+	bool read =
+		checkpointing::read_values(is, &cap_location[0], n_locations) and
+		checkpointing::read_values(is, &location_centre_type[0], n_locations) and
+		checkpointing::read_values(is, &cit_by_prim[0], n_cities) and
+		checkpointing::read_values(is, &cit_by_sec[0], n_cities);
+	
+	// the indices are used to access the instance, so a solution
+	// with indices out of range is not accepted
+	for (int l = 0; read and l < n_locations; ++l) {
+		read = -1 <= location_centre_type[l] and location_centre_type[l] < n_centres;
+	}
+	for (int c = 0; read and c < n_cities; ++c) {
+		read =
+			-1 <= cit_by_prim[c] and cit_by_prim[c] < n_locations and
+			-1 <= cit_by_sec[c] and cit_by_sec[c] < n_locations;
+	}
+	if (not read) {
+		empty_interface();
+		return false;
+	}
+	
+	build_loc_cities();
+	update_installed_cost();
+	return true;
+}
+
+// PROTECTED
+
+void interface::set_input_data
+(
+	double d,
+	int NL, const double *loc_x, const double *loc_y,
+	int NC, const double *city_x, const double *city_y, const int *city_pop,
+	int NT, const double *work_dist, const double *centre_cap, const double *instal_cost
+)
+{
+	D = d;
+	n_locations = NL;
+	n_cities = NC;
+	n_centres = NT;
+	
+	// move data from the arrays into a new instance
+	shared_ptr<instance> I = make_shared<instance>();
+	
+	I->locations.resize(n_locations);
+	for (int i = 0; i < n_locations; ++i) {
+		I->locations[i].set(loc_x[i], loc_y[i]);
+	}
+	
+	I->cities.resize(n_cities);
+	for (int i = 0; i < n_cities; ++i) {
+		I->cities[i].get_position().set(city_x[i], city_y[i]);
+		I->cities[i].set_population(city_pop[i]);
+	}
+	
+	I->centres.resize(n_centres);
+	for (int i = 0; i < n_centres; ++i) {
+		I->centres[i].set_working_distance(work_dist[i]);
+		I->centres[i].set_capacity(centre_cap[i]);
+		I->centres[i].set_installation_cost(instal_cost[i]);
+	}
+	
+	/// postprocess data
+	I->postprocess(D);
+	inst = I;
+	
+	location_centre_type = vector<int>(n_locations, -1);
+	cap_location = vector<double>(n_locations, 0.0);
+	cit_by_prim = vector<int>(n_cities, -1);
+	cit_by_sec = vector<int>(n_cities, -1);
+	loc_cities = vector<vector<int> >(n_locations);
+	installed_cost = 0.0;
+}
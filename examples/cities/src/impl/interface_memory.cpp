@@ -14,17 +14,14 @@ void interface::copy_interface(const interface *i) {
 	n_cities = i->n_cities;
 	n_centres = i->n_centres;
 
-	locations = i->locations;
-	cities = i->cities;
-	centres = i->centres;
-
-	sorted_cities = i->sorted_cities;
-	sorted_centres = i->sorted_centres;
+	inst = i->inst;
 
 	location_centre_type = i->location_centre_type;
 	cap_location = i->cap_location;
 	cit_by_prim = i->cit_by_prim;
 	cit_by_sec = i->cit_by_sec;
+	loc_cities = i->loc_cities;
+	installed_cost = i->installed_cost;
 }
 
 void interface::copy_empty(const interface *i) {
@@ -33,22 +30,61 @@ void interface::copy_empty(const interface *i) {
 	n_cities = i->n_cities;
 	n_centres = i->n_centres;
 
-	locations = i->locations;
-	cities = i->cities;
-	centres = i->centres;
-
-	sorted_cities = i->sorted_cities;
-	sorted_centres = i->sorted_centres;
+	inst = i->inst;
 
 	location_centre_type = vector<int>(n_locations, -1);
 	cap_location = vector<double>(n_locations, 0.0);
 	cit_by_prim = vector<int>(n_cities, -1);
 	cit_by_sec = vector<int>(n_cities, -1);
+	loc_cities = vector<vector<int> >(n_locations);
+	installed_cost = 0.0;
 }
 
 void interface::empty_interface() {
-	location_centre_type = vector<int>(n_locations, -1);
-	cap_location = vector<double>(n_locations, 0.0);
-	cit_by_prim = vector<int>(n_cities, -1);
-	cit_by_sec = vector<int>(n_cities, -1);
+	// the vectors keep their memory, so that a solution
+	// recycled by the algorithms does not allocate again
+	location_centre_type.assign(n_locations, -1);
+	cap_location.assign(n_locations, 0.0);
+	cit_by_prim.assign(n_cities, -1);
+	cit_by_sec.assign(n_cities, -1);
+	loc_cities.resize(n_locations);
+	for (vector<int>& served : loc_cities) {
+		served.clear();
+	}
+	installed_cost = 0.0;
+}
+
+void interface::assign_city(int city_idx, int loc_idx, role r) {
+	if (r == primary) {
+		cit_by_prim[city_idx] = loc_idx;
+		cap_location[loc_idx] += inst->cities[city_idx].get_population();
+	}
+	else if (r == secondary) {
+		cit_by_sec[city_idx] = loc_idx;
+		cap_location[loc_idx] += 0.10*inst->cities[city_idx].get_population();
+	}
+	
+	vector<int>& served = loc_cities[loc_idx];
+	served.insert(lower_bound(served.begin(), served.end(), city_idx), city_idx);
+}
+
+void interface::build_loc_cities() {
+	loc_cities = vector<vector<int> >(n_locations);
+	for (int c = 0; c < n_cities; ++c) {
+		if (cit_by_prim[c] != -1) {
+			loc_cities[ cit_by_prim[c] ].push_back(c);
+		}
+		if (cit_by_sec[c] != -1 and cit_by_sec[c] != cit_by_prim[c]) {
+			loc_cities[ cit_by_sec[c] ].push_back(c);
+		}
+	}
+}
+
+void interface::update_installed_cost() {
+	installed_cost = 0.0;
+	for (int l = 0; l < n_locations; ++l) {
+		if (location_centre_type[l] != -1) {
+			installed_cost += inst->centres[ location_centre_type[l] ].get_installation_cost();
+		}
+	}
 }
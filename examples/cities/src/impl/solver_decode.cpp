@@ -4,82 +4,94 @@
 
 typedef pair<double, int> sorted_chromosome;
 
-/* PUBLIC */
-
-double solver::decode(const chromosome& c) noexcept(false) {
+// Returns the indices of the genes of 'c' sorted by the value
+// of the genes. The genes are compared as doubles.
+template<typename T>
+inline
+vector<sorted_chromosome> __sort_genes(const chromosome<T>& c) {
 	const size_t n_genes = c.size();
 	
 	vector<sorted_chromosome> vc(n_genes);
 	for (size_t g = 0; g < n_genes; ++g) {
-		vc[g].first = c[g];
+		vc[g].first = static_cast<double>(c[g]);
 		vc[g].second = static_cast<int>(g);
 	}
 	sort(vc.begin(), vc.end());
-	
+	return vc;
+}
+
+/* PUBLIC */
+
+double solver::decode(const chromosome<>& c) noexcept(false) {
+	return decode_sorted(__sort_genes(c));
+}
+
+double solver::decode(const chromosome<float>& c) noexcept(false) {
+	return decode_sorted(__sort_genes(c));
+}
+
+double solver::decode(const chromosome<fixed16>& c) noexcept(false) {
+	return decode_sorted(__sort_genes(c));
+}
+
+/* PRIVATE */
+
+double solver::decode_sorted(const vector<sorted_chromosome>& vc) noexcept(false) {
 	set<int> used_locations;
+	vector<char> blocked(n_locations, 0);
+	
+	// The candidates of every city are kept in a priority queue. The
+	// cost of a candidate only depends on the capacity used at its
+	// location, so after every assignment only the candidates at the
+	// chosen location are evaluated again.
+	vector<int> loc_version(n_locations, 0);
+	vector<candidate_queue> Q(n_cities);
+	for (int city_idx = 0; city_idx < n_cities; ++city_idx) {
+		for (int loc_idx = 0; loc_idx < n_locations; ++loc_idx) {
+			push_candidates(city_idx, loc_idx, 0, blocked, Q[city_idx]);
+		}
+	}
+	
 	int K = 0;
 	while (K < 2*n_cities) {
+		bool assigned = false;
 		
 		for (int vc_idx = 0; vc_idx < n_cities; ++vc_idx) {
 			
-			greedy_candidate city_and_loc(n_cities, location_role(n_locations, none));
-			double candidate_min_cost = numeric_limits<double>::max();
-			double dist_min_can = numeric_limits<double>::max();
-			
 			int city_idx = vc[vc_idx].second;
-			for (int loc_idx = 0; loc_idx < n_locations; ++loc_idx) {
-				
-				if (not (cit_by_prim[city_idx] == loc_idx or cit_by_sec[city_idx] == loc_idx)) {
-					if (separated_by_D(loc_idx, used_locations)) {
-						double dist_in_new_candidate = dist_city_loc(city_idx, loc_idx);
-						
-						if (cit_by_prim[city_idx] == -1) {
-							greedy_candidate new_prim_can(city_idx, location_role(loc_idx, primary));
-							double pgc = greedy_cost_dist_pop(city_idx, loc_idx, primary);
-							get_min_candidate
-							(
-								city_and_loc, candidate_min_cost, dist_min_can,
-								new_prim_can, pgc, dist_in_new_candidate
-							);
-						}
-						
-						if (cit_by_sec[city_idx] == -1) {
-							greedy_candidate new_sec_can(city_idx, location_role(loc_idx, secondary));
-							double sgc = greedy_cost_dist_pop(city_idx, loc_idx, secondary);
-							get_min_candidate
-							(
-								city_and_loc, candidate_min_cost, dist_min_can,
-								new_sec_can, sgc, dist_in_new_candidate
-							);
-						}
-					}
-				}
+			if (not clean_top(blocked, loc_version, Q[city_idx])) {
+				continue;
 			}
 			
-			int chosen_city_idx = city_and_loc.first;
-			int chosen_loc_idx = city_and_loc.second.first;
-			role r = city_and_loc.second.second;
+			const queued_candidate best = Q[city_idx].top();
+			Q[city_idx].pop();
 			
-			if (chosen_city_idx < n_cities and chosen_loc_idx < n_locations and r != none) {
-				if (r == primary) {
-					cit_by_prim[chosen_city_idx] = chosen_loc_idx;
-					cap_location[chosen_loc_idx] += cities[chosen_city_idx].get_population();
-				}
-				else if (r == secondary) {
-					cit_by_sec[chosen_city_idx] = chosen_loc_idx;
-					cap_location[chosen_loc_idx] += 0.10*cities[chosen_city_idx].get_population();
-				}
-				used_locations.insert(used_locations.end(), chosen_loc_idx);
-			}
+			int chosen_city_idx = best.city_idx;
+			int chosen_loc_idx = best.loc_idx;
+			role r = best.r;
+			
+			assign_city(chosen_city_idx, chosen_loc_idx, r);
+			used_locations.insert(used_locations.end(), chosen_loc_idx);
+			block_close_locations(chosen_loc_idx, blocked);
+			assigned = true;
 			
+			++loc_version[chosen_loc_idx];
+			for (int c = 0; c < n_cities; ++c) {
+				push_candidates(c, chosen_loc_idx, loc_version[chosen_loc_idx], blocked, Q[c]);
+			}
 		}
 		
 		++K;
+		
+		// nothing changed in this pass, so neither will in the next ones
+		if (not assigned) {
+			break;
+		}
 	}
 	
 	/// CENTRE ASSIGNATION
 	
-	double solution_cost = 0.0;
+	installed_cost = 0.0;
 	set<int>::const_iterator ul_cit;
 	
 	// for every used location ...
@@ -87,27 +99,12 @@ double solver::decode(const chromosome& c) noexcept(false) {
 		
 		int loc_idx = *ul_cit;
 		
-		// ... find the centre ...
-		int centre_idx;
-		bool centre_found = false;
-		
-		int ct_idx = 0;
-		while (ct_idx < n_centres and not centre_found) {
-			
-			// ... that is the cheapest ...
-			centre_idx = sorted_centres[ct_idx];
-			
-			// ... and that satisfies all constraints ...
-			if (joined_constraints_satisfied(loc_idx, centre_idx)) {
-				centre_found = true;
-			}
-			
-			++ct_idx;
-		}
+		// ... find the cheapest centre that satisfies all constraints
+		int centre_idx = cheapest_centre(loc_idx);
 		
-		if (centre_found) {
+		if (centre_idx != -1) {
 			location_centre_type[loc_idx] = centre_idx;
-			solution_cost += centres[centre_idx].get_installation_cost();
+			installed_cost += inst->centres[centre_idx].get_installation_cost();
 		}
 		else {
 			string message = "";
@@ -118,6 +115,6 @@ double solver::decode(const chromosome& c) noexcept(false) {
 		}
 	}
 	
-	return -solution_cost;
+	return -installed_cost;
 }
 
@@ -6,67 +6,25 @@ double solver::greedy_construct() noexcept(false) {
 	const double inf = numeric_limits<double>::max();
 	
 	set<int> used_locations;
+	vector<char> blocked(n_locations, 0);
 	int K = 0;
 	
 	/* LOCATION ASSIGNATION */
 	
-	while (K < 2*n_cities) {
-		
-		greedy_candidate city_and_loc(n_cities, location_role(n_locations, none));
-		double candidate_min_cost = inf;
-		double dist_min_can = inf;
-		
-		for (int city_idx = 0; city_idx < n_cities; ++city_idx) {
-			for (int loc_idx = 0; loc_idx < n_locations; ++loc_idx) {
-				
-				if (not (cit_by_prim[city_idx] == loc_idx or cit_by_sec[city_idx] == loc_idx)) {
-					if (separated_by_D(loc_idx, used_locations)) {
-						double dist_new_candidate = dist_city_loc(city_idx, loc_idx);
-						
-						if (cit_by_prim[city_idx] == -1) {
-							greedy_candidate new_can(city_idx, location_role(loc_idx, primary));
-							double can_cost = greedy_cost_dist_pop(city_idx, loc_idx, primary);
-							if (can_cost < inf) {
-								get_min_candidate
-								(
-									city_and_loc, candidate_min_cost, dist_min_can,
-									new_can, can_cost, dist_new_candidate
-								);
-							}
-						}
-						
-						if (cit_by_sec[city_idx] == -1) {
-							greedy_candidate new_can(city_idx, location_role(loc_idx, secondary));
-							double can_cost = greedy_cost_dist_pop(city_idx, loc_idx, secondary);
-							if (can_cost < inf) {
-								get_min_candidate
-								(
-									city_and_loc, candidate_min_cost, dist_min_can,
-									new_can, can_cost, dist_new_candidate
-								);
-							}
-						}
-					}
-				}
-			}
+	// The cost of a candidate only depends on the capacity used at its
+	// location, so after every assignment only the candidates at the
+	// chosen location are evaluated again.
+	vector<int> loc_version(n_locations, 0);
+	candidate_queue Q;
+	for (int city_idx = 0; city_idx < n_cities; ++city_idx) {
+		for (int loc_idx = 0; loc_idx < n_locations; ++loc_idx) {
+			push_candidates(city_idx, loc_idx, 0, blocked, Q);
 		}
+	}
+	
+	while (K < 2*n_cities) {
 		
-		int city_idx = city_and_loc.first;
-		int loc_idx = city_and_loc.second.first;
-		role r = city_and_loc.second.second;
-		
-		if (city_idx < n_cities and loc_idx < n_locations and r != none) {
-			if (r == primary) {
-				cit_by_prim[city_idx] = loc_idx;
-				cap_location[loc_idx] += cities[city_idx].get_population();
-			}
-			else if (r == secondary) {
-				cit_by_sec[city_idx] = loc_idx;
-				cap_location[loc_idx] += 0.10*cities[city_idx].get_population();
-			}
-			used_locations.insert(used_locations.end(), loc_idx);
-		}
-		else {
+		if (not clean_top(blocked, loc_version, Q) or Q.top().cost == inf) {
 			string message = "";
 			message += "double solver::greedy_construct()\n";
 			message += "    Cannot build solution\n";
@@ -74,6 +32,22 @@ double solver::greedy_construct() noexcept(false) {
 			throw infeasible_exception(message);
 		}
 		
+		const queued_candidate best = Q.top();
+		Q.pop();
+		
+		int city_idx = best.city_idx;
+		int loc_idx = best.loc_idx;
+		role r = best.r;
+		
+		assign_city(city_idx, loc_idx, r);
+		used_locations.insert(used_locations.end(), loc_idx);
+		block_close_locations(loc_idx, blocked);
+		
+		++loc_version[loc_idx];
+		for (int c = 0; c < n_cities; ++c) {
+			push_candidates(c, loc_idx, loc_version[loc_idx], blocked, Q);
+		}
+		
 		++K;
 	}
 	
@@ -81,7 +55,7 @@ double solver::greedy_construct() noexcept(false) {
 	
 	//cin >> step;
 	
-	double solution_cost = 0.0;
+	installed_cost = 0.0;
 	set<int>::const_iterator ul_cit;
 	
 	// for every used location ...
@@ -89,27 +63,12 @@ double solver::greedy_construct() noexcept(false) {
 		
 		int loc_idx = *ul_cit;
 		
-		// ... find the centre ...
-		int centre_idx;
-		bool centre_found = false;
-		
-		int ct_idx = 0;
-		while (ct_idx < n_centres and not centre_found) {
-			
-			// ... that is the cheapest ...
-			centre_idx = sorted_centres[ct_idx];
-			
-			// ... and that satisfies all constraints ...
-			if (joined_constraints_satisfied(loc_idx, centre_idx)) {
-				centre_found = true;
-			}
-			
-			++ct_idx;
-		}
+		// ... find the cheapest centre that satisfies all constraints
+		int centre_idx = cheapest_centre(loc_idx);
 		
-		if (centre_found) {
+		if (centre_idx != -1) {
 			location_centre_type[loc_idx] = centre_idx;
-			solution_cost += centres[centre_idx].get_installation_cost();
+			installed_cost += inst->centres[centre_idx].get_installation_cost();
 		}
 		else {
 			string message = "";
@@ -120,6 +79,6 @@ double solver::greedy_construct() noexcept(false) {
 		}
 	}
 	
-	return -solution_cost;
+	return -installed_cost;
 }
 
@@ -26,28 +26,103 @@ const
 	}
 }
 
+bool solver::queued_candidate::operator> (const queued_candidate& q) const {
+	if (cost != q.cost) {
+		return cost > q.cost;
+	}
+	if (dist != q.dist) {
+		return dist > q.dist;
+	}
+	if (city_idx != q.city_idx) {
+		return city_idx > q.city_idx;
+	}
+	if (loc_idx != q.loc_idx) {
+		return loc_idx > q.loc_idx;
+	}
+	return r > q.r;
+}
+
+void solver::push_candidates
+(
+	int city_idx, int loc_idx, int version,
+	const vector<char>& blocked, candidate_queue& Q
+)
+const
+{
+	if (cit_by_prim[city_idx] == loc_idx or cit_by_sec[city_idx] == loc_idx) {
+		return;
+	}
+	if (blocked[loc_idx] != 0) {
+		return;
+	}
+	
+	const double dist = dist_city_loc(city_idx, loc_idx);
+	
+	if (cit_by_prim[city_idx] == -1) {
+		double cost = greedy_cost_dist_pop(city_idx, loc_idx, primary);
+		Q.push( queued_candidate{cost, dist, city_idx, loc_idx, primary, version} );
+	}
+	if (cit_by_sec[city_idx] == -1) {
+		double cost = greedy_cost_dist_pop(city_idx, loc_idx, secondary);
+		Q.push( queued_candidate{cost, dist, city_idx, loc_idx, secondary, version} );
+	}
+}
+
+bool solver::clean_top
+(
+	const vector<char>& blocked, const vector<int>& loc_version,
+	candidate_queue& Q
+)
+const
+{
+	while (not Q.empty()) {
+		const queued_candidate& q = Q.top();
+		
+		bool current = q.version == loc_version[q.loc_idx] and blocked[q.loc_idx] == 0;
+		if (current) {
+			if (q.r == primary) {
+				current = cit_by_prim[q.city_idx] == -1;
+			}
+			else {
+				current = cit_by_sec[q.city_idx] == -1;
+			}
+			current = current and
+				cit_by_prim[q.city_idx] != q.loc_idx and cit_by_sec[q.city_idx] != q.loc_idx;
+		}
+		
+		if (current) {
+			return true;
+		}
+		Q.pop();
+	}
+	return false;
+}
+
 bool solver::at_least_one_centre(int city_idx, int loc_idx, double pf, double df, int& cca) const {
 	const double dist = dist_city_loc(city_idx, loc_idx);
 	
+	const double load = cap_location[loc_idx] + pf*inst->cities[city_idx].get_population();
+	
+	// the dominated centre types are never the cheapest available
+	const size_t NF = inst->centre_frontier.size();
+	
 	bool alo = false;
-	int ct_idx = 0;
-	while (ct_idx < n_centres and not alo) {
-		
-		int centre_idx = sorted_centres[ct_idx];
+	size_t f = 0;
+	while (f < NF and not alo) {
 		
 		// capacity not exceeded ...
-		if (cap_location[loc_idx] + pf*cities[city_idx].get_population() <= centres[centre_idx].get_capacity()) {
+		if (load <= inst->frontier_capacity[f]) {
 			
 			// ... and distance not exceeded ...
-			if (dist <= df*centres[centre_idx].get_working_distance()) {
+			if (dist <= df*inst->frontier_working_distance[f]) {
 				
 				// ... a centre was found
 				alo = true;
-				cca = centre_idx;
+				cca = inst->centre_frontier[f];
 			}
 		}
 		
-		++ct_idx;
+		++f;
 	}
 	
 	return alo;
@@ -100,7 +175,7 @@ double solver::greedy_cost_dist(int city_idx, int loc_idx, role r) const {
 		cost = dist_city_loc(city_idx, loc_idx);
 	}
 	else if (C == 3) {
-		cost = dist_city_loc(city_idx, loc_idx)*centres[cca].get_installation_cost();
+		cost = dist_city_loc(city_idx, loc_idx)*inst->centres[cca].get_installation_cost();
 	}
 	
 	return cost;
@@ -152,14 +227,14 @@ double solver::greedy_cost_pop(int city_idx, int loc_idx, role r) const {
 		
 		cost = cap_location[loc_idx];
 		if (r == primary) {
-			cost += cities[city_idx].get_population();
+			cost += inst->cities[city_idx].get_population();
 		}
 		else if (r == secondary) {
-			cost += 0.10*cities[city_idx].get_population();
+			cost += 0.10*inst->cities[city_idx].get_population();
 		}
 		
 		if (C == 3) {
-			cost *= centres[cca].get_installation_cost();
+			cost *= inst->centres[cca].get_installation_cost();
 		}
 	}
 	return cost;
@@ -210,17 +285,17 @@ double solver::greedy_cost_dist_pop(int city_idx, int loc_idx, role r) const {
 	if (C != 2) {
 		cost = cap_location[loc_idx];
 		if (r == primary) {
-			cost += cities[city_idx].get_population();
+			cost += inst->cities[city_idx].get_population();
 		}
 		else if (r == secondary) {
-			cost += 0.10*cities[city_idx].get_population();
+			cost += 0.10*inst->cities[city_idx].get_population();
 		}
 		
 		if (C == 1) {
 			cost += dist_city_loc(city_idx, loc_idx);
 		}
 		else if (C == 3) {
-			cost += dist_city_loc(city_idx, loc_idx)*centres[cca].get_installation_cost();
+			cost += dist_city_loc(city_idx, loc_idx)*inst->centres[cca].get_installation_cost();
 		}
 	}
 	return cost;
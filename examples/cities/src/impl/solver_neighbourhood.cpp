@@ -28,124 +28,138 @@ bool __satisfies_constraints
 
 bool solver::can_remove_centre
 (
-	int loc_idx, const vector<role>& cities_served, vector<int>& new_locs
+	int loc_idx, const vector<pair<int, role> >& cities_served, vector<int>& new_locs
 )
 const
 {
-	vector<pair<double, int> > sorted_cities_served(n_cities);
-	for (int c = 0; c < n_cities; ++c) {
-		if (cities_served[c] == none) {
-			sorted_cities_served[c].first = numeric_limits<double>::max();
-		}
-		else {
-			sorted_cities_served[c].first = cities[c].get_population();
-			if (cities_served[c] == secondary) {
-				sorted_cities_served[c].first *= 0.1;
-			}
+	const int n_served = static_cast<int>(cities_served.size());
+	new_locs.resize(n_served);
+	
+	// (added capacity, position in 'cities_served'): the positions
+	// follow the order of the cities' indices
+	vector<pair<double, int> >& sorted_cities_served = scratch_sorted_cities;
+	sorted_cities_served.resize(n_served);
+	for (int i = 0; i < n_served; ++i) {
+		int c = cities_served[i].first;
+		sorted_cities_served[i].first = inst->cities[c].get_population();
+		if (cities_served[i].second == secondary) {
+			sorted_cities_served[i].first *= 0.1;
 		}
-		sorted_cities_served[c].second = c;
+		sorted_cities_served[i].second = i;
 	}
 	sort(sorted_cities_served.begin(), sorted_cities_served.end());
 	
 	// cities that were served by 'loc_idx' are now sorted increasingly
 	// by their added capacity
 	
+	// the capacity of the locations that receive cities is updated in
+	// 'scratch_cap', the rest is read from 'cap_location'
+	if (scratch_touched.size() != size_t(n_locations)) {
+		scratch_cap.assign(n_locations, 0.0);
+		scratch_touched.assign(n_locations, 0);
+	}
 	
 	bool can_remove = true;
-	vector<double> copy_cap_location = cap_location;
 	
-	// for every city ...
+	// for every city served by location 'loc_idx' ...
 	int c_idx = 0;
-	while (c_idx < n_cities and can_remove) {
+	while (c_idx < n_served and can_remove) {
 		
-		int city_idx = sorted_cities_served[c_idx].second;
-		const point& city_pos = cities[city_idx].get_position();
-		new_locs[city_idx] = n_locations;
+		int served_idx = sorted_cities_served[c_idx].second;
+		int city_idx = cities_served[served_idx].first;
+		role city_role = cities_served[served_idx].second;
+		new_locs[served_idx] = n_locations;
 		
-		// ... served by location 'loc_idx' ...
-		if (cities_served[city_idx] != none)  {
-			
-			double max_gap = 0.0;	// gap = |cap_location + city_pop - centre_capacity|
-			double min_dist = numeric_limits<double>::max();	// distance between 'city_idx' and location 'l_it'
-			int min_loc = n_locations;
+		// population and distance factors
+		const double pf = (city_role == primary ? 1.0 : 0.1);
+		const double df = (city_role == primary ? 1.0 : 3.0);
+		const double city_pop = inst->cities[city_idx].get_population();	// added capacity
+		
+		double max_gap = 0.0;	// gap = |cap_location + city_pop - centre_capacity|
+		double min_dist = numeric_limits<double>::max();	// distance between 'city_idx' and location 'l_it'
+		int min_loc = n_locations;
+		
+		// ... check every location that can reach the city, closest
+		// first, until no centre type can reach it ...
+		const double max_dist = df*inst->max_working_distance;
+		int r = inst->reach_begin[city_idx];
+		const int r_end = inst->reach_begin[city_idx + 1];
+		
+		bool in_reach = true;
+		while (r < r_end and in_reach) {
+			int l_it = inst->reach_locations[r];
+			double dist_to_loc = dist_city_loc(city_idx, l_it);	// distance between location and city
+			in_reach = dist_to_loc <= max_dist;
 			
-			// ... check every location ...
-			int l_it = 0;
-			while (l_it < n_locations) {
-				
-				// ... that is not 'loc_idx', has a centre installed in it ...
-				if (l_it != loc_idx and location_centre_type[l_it] != -1) {
-					// ... and is not serving already city 'c' ...
-					if (cit_by_prim[city_idx] != l_it and cit_by_sec[city_idx] != l_it) {
-						
-						double location_capacity = copy_cap_location[l_it];	// current capacity occupied at location l_it
-						double city_pop = cities[city_idx].get_population();	// added capacity
-						double dist_city_loc = city_pos.distance(locations[l_it]);	// distance between location and city
-						
-						int centre_idx = location_centre_type[l_it];
-						double centre_cap = centres[centre_idx].get_capacity();// centre capacity
-						double wd = centres[centre_idx].get_working_distance();// centre's working distance
+			// ... that is not 'loc_idx', has a centre installed in it ...
+			if (in_reach and l_it != loc_idx and location_centre_type[l_it] != -1) {
+				// ... and is not serving already city 'c' ...
+				if (cit_by_prim[city_idx] != l_it and cit_by_sec[city_idx] != l_it) {
+					
+					// current capacity occupied at location l_it
+					double location_capacity = (scratch_touched[l_it] ? scratch_cap[l_it] : cap_location[l_it]);
+					
+					int centre_idx = location_centre_type[l_it];
+					double centre_cap = inst->centres[centre_idx].get_capacity();// centre capacity
+					double wd = inst->centres[centre_idx].get_working_distance();// centre's working distance
+					
+					// ... check whether it satisfies all constraints or not ...
+					if ((location_capacity + pf*city_pop) <= centre_cap and dist_to_loc <= df*wd) {
 						
-						// population and distance factors
-						double pf, df;
-						if (cities_served[city_idx] == primary) {
-							pf = 1.0;
-							df = 1.0;
-						}
-						else if (cities_served[city_idx] == secondary) {
-							pf = 0.1;
-							df = 3.0;
-						}
-						else {
-							cerr << "Error (solver::can_remove_centre): city " << city_idx << " not served by a location" << endl;
-							df = pf = -1.0;
-						}
+						// gap = |cap_location + pf*city_pop - centre_capacity|
+						double this_gap = centre_cap - (location_capacity + pf*city_pop);
 						
-						// ... check whether it satisfies all constraints or not ...
-						if ((location_capacity + pf*city_pop) <= centre_cap and dist_city_loc <= df*wd) {
-							
-							// gap = |cap_location + pf*city_pop - centre_capacity|
-							double this_gap = centre_cap - (location_capacity + pf*city_pop);
-							
-							if ((max_gap < this_gap) or ((max_gap == this_gap) and (dist_city_loc < min_dist))) {
-								max_gap = this_gap;
-								min_dist = dist_city_loc;
-								min_loc = l_it;
-							}
+						// the locations are not visited by index, so ties
+						// in gap and distance go to the smallest index
+						if ((max_gap < this_gap) or
+							((max_gap == this_gap) and (dist_to_loc < min_dist or (dist_to_loc == min_dist and l_it < min_loc))))
+						{
+							max_gap = this_gap;
+							min_dist = dist_to_loc;
+							min_loc = l_it;
 						}
 					}
 				}
-				
-				++l_it;
 			}
 			
-			if (min_loc < n_locations) {
-				new_locs[city_idx] = min_loc;
-				
-				double pf = (cities_served[city_idx] == primary ? 1.0 : 0.1);
-				copy_cap_location[min_loc] += pf*cities[city_idx].get_population();
-			}
-			else {
-				can_remove = false;
+			++r;
+		}
+		
+		if (min_loc < n_locations) {
+			new_locs[served_idx] = min_loc;
+			
+			if (not scratch_touched[min_loc]) {
+				scratch_touched[min_loc] = 1;
+				scratch_cap[min_loc] = cap_location[min_loc];
+				scratch_touched_locs.push_back(min_loc);
 			}
+			scratch_cap[min_loc] += pf*city_pop;
+		}
+		else {
+			can_remove = false;
 		}
 		
 		++c_idx;
 	}
 	
+	for (int l : scratch_touched_locs) {
+		scratch_touched[l] = 0;
+	}
+	scratch_touched_locs.clear();
+	
 	return can_remove;
 }
 
 void solver::delete_centre
 (
 	int loc_idx,
-	const vector<role>& cities_served,
+	const vector<pair<int, role> >& cities_served,
 	const vector<int>& new_locations,
 	problem **neigh
 )
 const
 {
-	*neigh = clone();
+	*neigh = acquire_neighbour();
 	solver *new_sol = static_cast<solver *>(*neigh);
 	
 	// 1. Uninstall old centre from location 'l'
@@ -155,57 +169,38 @@ const
 	//    2.1. Add the populations of cities served by location 'l'
 	//         to the new locations that serve them
 	//    2.2. set new locations serving the orphaned cities
-	for (int city_idx = 0; city_idx < n_cities; ++city_idx) {
-		
-		int new_idx = new_locations[city_idx];
-		
-		if (cities_served[city_idx] == primary) {
-			new_sol->cap_location[new_idx] += cities[city_idx].get_population();
-			new_sol->cit_by_prim[city_idx] = new_idx;
-		}
-		else if (cities_served[city_idx] == secondary) {
-			new_sol->cap_location[new_idx] += 0.10*cities[city_idx].get_population();
-			new_sol->cit_by_sec[city_idx] = new_idx;
-		}
+	for (size_t i = 0; i < cities_served.size(); ++i) {
+		new_sol->assign_city(cities_served[i].first, new_locations[i], cities_served[i].second);
 	}
 	
 	//    2.3. set to 0 the capacity occupied at location 'l'
 	new_sol->cap_location[loc_idx] = 0.0;
+	new_sol->loc_cities[loc_idx].clear();
+	
+	// 3. Update the cost
+	new_sol->update_installed_cost();
 }
 
 void solver::replace_centre(int loc_idx, int centre_idx, problem **neigh) const
 {
-	*neigh = clone();
+	*neigh = acquire_neighbour();
 	solver *new_sol = static_cast<solver *>(*neigh);
 	
 	// 1. Replace the old centre in location 'loc_idx'
 	new_sol->location_centre_type[loc_idx] = centre_idx;
+	
+	// 2. Update the cost
+	new_sol->update_installed_cost();
 }
 
 bool solver::find_better_centre(int loc_idx, int& centre_idx) const {
 	int centre_installed = location_centre_type[loc_idx];
-	double instal_cost = centres[centre_installed].get_installation_cost();
+	double instal_cost = inst->centres[centre_installed].get_installation_cost();
 	
-	centre_idx = n_centres;
-	bool centre_found = false;
-	bool cheaper_centres_left = true;
-	
-	int ct_idx = 0;
-	while (ct_idx < n_centres and not centre_found and cheaper_centres_left) {
-		
-		centre_idx = sorted_centres[ct_idx];
-		if (centres[centre_idx].get_installation_cost() < instal_cost) {
-			if (joined_constraints_satisfied(loc_idx, centre_idx)) {
-				centre_found = true;
-			}
-		}
-		else {
-			cheaper_centres_left = false;
-		}
-		++ct_idx;
-	}
-	
-	return centre_found;
+	// if the cheapest centre that can be installed is not cheaper than
+	// the one installed, no other centre is
+	centre_idx = cheapest_centre(loc_idx);
+	return centre_idx != -1 and inst->centres[centre_idx].get_installation_cost() < instal_cost;
 }
 
 /* PUBLIC */
@@ -218,18 +213,18 @@ void solver::best_neighbour(pair<problem *, double>& bn, const local_search_poli
 	
 	bool finish = false;
 	
+	vector<pair<int, role> >& cities_served = scratch_cities_served;
+	vector<int>& new_locations = scratch_new_locations;
+	
 	// for all locations that have a centre installed
 	int loc_idx = 0;
 	while (loc_idx < n_locations and not finish) {
 		
 		if (location_centre_type[loc_idx] != -1) {
 			// what cities is this location serving?
-			int n_cities_served;
-			vector<role> cities_served(n_cities);
-			cities_served_by_location(loc_idx, cities_served, n_cities_served);
+			cities_served_by_location(loc_idx, cities_served);
 			
 			// can we remove the centre? ...
-			vector<int> new_locations(n_cities);
 			bool can_remove = can_remove_centre(loc_idx, cities_served, new_locations);
 			
 			if (can_remove) {
@@ -237,7 +232,7 @@ void solver::best_neighbour(pair<problem *, double>& bn, const local_search_poli
 				// than the current best one found
 				++n_neighbours_explored;
 				
-				double centre_cost = centres[location_centre_type[loc_idx]].get_installation_cost();
+				double centre_cost = inst->centres[location_centre_type[loc_idx]].get_installation_cost();
 				if (original_cost - centre_cost < best_cost) {
 					
 					if (lsp == First_Improvement) {
@@ -247,9 +242,7 @@ void solver::best_neighbour(pair<problem *, double>& bn, const local_search_poli
 					problem *neigh;
 					delete_centre(loc_idx, cities_served, new_locations, &neigh);
 					
-					if (bn.first != NULL) {
-						delete bn.first;
-					}
+					release_neighbour(bn.first);
 					
 					bn.first = neigh;
 					best_cost = original_cost - centre_cost;
@@ -264,8 +257,8 @@ void solver::best_neighbour(pair<problem *, double>& bn, const local_search_poli
 				if (can_replace) {
 					++n_neighbours_explored;
 					
-					double old_centre_cost = centres[location_centre_type[loc_idx]].get_installation_cost();
-					double new_centre_cost = centres[cheaper_centre].get_installation_cost();
+					double old_centre_cost = inst->centres[location_centre_type[loc_idx]].get_installation_cost();
+					double new_centre_cost = inst->centres[cheaper_centre].get_installation_cost();
 					
 					// ... if so, check that the new solution is indeed better than
 					// the current best one found
@@ -278,9 +271,7 @@ void solver::best_neighbour(pair<problem *, double>& bn, const local_search_poli
 						problem *neigh;
 						replace_centre(loc_idx, cheaper_centre, &neigh);
 						
-						if (bn.first != NULL) {
-							delete bn.first;
-						}
+						release_neighbour(bn.first);
 						
 						bn.first = neigh;
 						best_cost = original_cost - old_centre_cost + new_centre_cost;
@@ -5,91 +5,236 @@
 typedef pair<int, interface::role> locR;
 typedef pair<int, locR> candidate;
 typedef pair<double, candidate> eval_candidate;
-typedef set<eval_candidate>::const_iterator scit;
-typedef vector<eval_candidate>::const_iterator vcit;
+
+// Candidates sorted by cost (then by city, location and role) stored in
+// a list of sorted blocks of at most 2*B elements. Insertions and
+// deletions move at most 2*B elements, and counting the candidates
+// not more expensive than a given cost, or finding the k-th candidate,
+// only needs one step per block.
+class sorted_candidates {
+	private:
+		static const size_t B = 256;
+		
+		vector<vector<eval_candidate> > blocks;
+		
+		// index of the block where 'e' is, or where it has to be inserted
+		size_t find_block(const eval_candidate& e) const {
+			size_t i = 0, j = blocks.size() - 1;
+			while (i < j) {
+				size_t m = (i + j)/2;
+				if (blocks[m].back() < e) {
+					i = m + 1;
+				}
+				else {
+					j = m;
+				}
+			}
+			return i;
+		}
+		
+	public:
+		// Builds the list from the candidates in 'all'.
+		void build(vector<eval_candidate>& all) {
+			sort(all.begin(), all.end());
+			blocks.clear();
+			for (size_t i = 0; i < all.size(); i += B) {
+				blocks.push_back(vector<eval_candidate>(
+					all.begin() + i, all.begin() + min(i + B, all.size())
+				));
+			}
+		}
+		
+		bool empty() const { return blocks.empty(); }
+		const eval_candidate& front() const { return blocks.front().front(); }
+		const eval_candidate& back() const { return blocks.back().back(); }
+		
+		void insert(const eval_candidate& e) {
+			if (blocks.empty()) {
+				blocks.push_back(vector<eval_candidate>(1, e));
+				return;
+			}
+			
+			size_t b = find_block(e);
+			vector<eval_candidate>& block = blocks[b];
+			block.insert(lower_bound(block.begin(), block.end(), e), e);
+			
+			if (block.size() > 2*B) {
+				vector<eval_candidate> half(block.begin() + B, block.end());
+				block.resize(B);
+				blocks.insert(blocks.begin() + b + 1, half);
+			}
+		}
+		
+		void erase(const eval_candidate& e) {
+			size_t b = find_block(e);
+			vector<eval_candidate>& block = blocks[b];
+			block.erase(lower_bound(block.begin(), block.end(), e));
+			
+			if (block.empty()) {
+				blocks.erase(blocks.begin() + b);
+			}
+		}
+		
+		// Amount of candidates whose cost is at most 'cost'
+		size_t count_not_greater(double cost) const {
+			size_t count = 0;
+			for (size_t b = 0; b < blocks.size(); ++b) {
+				const vector<eval_candidate>& block = blocks[b];
+				if (block.back().first <= cost) {
+					count += block.size();
+				}
+				else {
+					count += upper_bound(
+						block.begin(), block.end(), cost,
+						[](double c, const eval_candidate& e) { return c < e.first; }
+					) - block.begin();
+					break;
+				}
+			}
+			return count;
+		}
+		
+		// The k-th candidate of the list (starting at 0)
+		const eval_candidate& at(size_t k) const {
+			size_t b = 0;
+			while (k >= blocks[b].size()) {
+				k -= blocks[b].size();
+				++b;
+			}
+			return blocks[b][k];
+		}
+};
 
 /* PUBLIC */
 
 double solver::random_construct(drandom_generator<> *RNG, double alpha) noexcept(false) {
 	set<int> used_locations;
+	vector<char> blocked(n_locations, 0);
 	
 	// LOCATION ASSIGNATION
 	
-	set<eval_candidate> candidate_list;
+	// The cost of a candidate only depends on the capacity used at its
+	// location, so after every assignment only the candidates at the
+	// chosen location are re-evaluated. The candidates of the chosen
+	// city with the chosen role, and those at the locations that become
+	// blocked, are removed.
 	
-	int K = 0;
-	while (K < 2*n_cities) {
-		
-		// build candidate list
-		candidate_list.clear();
-		
-		for (int city_idx = 0; city_idx < n_cities; ++city_idx) {
-			for (int loc_idx = 0; loc_idx < n_locations; ++loc_idx) {
+	// cost of every candidate in the list:
+	// cand_cost[(city_idx*n_locations + loc_idx)*2 + (r == secondary)]
+	vector<double> cand_cost(2*size_t(n_cities)*n_locations);
+	vector<char> in_list(cand_cost.size(), 0);
+	
+	auto cand_pos =
+	[&](int city_idx, int loc_idx, role r) -> size_t {
+		return (size_t(city_idx)*n_locations + loc_idx)*2 + (r == secondary);
+	};
+	
+	sorted_candidates candidate_list;
+	vector<eval_candidate> all_candidates;
+	
+	for (int city_idx = 0; city_idx < n_cities; ++city_idx) {
+		for (int loc_idx = 0; loc_idx < n_locations; ++loc_idx) {
+			
+			if (not (cit_by_prim[city_idx] == loc_idx or cit_by_sec[city_idx] == loc_idx)) {
 				
-				if (not (cit_by_prim[city_idx] == loc_idx or cit_by_sec[city_idx] == loc_idx)) {
-					if (separated_by_D(loc_idx, used_locations)) {
-						//double dist_in_new_candidate = dist_city_loc(city_idx, loc_idx);
-						
-						if (cit_by_prim[city_idx] == -1) {
-							candidate new_prim_can(city_idx, locR(loc_idx, primary));
-							double pgc = greedy_cost_dist_pop(city_idx, loc_idx, primary);
-							candidate_list.insert( eval_candidate(pgc, new_prim_can) );
-						}
-						
-						if (cit_by_sec[city_idx] == -1) {
-							candidate new_sec_can(city_idx, locR(loc_idx, secondary));
-							double sgc = greedy_cost_dist_pop(city_idx, loc_idx, secondary);
-							candidate_list.insert( eval_candidate(sgc, new_sec_can) );
-						}
-					}
+				if (cit_by_prim[city_idx] == -1) {
+					size_t p = cand_pos(city_idx, loc_idx, primary);
+					cand_cost[p] = greedy_cost_dist_pop(city_idx, loc_idx, primary);
+					in_list[p] = 1;
+					all_candidates.push_back( eval_candidate(cand_cost[p], candidate(city_idx, locR(loc_idx, primary))) );
+				}
+				
+				if (cit_by_sec[city_idx] == -1) {
+					size_t p = cand_pos(city_idx, loc_idx, secondary);
+					cand_cost[p] = greedy_cost_dist_pop(city_idx, loc_idx, secondary);
+					in_list[p] = 1;
+					all_candidates.push_back( eval_candidate(cand_cost[p], candidate(city_idx, locR(loc_idx, secondary))) );
 				}
 			}
 		}
+	}
+	candidate_list.build(all_candidates);
+	all_candidates = vector<eval_candidate>();
+	
+	auto remove_candidate =
+	[&](int city_idx, int loc_idx, role r) -> void {
+		size_t p = cand_pos(city_idx, loc_idx, r);
+		if (in_list[p]) {
+			candidate_list.erase( eval_candidate(cand_cost[p], candidate(city_idx, locR(loc_idx, r))) );
+			in_list[p] = 0;
+		}
+	};
+	
+	int K = 0;
+	while (K < 2*n_cities) {
 		
-		double min_cost = candidate_list.begin()->first;
-		scit last = candidate_list.end(); --last;
-		double max_cost = last->first;
-		
-		// build the restricted candidate list
-		vector<eval_candidate> RCL;
-		for (scit it = candidate_list.begin(); it != candidate_list.end(); ++it) {
-			double cost = it->first;
-			if (cost <= min_cost + alpha*(max_cost - min_cost)) {
-				RCL.push_back(*it);
-			}
+		if (candidate_list.empty()) {
+			string message = "";
+			message += "double solver::random_construct()\n";
+			message += "    Cannot build solution\n";
+			message += "    -> No candidate left\n";
+			throw infeasible_exception(message);
 		}
 		
-		// take a candidate at random
-		RNG->init_uniform(0, RCL.size() - 1);
-		int RCL_idx = static_cast<int>(RNG->get_uniform());
-		const eval_candidate& C = RCL[RCL_idx];
+		double min_cost = candidate_list.front().first;
+		double max_cost = candidate_list.back().first;
+		
+		// the restricted candidate list is made of the first
+		// candidates of the list
+		size_t RCL_size = candidate_list.count_not_greater(min_cost + alpha*(max_cost - min_cost));
+		
+		// take a candidate at random (the size of the list changes
+		// at every step, so the range is given with the draw)
+		int RCL_idx = static_cast<int>(RNG->get_uniform_in(0, RCL_size - 1));
+		const candidate can = candidate_list.at(RCL_idx).second;
 		
-		const candidate& can = C.second;
 		int city_idx = can.first;
 		int loc_idx = can.second.first;
 		role r = can.second.second;
 		
-		if (r == primary) {
-			cit_by_prim[city_idx] = loc_idx;
-		}
-		else if (r == secondary) {
-			cit_by_sec[city_idx] = loc_idx;
+		assign_city(city_idx, loc_idx, r);
+		used_locations.insert(loc_idx);
+		
+		// update the candidate list
+		
+		// the city can no longer be served with role 'r', nor by
+		// location 'loc_idx' with the other role
+		for (int l = 0; l < n_locations; ++l) {
+			remove_candidate(city_idx, l, r);
 		}
+		remove_candidate(city_idx, loc_idx, (r == primary ? secondary : primary));
 		
-		double f = 1.0;
-		if (r == secondary) {
-			f = 0.1;
+		// the locations that become blocked can not be used anymore
+		for (int i = inst->close_begin[loc_idx]; i < inst->close_begin[loc_idx + 1]; ++i) {
+			int l = inst->close_locations[i];
+			if (blocked[l] == 0) {
+				for (int c = 0; c < n_cities; ++c) {
+					remove_candidate(c, l, primary);
+					remove_candidate(c, l, secondary);
+				}
+			}
 		}
+		block_close_locations(loc_idx, blocked);
 		
-		cap_location[loc_idx] += f*cities[city_idx].get_population();
-		used_locations.insert(loc_idx);
+		// the candidates at 'loc_idx' change their cost
+		for (int c = 0; c < n_cities; ++c) {
+			for (role rc : {primary, secondary}) {
+				size_t p = cand_pos(c, loc_idx, rc);
+				if (in_list[p]) {
+					candidate cc(c, locR(loc_idx, rc));
+					candidate_list.erase( eval_candidate(cand_cost[p], cc) );
+					cand_cost[p] = greedy_cost_dist_pop(c, loc_idx, rc);
+					candidate_list.insert( eval_candidate(cand_cost[p], cc) );
+				}
+			}
+		}
 		
 		++K;
 	}
 	
 	/// CENTRE ASSIGNATION
 	
-	double solution_cost = 0.0;
+	installed_cost = 0.0;
 	set<int>::const_iterator ul_cit;
 	
 	// for every used location ...
@@ -97,27 +242,12 @@ double solver::random_construct(drandom_generator<> *RNG, double alpha) noexcept
 		
 		int loc_idx = *ul_cit;
 		
-		// ... find the centre ...
-		int centre_idx;
-		bool centre_found = false;
-		
-		int ct_idx = 0;
-		while (ct_idx < n_centres and not centre_found) {
-			
-			// ... that is the cheapest ...
-			centre_idx = sorted_centres[ct_idx];
-			
-			// ... and that satisfies all constraints ...
-			if (joined_constraints_satisfied(loc_idx, centre_idx)) {
-				centre_found = true;
-			}
-			
-			++ct_idx;
-		}
+		// ... find the cheapest centre that satisfies all constraints
+		int centre_idx = cheapest_centre(loc_idx);
 		
-		if (centre_found) {
+		if (centre_idx != -1) {
 			location_centre_type[loc_idx] = centre_idx;
-			solution_cost += centres[centre_idx].get_installation_cost();
+			installed_cost += inst->centres[centre_idx].get_installation_cost();
 		}
 		else {
 			string message = "";
@@ -128,6 +258,6 @@ double solver::random_construct(drandom_generator<> *RNG, double alpha) noexcept
 		}
 	}
 	
-	return -solution_cost;
+	return -installed_cost;
 }
 
@@ -0,0 +1,189 @@
+#include "instance.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <cmath>
+
+// PUBLIC
+
+void instance::postprocess(double D) {
+	const size_t NC = cities.size();
+	const size_t NL = locations.size();
+	const size_t NT = centres.size();
+	
+	// sort cities by population, store the ordering in sorted_cities
+	sorted_cities.resize(NC);
+	vector<pair<int, int> > cities_pop(NC);
+	for (size_t c = 0; c < NC; ++c) {
+		cities_pop[c].first = cities[c].get_population();
+		cities_pop[c].second = c;
+	}
+	sort(cities_pop.begin(), cities_pop.end());
+	for (size_t c = 0; c < NC; ++c) {
+		sorted_cities[c] = cities_pop[c].second;
+	}
+	
+	// sort centre types by installation cost, store the ordering in
+	// sorted_centres
+	sorted_centres.resize(NT);
+	vector<pair<double, int> > centres_price(NT);
+	for (size_t c = 0; c < NT; ++c) {
+		centres_price[c].first = centres[c].get_installation_cost();
+		centres_price[c].second = c;
+	}
+	sort(centres_price.begin(), centres_price.end());
+	for (size_t c = 0; c < NT; ++c) {
+		sorted_centres[c] = centres_price[c].second;
+	}
+	
+	// keep the centre types not dominated by a cheaper one
+	centre_frontier.clear();
+	frontier_capacity.clear();
+	frontier_working_distance.clear();
+	for (size_t c = 0; c < NT; ++c) {
+		const centre_type& ct = centres[ sorted_centres[c] ];
+		
+		bool dominated = false;
+		for (size_t f = 0; f < centre_frontier.size() and not dominated; ++f) {
+			dominated =
+				frontier_capacity[f] >= ct.get_capacity() and
+				frontier_working_distance[f] >= ct.get_working_distance();
+		}
+		
+		if (not dominated) {
+			centre_frontier.push_back(sorted_centres[c]);
+			frontier_capacity.push_back(ct.get_capacity());
+			frontier_working_distance.push_back(ct.get_working_distance());
+		}
+	}
+	
+	// precompute the distances used by the constructors and the
+	// constraint checks
+	city_loc_dist.clear();
+	if (NC*NL <= MAX_DISTANCES) {
+		city_loc_dist.resize(NC*NL);
+		for (size_t c = 0; c < NC; ++c) {
+			const point& city_pos = cities[c].get_position();
+			for (size_t l = 0; l < NL; ++l) {
+				city_loc_dist[c*NL + l] = city_pos.distance(locations[l]);
+			}
+		}
+	}
+	
+	loc_loc_dist.clear();
+	if (NL*NL <= MAX_DISTANCES) {
+		loc_loc_dist.resize(NL*NL);
+		for (size_t l1 = 0; l1 < NL; ++l1) {
+			for (size_t l2 = 0; l2 < NL; ++l2) {
+				loc_loc_dist[l1*NL + l2] = locations[l1].distance(locations[l2]);
+			}
+		}
+	}
+	
+	compute_reach_locations();
+	compute_close_locations(D);
+}
+
+// PRIVATE
+
+void instance::compute_reach_locations() {
+	const size_t NC = cities.size();
+	const size_t NL = locations.size();
+	
+	max_working_distance = 0.0;
+	for (const centre_type& ct : centres) {
+		max_working_distance = max(max_working_distance, ct.get_working_distance());
+	}
+	const double max_dist = 3.0*max_working_distance;
+	
+	reach_begin.assign(NC + 1, 0);
+	reach_locations.clear();
+	
+	vector<pair<double, int> > reach;
+	for (size_t c = 0; c < NC; ++c) {
+		const point& city_pos = cities[c].get_position();
+		
+		reach.clear();
+		for (size_t l = 0; l < NL; ++l) {
+			double dist = city_pos.distance(locations[l]);
+			if (dist <= max_dist) {
+				reach.push_back(make_pair(dist, int(l)));
+			}
+		}
+		sort(reach.begin(), reach.end());
+		
+		for (const pair<double, int>& r : reach) {
+			reach_locations.push_back(r.second);
+		}
+		reach_begin[c + 1] = static_cast<int>(reach_locations.size());
+	}
+}
+
+void instance::compute_close_locations(double D) {
+	const int NL = static_cast<int>(locations.size());
+	
+	close_begin.assign(NL + 1, 0);
+	close_locations.clear();
+	if (NL == 0 or D <= 0.0) {
+		return;
+	}
+	
+	// bounding box of the locations
+	double min_x = locations[0].get_x(), max_x = min_x;
+	double min_y = locations[0].get_y(), max_y = min_y;
+	for (int l = 1; l < NL; ++l) {
+		min_x = min(min_x, locations[l].get_x());
+		max_x = max(max_x, locations[l].get_x());
+		min_y = min(min_y, locations[l].get_y());
+		max_y = max(max_y, locations[l].get_y());
+	}
+	
+	// the cells have side at least D, so the locations closer than D
+	// to a location are in its cell or in the 8 cells around it. The
+	// side is increased so that there are not many more cells than
+	// locations.
+	const double side = max(max_x - min_x, max_y - min_y);
+	const double cell = max(D, side/ceil(sqrt(double(NL))));
+	const int GX = static_cast<int>((max_x - min_x)/cell) + 1;
+	const int GY = static_cast<int>((max_y - min_y)/cell) + 1;
+	
+	// bucket the locations by cell:
+	// cell_locs[cell_begin[c] ... cell_begin[c + 1] - 1] are the
+	//     locations in cell 'c'
+	vector<int> loc_cell(NL);
+	vector<int> cell_begin(GX*GY + 1, 0);
+	for (int l = 0; l < NL; ++l) {
+		const int cx = static_cast<int>((locations[l].get_x() - min_x)/cell);
+		const int cy = static_cast<int>((locations[l].get_y() - min_y)/cell);
+		loc_cell[l] = cy*GX + cx;
+		++cell_begin[loc_cell[l] + 1];
+	}
+	for (int c = 0; c < GX*GY; ++c) {
+		cell_begin[c + 1] += cell_begin[c];
+	}
+	vector<int> cell_locs(NL);
+	vector<int> next = cell_begin;
+	for (int l = 0; l < NL; ++l) {
+		cell_locs[next[loc_cell[l]]++] = l;
+	}
+	
+	// find the close locations of every location
+	for (int l = 0; l < NL; ++l) {
+		const int cx = loc_cell[l]%GX;
+		const int cy = loc_cell[l]/GX;
+		
+		for (int y = max(0, cy - 1); y <= min(GY - 1, cy + 1); ++y) {
+			for (int x = max(0, cx - 1); x <= min(GX - 1, cx + 1); ++x) {
+				const int c = y*GX + x;
+				for (int i = cell_begin[c]; i < cell_begin[c + 1]; ++i) {
+					const int l2 = cell_locs[i];
+					if (l2 != l and locations[l].distance(locations[l2]) < D) {
+						close_locations.push_back(l2);
+					}
+				}
+			}
+		}
+		sort(close_locations.begin() + close_begin[l], close_locations.end());
+		close_begin[l + 1] = static_cast<int>(close_locations.size());
+	}
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+// C++ includes
+#include <vector>
+using namespace std;
+
+// Custom includes
+#include "centre_type.hpp"
+#include "city.hpp"
+
+// The input data of an instance of the problem.
+//
+// It is built when the instance is read and it is not modified
+// afterwards, so all the solutions to the same instance share it
+// (see interface) and copying a solution only copies its solution data.
+class instance {
+	public:
+		instance() = default;
+		~instance() = default;
+		
+		/* INPUT DATA */
+		
+		vector<point> locations;
+		vector<city> cities;
+		vector<centre_type> centres;
+		
+		// Indices of the cities sorted by population
+		vector<int> sorted_cities;
+		// Indices of the centre types sorted by installation cost
+		vector<int> sorted_centres;
+		
+		// Centre types of 'sorted_centres' that are not dominated by a
+		// previous one, in the same order. A centre type is dominated if a
+		// previous type has at least its capacity and working distance:
+		// the dominated type is never the cheapest that can be installed.
+		vector<int> centre_frontier;
+		// Capacity and working distance of the centre types in
+		// 'centre_frontier'
+		vector<double> frontier_capacity;
+		vector<double> frontier_working_distance;
+		
+		/* DISTANCES */
+		
+		// Distances between every city and every location, and between
+		// every pair of locations, stored by rows:
+		// city_loc_dist[c*n_locations + l] = distance between city 'c'
+		//     and location 'l'
+		// loc_loc_dist[l1*n_locations + l2] = distance between locations
+		//     'l1' and 'l2'
+		// They are empty if the instance is so large that the matrices
+		// would not fit in memory (see MAX_DISTANCES).
+		vector<double> city_loc_dist;
+		vector<double> loc_loc_dist;
+		
+		// Maximum number of distances stored in each matrix.
+		static const size_t MAX_DISTANCES = size_t(1) << 25;
+		
+		/* SEPARATION */
+		
+		// Locations closer than D to every location (not including the
+		// location itself), sorted by index:
+		// close_locations[close_begin[l] ... close_begin[l + 1] - 1] are
+		//     the locations closer than D to location 'l'
+		vector<int> close_begin;
+		vector<int> close_locations;
+		
+		/* REACHABLE LOCATIONS */
+		
+		// Largest working distance of all the centre types
+		double max_working_distance = 0.0;
+		
+		// Locations that can serve every city with some centre type, that
+		// is, at a distance of at most 3*max_working_distance, sorted by
+		// distance (and then by index):
+		// reach_locations[reach_begin[c] ... reach_begin[c + 1] - 1] are
+		//     the locations that can serve city 'c'
+		vector<int> reach_begin;
+		vector<int> reach_locations;
+		
+		/* POSTPROCESS */
+		
+		// Sorts the cities and the centre types, computes the frontier
+		// of centre types, the matrices of distances, the locations that
+		// can serve every city and the locations closer than D to every
+		// location.
+		// Called once all the input data is read.
+		void postprocess(double D);
+		
+	private:
+		// Computes 'reach_begin' and 'reach_locations'.
+		void compute_reach_locations();
+		
+		// Computes 'close_begin' and 'close_locations' using a uniform
+		// grid over the locations whose cells have side at least D.
+		void compute_close_locations(double D);
+};
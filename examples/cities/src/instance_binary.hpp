@@ -0,0 +1,58 @@
+#pragma once
+
+// C++ includes
+#include <cstdint>
+#include <cstddef>
+#include <climits>
+using namespace std;
+
+// Binary format of an instance.
+//
+// The file starts with a 'binary_header' followed by one array per
+// field of the text format (structure of arrays). Every array starts
+// at an offset multiple of BINARY_ALIGNMENT, so that the file can be
+// mapped into memory and the arrays read in place:
+//
+//   loc_x, loc_y          n_locations doubles each
+//   city_x, city_y        n_cities doubles each
+//   city_pop              n_cities 32-bit integers
+//   work_dist             n_centres doubles
+//   centre_cap            n_centres doubles
+//   instal_cost           n_centres doubles
+//
+// Values are stored with the byte order of the machine that wrote the
+// file, which is recorded in the header.
+
+// Identifies the files in the binary format
+static const char BINARY_MAGIC[8] = {'C', 'I', 'T', 'I', 'E', 'S', 'B', 'N'};
+static const uint32_t BINARY_VERSION = 1;
+static const uint32_t BINARY_BYTE_ORDER = 0x01020304;
+static const size_t BINARY_ALIGNMENT = 64;
+
+struct binary_header {
+	char magic[8];
+	uint32_t version;
+	uint32_t byte_order;
+	double D;
+	uint64_t n_locations;
+	uint64_t n_cities;
+	uint64_t n_centres;
+};
+
+// Offsets, in bytes from the beginning of the file, of the arrays of
+// an instance with the given sizes.
+class binary_layout {
+	public:
+		binary_layout(uint64_t n_locations, uint64_t n_cities, uint64_t n_centres);
+
+		// False if any size is larger than INT_MAX or the file would
+		// be larger than the largest size_t. The offsets are 0 then.
+		bool valid;
+
+		size_t loc_x, loc_y;
+		size_t city_x, city_y, city_pop;
+		size_t work_dist, centre_cap, instal_cost;
+
+		// size of the whole file
+		size_t file_size;
+};
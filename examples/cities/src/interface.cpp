@@ -3,19 +3,43 @@
 // PUBLIC
 
 double interface::evaluate() const {
-	double c = 0.0;
-	for (size_t l = 0; l < location_centre_type.size(); ++l) {
-		if (location_centre_type[l] != -1) {
-			c += centres[ location_centre_type[l] ].get_installation_cost();
-		}
-	}
-	return -c;
+	return -installed_cost;
 }
 
 bool interface::sanity_check(ostream& err, const string& tab) const {
 	bool is_sane = true;
 	
-	for (int loc_idx = 0; loc_idx < n_locations; ++loc_idx) {
+	// the cities served by every location are cached in 'loc_cities',
+	// which must agree with 'cit_by_prim' and 'cit_by_sec'. The capacity
+	// and working distance are checked with the cache only if it does.
+	vector<vector<int> > served(n_locations);
+	for (int c = 0; c < n_cities; ++c) {
+		if (cit_by_prim[c] != -1) {
+			served[ cit_by_prim[c] ].push_back(c);
+		}
+		if (cit_by_sec[c] != -1 and cit_by_sec[c] != cit_by_prim[c]) {
+			served[ cit_by_sec[c] ].push_back(c);
+		}
+	}
+	bool cache_sane = true;
+	if (loc_cities.size() != served.size()) {
+		is_sane = cache_sane = false;
+		err << tab
+			<< "(0) Sanity check: the cities served are cached for "
+			<< loc_cities.size() << " locations instead of " << n_locations << endl;
+	}
+	else {
+		for (int loc_idx = 0; loc_idx < n_locations; ++loc_idx) {
+			if (loc_cities[loc_idx] != served[loc_idx]) {
+				is_sane = cache_sane = false;
+				err << tab
+					<< "(0) Sanity check: the cities cached as served by location " << loc_idx
+					<< " are not those that it serves" << endl;
+			}
+		}
+	}
+	
+	for (int loc_idx = 0; cache_sane and loc_idx < n_locations; ++loc_idx) {
 		int centre_idx = location_centre_type[loc_idx];
 		if (centre_idx != -1) {
 			
@@ -37,16 +61,20 @@ bool interface::sanity_check(ostream& err, const string& tab) const {
 		}
 	}
 	
+	// only the locations closer than D to each other can violate the
+	// separating distance constraint
 	for (int l1 = 0; l1 < n_locations; ++l1) {
-		for (int l2 = l1 + 1; l2 < n_locations; ++l2) {
-			if (location_centre_type[l1] != -1 and location_centre_type[l2] != -1) {
-				
-				if (locations[l1].distance(locations[l2]) < D) {
-					is_sane = false;
-					err << tab
-						<< "(3) Sanity check: separating distance constraint not satisfied by locations "
-						<< l1 << " and " << l2 << "." << endl;
-				}
+		if (location_centre_type[l1] == -1) {
+			continue;
+		}
+		
+		for (int i = inst->close_begin[l1]; i < inst->close_begin[l1 + 1]; ++i) {
+			int l2 = inst->close_locations[i];
+			if (l2 > l1 and location_centre_type[l2] != -1) {
+				is_sane = false;
+				err << tab
+					<< "(3) Sanity check: separating distance constraint not satisfied by locations "
+					<< l1 << " and " << l2 << "." << endl;
 			}
 		}
 	}
@@ -88,28 +116,37 @@ bool interface::sanity_check(ostream& err, const string& tab) const {
 			}
 		}
 	}
-	
+
+	// the cost returned by 'evaluate' is cached in 'installed_cost'. The
+	// costs are added in increasing order of location, as every method
+	// that computes it does, so the sums must be exactly equal.
+	double cost = 0.0;
+	for (int loc_idx = 0; loc_idx < n_locations; ++loc_idx) {
+		if (location_centre_type[loc_idx] != -1) {
+			cost += inst->centres[ location_centre_type[loc_idx] ].get_installation_cost();
+		}
+	}
+	if (cost != installed_cost) {
+		is_sane = false;
+		err << tab
+			<< "(10) Sanity check: the cost cached " << installed_cost
+			<< " is not the cost of the centres installed " << cost << endl;
+	}
+
 	return is_sane;
 }
 
 // PROTECTED
 
-void interface::cities_served_by_location(int loc_idx, vector<role>& cities_served, int& how_many) const {
-	how_many = 0;
-	for (size_t c = 0; c < cities.size(); ++c) {
-		cities_served[c] = none;
-
+void interface::cities_served_by_location(int loc_idx, vector<pair<int, role> >& cities_served) const {
+	cities_served.clear();
+	for (int c : loc_cities[loc_idx]) {
 		if (cit_by_prim[c] == loc_idx) {
-			cities_served[c] = primary;
-			++how_many;
+			cities_served.push_back(make_pair(c, primary));
 		}
-		else if (cit_by_sec[c] == loc_idx) {
-			cities_served[c] = secondary;
-			++how_many;
+		else {
+			assert(cit_by_sec[c] == loc_idx);
+			cities_served.push_back(make_pair(c, secondary));
 		}
 	}
 }
-
-double interface::dist_city_loc(int city_idx, int loc_idx) const {
-	return cities[city_idx].get_position().distance(locations[loc_idx]);
-}
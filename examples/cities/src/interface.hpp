@@ -3,7 +3,9 @@
 // C++ includes
 #include <algorithm>
 #include <iostream>
+#include <cassert>
 #include <fstream>
+#include <memory>
 #include <vector>
 #include <string>
 #include <set>
@@ -15,8 +17,7 @@ using namespace metaheuristics;
 using namespace structures;
 
 // Custom includes
-#include "centre_type.hpp"
-#include "city.hpp"
+#include "instance.hpp"
 
 class interface : public problem<> {
 	public:
@@ -33,6 +34,17 @@ class interface : public problem<> {
 		void read_from_file(istream& fin = cin);
 		void print_input_data(ostream& fout = cout);
 		
+		// Reads an instance in the binary format (see instance_binary.hpp)
+		// by mapping file 'filename' into memory. Returns false if the
+		// file could not be read or is not in the binary format.
+		bool read_from_binary_file(const string& filename);
+		
+		// Writes the input data in the binary format.
+		bool write_binary(ostream& os) const;
+		
+		// Returns true if file 'filename' is in the binary format.
+		static bool is_binary_file(const string& filename);
+		
 		/* GETTERS */
 		
 		int get_n_cities() const;
@@ -58,6 +70,15 @@ class interface : public problem<> {
 		// true if the solution is feasible. Returns false otherwise.
 		bool sanity_check(ostream& os, const string& tab = "") const;
 		
+		/* Saving a solution */
+		
+		// Writes the solution data into a binary stream (used by
+		// the checkpoints of GRASP).
+		bool write_solution(ostream& os) const;
+		
+		// Reads the solution data written with 'write_solution'.
+		bool read_solution(istream& is);
+		
 		/// Memory handling
 		
 		// Clears the memory used by the instance of this problem.
@@ -67,18 +88,25 @@ class interface : public problem<> {
 		
 	protected:
 
+		// Builds the input data from the arrays of the instance, as
+		// they appear in the text and binary formats, and leaves the
+		// solution empty.
+		void set_input_data
+		(
+			double d,
+			int NL, const double *loc_x, const double *loc_y,
+			int NC, const double *city_x, const double *city_y, const int *city_pop,
+			int NT, const double *work_dist, const double *centre_cap, const double *instal_cost
+		);
+
 		double D;
 
 		int n_locations;
 		int n_centres;
 		int n_cities;
 
-		vector<point> locations;
-		vector<city> cities;
-		vector<centre_type> centres;
-
-		vector<int> sorted_cities;
-		vector<int> sorted_centres;
+		// Input data, shared by all the copies of a solution
+		shared_ptr<const instance> inst;
 
 		/* Instance solution */
 
@@ -100,26 +128,46 @@ class interface : public problem<> {
 		vector<int> cit_by_prim;
 		vector<int> cit_by_sec;
 
+		// Cities served by every location, with any role, sorted by index
+		// loc_cities[l] = {c : cit_by_prim[c] == l or cit_by_sec[c] == l}
+		vector<vector<int> > loc_cities;
+
+		// Sum of the installation costs of the centres installed, added
+		// up in increasing order of location.
+		double installed_cost = 0.0;
+
 		/* Miscellaneous functions */
 
-		// Copies all input data and solution data
+		// Shares the input data and copies the solution data
 		void copy_interface(const interface *i);
 
-		// Copies only input data
+		// Shares the input data and leaves the solution empty
 		void copy_empty(const interface *i);
 
 		// Erases solution data
 		void empty_interface();
 
+		// Assigns location 'loc_idx' to city 'city_idx' with role 'r' and
+		// updates the capacity occupied at the location.
+		void assign_city(int city_idx, int loc_idx, role r);
+
+		// Builds 'loc_cities' from 'cit_by_prim' and 'cit_by_sec'.
+		void build_loc_cities();
+
+		// Computes 'installed_cost' from 'location_centre_type'.
+		void update_installed_cost();
+
 		/* Constraint checking */
 
 		// Check that there is a distance of at least D to the rest of
 		// locations with a centre installed.
 		bool separated_by_D(int loc_idx) const;
 
-		// Check that there is a distance of at least D to the locations
-		// in 'locs'
-		bool separated_by_D(int loc_idx, const set<int>& locs) const;
+		// Sets to 1 the positions of 'blocked' of the locations closer
+		// than D to 'loc_idx'. The constructors keep these flags for the
+		// locations used so far: a location 'l' is separated by D from
+		// all of them if, and only if, blocked[l] == 0.
+		void block_close_locations(int loc_idx, vector<char>& blocked) const;
 
 		// Assuming that the location is assigned to serve some cities,
 		// check that the working distance would be exceeded in case
@@ -140,18 +188,33 @@ class interface : public problem<> {
 		// Returns true if satisfied.
 		bool joined_constraints_satisfied(int loc_idx, int centre_idx) const;
 
-		// Sets to 'orimary' the positions 'c' in 'cities_served' such that
-		//     cit_by_prim[c] == loc_idx or
-		// and to 'secondary' the positions 'c' in 'cities_served' such that
-		//     cit_by_sec[c] == loc_idx
-		// and sets to 'none' the rest and stores in 'how_many' the amounts
-		// of positions set to 'primary' or 'secondary'.
-		void cities_served_by_location(int loc_idx, vector<role>& cities_served, int& how_many) const;
+		// Returns the cheapest centre type that satisfies the working
+		// distance and capacity constraints of the cities served by
+		// location 'loc_idx', or -1 if there is none.
+		int cheapest_centre(int loc_idx) const;
+
+		// Stores in 'cities_served' the cities served by location
+		// 'loc_idx', sorted by index, together with the role with which
+		// they are served.
+		void cities_served_by_location(int loc_idx, vector<pair<int, role> >& cities_served) const;
 
 		/* Utils */
 
 		// Returns the distance between the city 'city_idx' and the
 		// location 'loc_idx'
-		double dist_city_loc(int city_idx, int loc_idx) const;
+		inline double dist_city_loc(int city_idx, int loc_idx) const {
+			if (not inst->city_loc_dist.empty()) {
+				return inst->city_loc_dist[size_t(city_idx)*n_locations + loc_idx];
+			}
+			return inst->cities[city_idx].get_position().distance(inst->locations[loc_idx]);
+		}
+
+		// Returns the distance between the locations 'l1' and 'l2'
+		inline double dist_loc_loc(int l1, int l2) const {
+			if (not inst->loc_loc_dist.empty()) {
+				return inst->loc_loc_dist[size_t(l1)*n_locations + l2];
+			}
+			return inst->locations[l1].distance(inst->locations[l2]);
+		}
 };
 
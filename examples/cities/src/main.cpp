@@ -4,6 +4,7 @@
 /// C++ includes
 #include <iostream>
 #include <fstream>
+#include <memory>
 using namespace std;
 
 /// metaheuristics includes
@@ -15,6 +16,7 @@ using namespace algorithms;
 using namespace random;
 
 /// Custom includes
+#include "parameters.hpp"
 #include "solver.hpp"
 
 void print_usage() {
@@ -22,7 +24,9 @@ void print_usage() {
 	cout << "Usage:" << endl;
 	cout << "    [-h, --help]:        shows this help" << endl;
 	cout << "    [-s, --seed]:        seed the random number generators" << endl;
-	cout << "    [-i, --input] f:     the input file with the description of the instance" << endl;
+	cout << "    [--seed-value] v:    seed the random number generators with value v" << endl;
+	cout << "    [-i, --input] f:     the input file with the description of the instance," << endl;
+	cout << "                         in text or binary format (see cities-convert)" << endl;
 	cout << "    [--optimal] o:       value of the optimal solution (extracted from the ILP solution" << endl;
 	cout << "    [-a, --algorithm] a: the algorithm to be executed. Possible values:" << endl;
 	cout << "        - local-search:  constructs an initial solution deterministically" << endl;
@@ -32,6 +36,8 @@ void print_usage() {
 	cout << "                         for the randomised choice of candidates" << endl;
 	cout << "        - rkga:          aplies the RKGA metaheuristic" << endl;
 	cout << "        - brkga:         aplies the BRKGA metaheuristic" << endl;
+	cout << "        - portfolio:     executes the four algorithms above concurrently, each" << endl;
+	cout << "                         with its own parameters, and keeps the best solution" << endl;
 	cout << endl;
 	
 	cout << "Optional parametres:" << endl;
@@ -61,164 +67,24 @@ void print_usage() {
 	cout << "        [--mut-size] s:        size of the mutant population. Default: 0" << endl;
 	cout << "        [--elite-size] s:      size of the elite population set. Default: 0" << endl;
 	cout << "        [--inher-prob] p:      probability of inheritance. Default: 0.5" << endl;
+	cout << "        [--adaptive]:          adapt the sizes and the probability during the execution" << endl;
+	cout << "    -> Portfolio:" << endl;
+	cout << "        [--budget] s:          stop all the algorithms after s seconds. Default: no limit" << endl;
+	cout << "        [--target] t:          stop all the algorithms when a solution with cost at" << endl;
+	cout << "                               most t is found. Default: no target" << endl;
+	cout << "        The parameters of the four algorithms are those listed above." << endl;
+	cout << "* For GRASP, RKGA and BRKGA:" << endl;
+	cout << "    [--checkpoint] f:          save the state of the algorithm into file f" << endl;
+	cout << "    [--checkpoint-period] i:   iterations (or generations) between checkpoints. Default: 10" << endl;
+	cout << "    [--resume] f:              resume the execution saved in checkpoint f" << endl;
+	cout << "    [--threads] n:             number of threads used by the algorithm, 0 to use" << endl;
+	cout << "                               all processors. Default: 1" << endl;
+	cout << "* For all algorithms except the portfolio:" << endl;
+	cout << "    [--metrics] f:             write the performance metrics into file f," << endl;
+	cout << "                               in CSV format if f ends with '.csv', in JSON otherwise" << endl;
 	cout << endl;
 }
 
-local_search_policy parse_policy(int, char *argv[], int i) {
-	local_search_policy lsp = First_Improvement;
-	if (strcmp(argv[i], "First") == 0) {
-		lsp = First_Improvement;
-	}
-	else if (strcmp(argv[i], "Best") == 0) {
-		lsp = Best_Improvement;
-	}
-	else {
-		cerr << "Unknown value '" << string(argv[i]) << "' for local search policy" << endl;
-	}
-	return lsp;
-}
-
-class local_search_params {
-	public:
-		size_t MAX_ITERATIONS;
-		local_search_policy POLICY;
-		
-		local_search_params() {
-			MAX_ITERATIONS = 10;
-			POLICY = Best_Improvement;
-		}
-		~local_search_params() {}
-		
-};
-
-void parse_local_search_params(int argc, char *argv[], local_search_params& ls_params) {
-	for (int i = 1; i < argc; ++i) {
-		if (strcmp(argv[i], "--iter-local") == 0) {
-			ls_params.MAX_ITERATIONS = atoi(argv[i + 1]);
-			++i;
-		}
-		else if (strcmp(argv[i], "--policy") == 0) {
-			ls_params.POLICY = parse_policy(argc, argv, i + 1);
-			++i;
-		}
-	}
-}
-
-class grasp_params {
-	public:
-		size_t MAX_IT_LOCAL;
-		size_t MAX_IT_GRASP;
-		local_search_policy POLICY;
-		double ALPHA;
-		
-		grasp_params() {
-			MAX_IT_GRASP = MAX_IT_LOCAL = 10;
-			POLICY = Best_Improvement;
-			ALPHA = 1.0;
-		}
-		~grasp_params() { }
-};
-
-void parse_grasp_params(int argc, char *argv[], grasp_params& params) {
-	for (int i = 1; i < argc; ++i) {
-		if (strcmp(argv[i], "--iter-local") == 0) {
-			params.MAX_IT_LOCAL = atoi(argv[i + 1]);
-			++i;
-		}
-		else if (strcmp(argv[i], "--iter-grasp") == 0) {
-			params.MAX_IT_GRASP = atoi(argv[i + 1]);
-			++i;
-		}
-		else if (strcmp(argv[i], "--policy") == 0) {
-			params.POLICY = parse_policy(argc, argv, i + 1);
-			++i;
-		}
-		else if (strcmp(argv[i], "--alpha") == 0) {
-			params.ALPHA = atof(argv[i + 1]);
-			++i;
-		}
-	}
-}
-
-class rkga_params {
-	public:
-		size_t NUM_GENERATIONS;
-		size_t POPULATION_SIZE;
-		size_t MUTANT_POPULATION_SIZE;
-		double INHER_PROB;
-		
-		rkga_params() {
-			NUM_GENERATIONS = 10;
-			POPULATION_SIZE = 0;
-			MUTANT_POPULATION_SIZE = 0;
-			INHER_PROB = 0.5;
-		}
-		~rkga_params() { }
-};
-
-void parse_rkga_params(int argc, char *argv[], rkga_params& params) {
-	for (int i = 1; i < argc; ++i) {
-		if (strcmp(argv[i], "--num-gen") == 0) {
-			params.NUM_GENERATIONS = atoi(argv[i + 1]);
-			++i;
-		}
-		else if (strcmp(argv[i], "--pop-size") == 0) {
-			params.POPULATION_SIZE = atoi(argv[i + 1]);
-			++i;
-		}
-		else if (strcmp(argv[i], "--mut-size") == 0) {
-			params.MUTANT_POPULATION_SIZE = atoi(argv[i + 1]);
-			++i;
-		}
-		else if (strcmp(argv[i], "--inher-prob") == 0) {
-			params.INHER_PROB = atof(argv[i + 1]);
-			++i;
-		}
-	}
-}
-
-class brkga_params {
-	public:
-		size_t NUM_GENERATIONS;
-		size_t POPULATION_SIZE;
-		size_t MUTANT_POPULATION_SIZE;
-		size_t ELITE_SET_SIZE;
-		double INHER_PROB;
-		
-		brkga_params() {
-			NUM_GENERATIONS = 10;
-			POPULATION_SIZE = ELITE_SET_SIZE = 0;
-			MUTANT_POPULATION_SIZE = 0;
-			INHER_PROB = 0.5;
-		}
-		~brkga_params() { }
-};
-
-void parse_brkga_params(int argc, char *argv[], brkga_params& params) {
-	for (int i = 1; i < argc; ++i) {
-		if (strcmp(argv[i], "--num-gen") == 0) {
-			params.NUM_GENERATIONS = atoi(argv[i + 1]);
-			++i;
-		}
-		else if (strcmp(argv[i], "--pop-size") == 0) {
-			params.POPULATION_SIZE = atoi(argv[i + 1]);
-			++i;
-		}
-		else if (strcmp(argv[i], "--mut-size") == 0) {
-			params.MUTANT_POPULATION_SIZE = atoi(argv[i + 1]);
-			++i;
-		}
-		else if (strcmp(argv[i], "--elite-size") == 0) {
-			params.ELITE_SET_SIZE = atoi(argv[i + 1]);
-			++i;
-		}
-		else if (strcmp(argv[i], "--inher-prob") == 0) {
-			params.INHER_PROB = atof(argv[i + 1]);
-			++i;
-		}
-	}
-}
-
 int main(int argc, char *argv[]) {
 	/* ******************************** */
 	// ------- BASIC OUTPUT SETUP ----- //
@@ -234,8 +100,13 @@ int main(int argc, char *argv[]) {
 	bool use_optimal_value = false;
 	double optimal_value = 0.0;
 	bool seed = false;
+	bool use_seed_value = false;
+	uint64_t seed_value = 0;
 	string input_filename, algorithm;
 	input_filename = algorithm = "none";
+	string checkpoint_filename, resume_filename, metrics_filename;
+	size_t checkpoint_period = 10;
+	size_t n_threads = 1;
 	
 	for (int i = 1; i < argc; ++i) {
 		if (strcmp(argv[i], "-h") == 0 or strcmp(argv[i], "--help") == 0) {
@@ -245,6 +116,11 @@ int main(int argc, char *argv[]) {
 		else if (strcmp(argv[i], "-s") == 0 or strcmp(argv[i], "--seed") == 0) {
 			seed = true;
 		}
+		else if (strcmp(argv[i], "--seed-value") == 0) {
+			use_seed_value = true;
+			seed_value = strtoull(argv[i + 1], nullptr, 10);
+			++i;
+		}
 		else if (strcmp(argv[i], "-i") == 0 or strcmp(argv[i], "--input") == 0) {
 			input_filename = string(argv[i + 1]);
 			++i;
@@ -258,6 +134,29 @@ int main(int argc, char *argv[]) {
 			algorithm = string(argv[i + 1]);
 			++i;
 		}
+		else if (strcmp(argv[i], "--checkpoint") == 0) {
+			checkpoint_filename = string(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--checkpoint-period") == 0) {
+			checkpoint_period = atoi(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--resume") == 0) {
+			resume_filename = string(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--metrics") == 0) {
+			metrics_filename = string(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--threads") == 0) {
+			n_threads = atoi(argv[i + 1]);
+			++i;
+		}
+	}
+	if (checkpoint_filename.empty()) {
+		checkpoint_period = 0;
 	}
 	
 	if (algorithm == "none") {
@@ -270,7 +169,9 @@ int main(int argc, char *argv[]) {
 		return 1;
 	}
 	
-	if (algorithm != "local-search" and algorithm != "grasp" and algorithm != "rkga" and algorithm != "brkga") {
+	if (algorithm != "local-search" and algorithm != "grasp" and algorithm != "rkga" and
+		algorithm != "brkga" and algorithm != "portfolio")
+	{
 		cerr << "Error: Wrong value for algorithm parameter" << endl;
 		return 1;
 	}
@@ -279,6 +180,7 @@ int main(int argc, char *argv[]) {
 	grasp_params gs_params;
 	rkga_params r_params;
 	brkga_params br_params;
+	portfolio_params pf_params;
 	
 	if (algorithm == "local-search") {
 		parse_local_search_params(argc, argv, ls_params);
@@ -292,28 +194,55 @@ int main(int argc, char *argv[]) {
 	else if (algorithm == "brkga") {
 		parse_brkga_params(argc, argv, br_params);
 	}
+	else if (algorithm == "portfolio") {
+		parse_local_search_params(argc, argv, ls_params);
+		parse_grasp_params(argc, argv, gs_params);
+		parse_rkga_params(argc, argv, r_params);
+		parse_brkga_params(argc, argv, br_params);
+		parse_portfolio_params(argc, argv, pf_params);
+	}
 	
 	/* ******************************** */
 	// ------- READ INPUT DATA -------- //
 	/* ******************************** */
 	
-	ifstream fin;
-	fin.open(input_filename.c_str());
-	if (!fin.is_open()) {
-		cerr << "File " << input_filename << " does not exist" << endl;
-		return 1;
-	}
-
 	solver *s = new solver();
-	s->read_from_file(fin);
+	
+	if (interface::is_binary_file(input_filename)) {
+		if (not s->read_from_binary_file(input_filename)) {
+			delete s;
+			return 1;
+		}
+	}
+	else {
+		ifstream fin;
+		fin.open(input_filename.c_str());
+		if (!fin.is_open()) {
+			cerr << "File " << input_filename << " does not exist" << endl;
+			delete s;
+			return 1;
+		}
+		s->read_from_file(fin);
+	}
 	//s->print_input_data();
 	
 	/* ******************************** */
 	// ------- EXECUTE ALGORITHM ------ //
 	/* ******************************** */
 	
+	profiling::metrics stats;
+	profiling::metrics *use_stats = (metrics_filename.empty() ? nullptr : &stats);
+	
+	// a single thread executes the algorithms without a pool
+	unique_ptr<concurrency::thread_pool> pool;
+	if (n_threads != 1) {
+		pool.reset(new concurrency::thread_pool(n_threads));
+	}
+	
+	// the algorithms are given the class of the solver, which is final,
+	// so that they call its methods without the virtual interface
 	if (algorithm == "local-search") {
-		local_search<> ls(ls_params.MAX_ITERATIONS, ls_params.POLICY);
+		local_search<default_random_engine, solver> ls(ls_params.MAX_ITERATIONS, ls_params.POLICY);
 		cout << "Local search:" << endl;
 		
 		try {
@@ -324,6 +253,10 @@ int main(int argc, char *argv[]) {
 			if (seed) {
 				ls.seed();
 			}
+			if (use_seed_value) {
+				ls.seed(seed_value);
+			}
+			ls.set_metrics(use_stats);
 			
 			ls.execute_algorithm(s, eval);
 			
@@ -347,7 +280,7 @@ int main(int argc, char *argv[]) {
 	else if (algorithm == "grasp") {
 		cout << "GRASP:" << endl;
 		
-		grasp<> gs
+		grasp<default_random_engine, solver> gs
 		(
 			gs_params.MAX_IT_GRASP,
 			gs_params.MAX_IT_LOCAL,
@@ -358,9 +291,23 @@ int main(int argc, char *argv[]) {
 		if (seed) {
 			gs.seed();
 		}
+		if (use_seed_value) {
+			gs.seed(seed_value);
+		}
+		
+		gs.set_checkpointing(checkpoint_filename, checkpoint_period);
+		gs.set_metrics(use_stats);
+		gs.set_thread_pool(pool.get());
+		if (not resume_filename.empty()) {
+			gs.set_resume_file(resume_filename);
+		}
 		
 		double eval;
-		gs.execute_algorithm(s, eval);
+		if (not gs.execute_algorithm(s, eval)) {
+			cerr << "Error: the execution of the GRASP did not finish" << endl;
+			delete s;
+			return 1;
+		}
 		
 		//cout << "    GRASP solution:" << endl;
 		//s->print("    ");
@@ -378,7 +325,7 @@ int main(int argc, char *argv[]) {
 	else if (algorithm == "rkga") {
 		cout << "RKGA:" << endl;
 		
-		rkga<> r
+		rkga<default_random_engine, solver> r
 		(
 			r_params.POPULATION_SIZE,
 			r_params.MUTANT_POPULATION_SIZE,
@@ -390,9 +337,23 @@ int main(int argc, char *argv[]) {
 		if (seed) {
 			r.seed();
 		}
+		if (use_seed_value) {
+			r.seed(seed_value);
+		}
+		
+		r.set_checkpointing(checkpoint_filename, checkpoint_period);
+		r.set_metrics(use_stats);
+		r.set_thread_pool(pool.get());
+		if (not resume_filename.empty()) {
+			r.set_resume_file(resume_filename);
+		}
 		
 		double eval;
-		r.execute_algorithm(s, eval);
+		if (not r.execute_algorithm(s, eval)) {
+			cerr << "Error: the execution of the RKGA did not finish" << endl;
+			delete s;
+			return 1;
+		}
 		
 		//cout << "    BRKGA solution:" << endl;
 		//s->print("    ");
@@ -407,7 +368,7 @@ int main(int argc, char *argv[]) {
 	else if (algorithm == "brkga") {
 		cout << "BRKGA:" << endl;
 		
-		brkga<> br
+		brkga<default_random_engine, solver> br
 		(
 			br_params.POPULATION_SIZE,
 			br_params.MUTANT_POPULATION_SIZE,
@@ -420,9 +381,24 @@ int main(int argc, char *argv[]) {
 		if (seed) {
 			br.seed();
 		}
+		if (use_seed_value) {
+			br.seed(seed_value);
+		}
+		br.set_adaptive_parameters(br_params.ADAPTIVE);
+		
+		br.set_checkpointing(checkpoint_filename, checkpoint_period);
+		br.set_metrics(use_stats);
+		br.set_thread_pool(pool.get());
+		if (not resume_filename.empty()) {
+			br.set_resume_file(resume_filename);
+		}
 		
 		double eval;
-		br.execute_algorithm(s, eval);
+		if (not br.execute_algorithm(s, eval)) {
+			cerr << "Error: the execution of the BRKGA did not finish" << endl;
+			delete s;
+			return 1;
+		}
 		
 		//cout << "    BRKGA solution:" << endl;
 		//s->print("    ");
@@ -434,12 +410,128 @@ int main(int argc, char *argv[]) {
 			cout << "        Gap = BRKGA - ILP = " << -eval << " - " << optimal_value << " = " << -eval - optimal_value << endl;
 		}
 	}
+	else if (algorithm == "portfolio") {
+		cout << "Portfolio:" << endl;
+		
+		local_search<default_random_engine, solver> ls(ls_params.MAX_ITERATIONS, ls_params.POLICY);
+		grasp<default_random_engine, solver> gs
+		(
+			gs_params.MAX_IT_GRASP,
+			gs_params.MAX_IT_LOCAL,
+			gs_params.ALPHA,
+			gs_params.POLICY
+		);
+		rkga<default_random_engine, solver> r
+		(
+			r_params.POPULATION_SIZE,
+			r_params.MUTANT_POPULATION_SIZE,
+			r_params.NUM_GENERATIONS,
+			s->get_n_cities(),
+			r_params.INHER_PROB
+		);
+		brkga<default_random_engine, solver> br
+		(
+			br_params.POPULATION_SIZE,
+			br_params.MUTANT_POPULATION_SIZE,
+			br_params.ELITE_SET_SIZE,
+			br_params.NUM_GENERATIONS,
+			s->get_n_cities(),
+			br_params.INHER_PROB
+		);
+		br.set_adaptive_parameters(br_params.ADAPTIVE);
+		
+		portfolio<> pf;
+		vector<string> names;
+		
+		auto add_algorithm =
+		[&](metaheuristic<> *a, const string& name, bool improve) -> void {
+			if (seed) {
+				a->seed();
+			}
+			if (use_seed_value) {
+				a->seed(seed_value);
+			}
+			a->set_thread_pool(pool.get());
+			pf.add_algorithm(a, improve);
+			names.push_back(name);
+		};
+		
+		// the local search improves the greedy solution, the other
+		// algorithms build their own solutions
+		double eval = 0.0;
+		try {
+			eval = s->greedy_construct();
+			add_algorithm(&ls, "Local search", true);
+		}
+		catch (const infeasible_exception& e) {
+			cerr << "main: Infeasible solution when greedily constructing "
+				 << "an initial solution for the local search of the portfolio." << endl;
+			cerr << "Message:" << endl;
+			cerr << e.what() << endl;
+			s->clear();
+		}
+		add_algorithm(&gs, "GRASP", false);
+		add_algorithm(&r, "RKGA", false);
+		add_algorithm(&br, "BRKGA", false);
+		
+		if (pf_params.TIME_BUDGET > 0.0) {
+			pf.set_time_budget(pf_params.TIME_BUDGET);
+		}
+		if (pf_params.USE_TARGET) {
+			// the evaluation of a solution is minus its cost
+			pf.set_target(-pf_params.TARGET);
+		}
+		
+		bool finished = false;
+		try {
+			finished = pf.execute_algorithm(s, eval);
+		}
+		catch (const exception& e) {
+			cerr << "Error: an algorithm of the portfolio threw an exception" << endl;
+			cerr << "Message:" << endl;
+			cerr << e.what() << endl;
+			delete s;
+			return 1;
+		}
+		if (not finished) {
+			cerr << "Error: no algorithm of the portfolio finished its execution" << endl;
+			delete s;
+			return 1;
+		}
+		
+		const bool sane = s->sanity_check(cerr);
+		cout << endl;
+		cout << "    Best solution found by: " << names[pf.get_winner()] << endl;
+		cout << "    Stopped by the budget or the target? " << (pf.was_stopped() ? "Yes" : "No") << endl;
+		cout << "    Total execution time: " << pf.get_total_time() << " s" << endl;
+		cout << "    Is final solution sane? " << (sane ? "Yes" : "No") << endl;
+		cout << "    Final solution's cost: " << -eval << endl;
+		if (use_optimal_value) {
+			cout << "        Gap = Portfolio - ILP = " << -eval << " - " << optimal_value << " = " << -eval - optimal_value << endl;
+		}
+	}
+	
+	/* ******************************** */
+	// -------- WRITE METRICS --------- //
+	/* ******************************** */
+	
+	if (use_stats != nullptr) {
+		ofstream fout(metrics_filename.c_str());
+		const string ext = ".csv";
+		if (metrics_filename.size() >= ext.size() and
+			metrics_filename.compare(metrics_filename.size() - ext.size(), ext.size(), ext) == 0)
+		{
+			stats.to_csv(fout);
+		}
+		else {
+			stats.to_json(fout);
+		}
+	}
 	
 	/* ******************************** */
 	// --------- FREE MEMORY ---------- //
 	/* ******************************** */
 	
-	fin.close();
 	delete s;
 }
 
@@ -0,0 +1,120 @@
+#include "parameters.hpp"
+
+// C includes
+#include <string.h>
+
+// C++ includes
+#include <iostream>
+#include <cstdlib>
+#include <string>
+
+local_search_policy parse_policy(int, char *argv[], int i) {
+	local_search_policy lsp = First_Improvement;
+	if (strcmp(argv[i], "First") == 0) {
+		lsp = First_Improvement;
+	}
+	else if (strcmp(argv[i], "Best") == 0) {
+		lsp = Best_Improvement;
+	}
+	else {
+		cerr << "Unknown value '" << string(argv[i]) << "' for local search policy" << endl;
+	}
+	return lsp;
+}
+
+void parse_local_search_params(int argc, char *argv[], local_search_params& ls_params) {
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--iter-local") == 0) {
+			ls_params.MAX_ITERATIONS = atoi(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--policy") == 0) {
+			ls_params.POLICY = parse_policy(argc, argv, i + 1);
+			++i;
+		}
+	}
+}
+
+void parse_grasp_params(int argc, char *argv[], grasp_params& params) {
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--iter-local") == 0) {
+			params.MAX_IT_LOCAL = atoi(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--iter-grasp") == 0) {
+			params.MAX_IT_GRASP = atoi(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--policy") == 0) {
+			params.POLICY = parse_policy(argc, argv, i + 1);
+			++i;
+		}
+		else if (strcmp(argv[i], "--alpha") == 0) {
+			params.ALPHA = atof(argv[i + 1]);
+			++i;
+		}
+	}
+}
+
+void parse_rkga_params(int argc, char *argv[], rkga_params& params) {
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--num-gen") == 0) {
+			params.NUM_GENERATIONS = atoi(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--pop-size") == 0) {
+			params.POPULATION_SIZE = atoi(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--mut-size") == 0) {
+			params.MUTANT_POPULATION_SIZE = atoi(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--inher-prob") == 0) {
+			params.INHER_PROB = atof(argv[i + 1]);
+			++i;
+		}
+	}
+}
+
+void parse_brkga_params(int argc, char *argv[], brkga_params& params) {
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--num-gen") == 0) {
+			params.NUM_GENERATIONS = atoi(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--pop-size") == 0) {
+			params.POPULATION_SIZE = atoi(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--mut-size") == 0) {
+			params.MUTANT_POPULATION_SIZE = atoi(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--elite-size") == 0) {
+			params.ELITE_SET_SIZE = atoi(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--inher-prob") == 0) {
+			params.INHER_PROB = atof(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--adaptive") == 0) {
+			params.ADAPTIVE = true;
+		}
+	}
+}
+
+void parse_portfolio_params(int argc, char *argv[], portfolio_params& params) {
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--budget") == 0) {
+			params.TIME_BUDGET = atof(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--target") == 0) {
+			params.USE_TARGET = true;
+			params.TARGET = atof(argv[i + 1]);
+			++i;
+		}
+	}
+}
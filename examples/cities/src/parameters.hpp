@@ -0,0 +1,100 @@
+#pragma once
+
+// C++ includes
+#include <cstddef>
+using namespace std;
+
+// metaheuristics includes
+#include <metaheuristics/structures.hpp>
+using namespace metaheuristics;
+using namespace structures;
+
+// Parameters of the algorithms, as given in the command line of the
+// cities executable. The parsing functions look for the options of
+// each algorithm in argv[1], ..., argv[argc - 1] and ignore the rest.
+
+class local_search_params {
+	public:
+		size_t MAX_ITERATIONS;
+		local_search_policy POLICY;
+		
+		local_search_params() {
+			MAX_ITERATIONS = 10;
+			POLICY = Best_Improvement;
+		}
+		~local_search_params() {}
+		
+};
+
+class grasp_params {
+	public:
+		size_t MAX_IT_LOCAL;
+		size_t MAX_IT_GRASP;
+		local_search_policy POLICY;
+		double ALPHA;
+		
+		grasp_params() {
+			MAX_IT_GRASP = MAX_IT_LOCAL = 10;
+			POLICY = Best_Improvement;
+			ALPHA = 1.0;
+		}
+		~grasp_params() { }
+};
+
+class rkga_params {
+	public:
+		size_t NUM_GENERATIONS;
+		size_t POPULATION_SIZE;
+		size_t MUTANT_POPULATION_SIZE;
+		double INHER_PROB;
+		
+		rkga_params() {
+			NUM_GENERATIONS = 10;
+			POPULATION_SIZE = 0;
+			MUTANT_POPULATION_SIZE = 0;
+			INHER_PROB = 0.5;
+		}
+		~rkga_params() { }
+};
+
+class brkga_params {
+	public:
+		size_t NUM_GENERATIONS;
+		size_t POPULATION_SIZE;
+		size_t MUTANT_POPULATION_SIZE;
+		size_t ELITE_SET_SIZE;
+		double INHER_PROB;
+		bool ADAPTIVE;
+		
+		brkga_params() {
+			NUM_GENERATIONS = 10;
+			POPULATION_SIZE = ELITE_SET_SIZE = 0;
+			MUTANT_POPULATION_SIZE = 0;
+			INHER_PROB = 0.5;
+			ADAPTIVE = false;
+		}
+		~brkga_params() { }
+};
+
+class portfolio_params {
+	public:
+		double TIME_BUDGET;
+		bool USE_TARGET;
+		double TARGET;
+		
+		portfolio_params() {
+			TIME_BUDGET = 0.0;
+			USE_TARGET = false;
+			TARGET = 0.0;
+		}
+		~portfolio_params() { }
+};
+
+// Parses the local search policy in argv[i].
+local_search_policy parse_policy(int argc, char *argv[], int i);
+
+void parse_local_search_params(int argc, char *argv[], local_search_params& ls_params);
+void parse_grasp_params(int argc, char *argv[], grasp_params& params);
+void parse_rkga_params(int argc, char *argv[], rkga_params& params);
+void parse_brkga_params(int argc, char *argv[], brkga_params& params);
+void parse_portfolio_params(int argc, char *argv[], portfolio_params& params);
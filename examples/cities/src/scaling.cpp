@@ -0,0 +1,288 @@
+/// C includes
+#include <string.h>
+
+/// C++ includes
+#include <functional>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <cmath>
+using namespace std;
+
+/// metaheuristics includes
+#include <metaheuristics/algorithms.hpp>
+#include <metaheuristics/structures.hpp>
+using namespace metaheuristics;
+using namespace structures;
+using namespace algorithms;
+using namespace random;
+
+/// Custom includes
+#include "generator.hpp"
+#include "solver.hpp"
+
+void print_usage() {
+	cout << "Locations, Cities, and Centres - scaling benchmark" << endl;
+	cout << "Times the routines of the solver and the algorithms on generated" << endl;
+	cout << "instances of increasing size and reports one line per routine and size." << endl;
+	cout << "Usage:" << endl;
+	cout << "    [-h, --help]:        shows this help" << endl;
+	cout << "    [--min-exp] e:       the smallest instance has 10^e cities. Default: 2" << endl;
+	cout << "    [--max-exp] e:       the largest instance has 10^e cities. Default: 5" << endl;
+	cout << "    [--steps] s:         sizes per power of 10. Default: 2" << endl;
+	cout << "    [--city-dist] d:     spatial distribution of the cities (see the generator). Default: uniform" << endl;
+	cout << "    [--budget] t:        a routine is not timed on larger instances once it needs" << endl;
+	cout << "                         more than t seconds. Default: 30" << endl;
+	cout << "    [--seed] s:          seed of the generator and of the algorithms. Default: 1" << endl;
+	cout << "    [-o, --output] f:    write the results into file f. Default: standard output" << endl;
+	cout << endl;
+	cout << "The output is in CSV format. Column 'slope' is the exponent k of the" << endl;
+	cout << "fit time ~ n^k between each size and the previous one." << endl;
+	cout << endl;
+}
+
+/* ******************************** */
+/* ROUTINES                         */
+/* ******************************** */
+
+// A routine receives the instance, already read, and the seed.
+// Returns the time, in seconds, of the part that is measured.
+typedef function<double (solver *, uint64_t)> routine;
+
+double time_greedy_construct(solver *s, uint64_t) {
+	const timing::time_point begin = timing::now();
+	s->greedy_construct();
+	return timing::elapsed_seconds(begin, timing::now());
+}
+
+double time_random_construct(solver *s, uint64_t seed) {
+	drandom_generator<> rng;
+	rng.seed_random_engine(seed);
+
+	const timing::time_point begin = timing::now();
+	s->random_construct(&rng, 0.3);
+	return timing::elapsed_seconds(begin, timing::now());
+}
+
+double time_decode(solver *s, uint64_t seed) {
+	const size_t n = s->get_n_cities();
+
+	crandom_generator<> rng;
+	rng.init_uniform(0, 1);
+	rng.seed_random_engine(seed);
+
+	chromosome<> c;
+	c.set_size(n);
+	c.init();
+	rng.make_n_uniform(&c[0], n);
+
+	const timing::time_point begin = timing::now();
+	s->decode(c);
+	return timing::elapsed_seconds(begin, timing::now());
+}
+
+double time_best_neighbour(solver *s, uint64_t) {
+	pair<problem<> *, double> neighbour;
+	neighbour.first = nullptr;
+	neighbour.second = s->greedy_construct();
+
+	const timing::time_point begin = timing::now();
+	s->best_neighbour(neighbour, Best_Improvement);
+	const double t = timing::elapsed_seconds(begin, timing::now());
+
+	delete neighbour.first;
+	return t;
+}
+
+double time_local_search(solver *s, uint64_t seed) {
+	const timing::time_point begin = timing::now();
+	local_search<default_random_engine, solver> ls(2, Best_Improvement);
+	ls.seed(seed);
+	double eval = s->greedy_construct();
+	ls.execute_algorithm(s, eval);
+	return timing::elapsed_seconds(begin, timing::now());
+}
+
+double time_grasp(solver *s, uint64_t seed) {
+	const timing::time_point begin = timing::now();
+	grasp<default_random_engine, solver> gs(1, 1, 0.3, Best_Improvement);
+	gs.seed(seed);
+	double eval;
+	gs.execute_algorithm(s, eval);
+	return timing::elapsed_seconds(begin, timing::now());
+}
+
+double time_rkga(solver *s, uint64_t seed) {
+	const timing::time_point begin = timing::now();
+	rkga<default_random_engine, solver> r(10, 2, 1, s->get_n_cities(), 0.7);
+	r.seed(seed);
+	double eval;
+	r.execute_algorithm(s, eval);
+	return timing::elapsed_seconds(begin, timing::now());
+}
+
+double time_brkga(solver *s, uint64_t seed) {
+	const timing::time_point begin = timing::now();
+	brkga<default_random_engine, solver> br(10, 2, 2, 1, s->get_n_cities(), 0.7);
+	br.seed(seed);
+	double eval;
+	br.execute_algorithm(s, eval);
+	return timing::elapsed_seconds(begin, timing::now());
+}
+
+int main(int argc, char *argv[]) {
+	/* ******************************** */
+	// ------- PARSE PARAMATERS ------- //
+	/* ******************************** */
+
+	int min_exp = 2;
+	int max_exp = 5;
+	int steps = 2;
+	double budget = 30.0;
+	generator_params params;
+	string output_filename;
+
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "-h") == 0 or strcmp(argv[i], "--help") == 0) {
+			print_usage();
+			return 0;
+		}
+		else if (strcmp(argv[i], "--min-exp") == 0) {
+			min_exp = atoi(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--max-exp") == 0) {
+			max_exp = atoi(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--steps") == 0) {
+			steps = atoi(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--city-dist") == 0) {
+			if (not parse_distribution(string(argv[i + 1]), params.CITY_DIST)) {
+				cerr << "Error: Unknown spatial distribution '" << argv[i + 1] << "'" << endl;
+				return 1;
+			}
+			++i;
+		}
+		else if (strcmp(argv[i], "--budget") == 0) {
+			budget = atof(argv[i + 1]);
+			++i;
+		}
+		else if (strcmp(argv[i], "--seed") == 0) {
+			params.SEED = strtoull(argv[i + 1], nullptr, 10);
+			++i;
+		}
+		else if (strcmp(argv[i], "-o") == 0 or strcmp(argv[i], "--output") == 0) {
+			output_filename = string(argv[i + 1]);
+			++i;
+		}
+	}
+
+	if (min_exp < 1 or max_exp < min_exp or steps < 1) {
+		cerr << "Error: Wrong range of sizes" << endl;
+		return 1;
+	}
+
+	ofstream fout;
+	if (not output_filename.empty()) {
+		fout.open(output_filename.c_str());
+		if (not fout.is_open()) {
+			cerr << "Error: Could not open output file " << output_filename << endl;
+			return 1;
+		}
+	}
+	ostream& os = (output_filename.empty() ? cout : fout);
+
+	const vector<pair<string, routine> > routines = {
+		{"greedy_construct", time_greedy_construct},
+		{"random_construct", time_random_construct},
+		{"decode", time_decode},
+		{"best_neighbour", time_best_neighbour},
+		{"local-search", time_local_search},
+		{"grasp", time_grasp},
+		{"rkga", time_rkga},
+		{"brkga", time_brkga}
+	};
+
+	/* ******************************** */
+	// ------- RUN THE BENCHMARK ------ //
+	/* ******************************** */
+
+	os << "routine,n_cities,n_locations,seconds,slope,feasible" << endl;
+
+	// the sizes are 10^(min_exp + k/steps)
+	vector<size_t> sizes;
+	for (int k = 0; k <= (max_exp - min_exp)*steps; ++k) {
+		sizes.push_back(size_t(round(pow(10.0, min_exp + double(k)/steps))));
+	}
+
+	// time and size of the previous measure of every routine (and of
+	// reading the instance), for the slope
+	vector<double> prev_time(routines.size() + 1, 0.0);
+	vector<size_t> prev_size(routines.size() + 1, 0);
+	vector<bool> over_budget(routines.size() + 1, false);
+
+	auto report =
+	[&](size_t r, const string& name, size_t n, size_t n_locations, double t, bool feasible) {
+		os << name << "," << n << "," << n_locations << "," << t << ",";
+		if (prev_size[r] > 0 and prev_time[r] > 0.0 and t > 0.0) {
+			os << log(t/prev_time[r])/log(double(n)/prev_size[r]);
+		}
+		os << "," << (feasible ? 1 : 0) << endl;
+
+		prev_time[r] = t;
+		prev_size[r] = n;
+		over_budget[r] = (t > budget);
+	};
+
+	for (size_t n : sizes) {
+		params.N_CITIES = n;
+		stringstream instance;
+		generate_instance(params, instance);
+		const string text = instance.str();
+		const size_t n_locations = n + n/4;
+
+		// reading the instance
+		const size_t READ = routines.size();
+		if (over_budget[READ]) {
+			break;
+		}
+		{
+			istringstream in(text);
+			solver s;
+			const timing::time_point begin = timing::now();
+			s.read_from_file(in);
+			report(READ, "read_from_file", n, n_locations,
+				   timing::elapsed_seconds(begin, timing::now()), true);
+		}
+
+		for (size_t r = 0; r < routines.size(); ++r) {
+			if (over_budget[r]) {
+				continue;
+			}
+
+			istringstream in(text);
+			solver *s = new solver();
+			s->read_from_file(in);
+
+			double t = 0.0;
+			bool feasible = true;
+			const timing::time_point begin = timing::now();
+			try {
+				t = routines[r].second(s, params.SEED);
+			}
+			catch (const infeasible_exception& e) {
+				// the routine did not finish: report the time until
+				// the exception was thrown
+				t = timing::elapsed_seconds(begin, timing::now());
+				feasible = false;
+			}
+			report(r, routines[r].first, n, n_locations, t, feasible);
+
+			delete s;
+		}
+	}
+}
@@ -15,7 +15,7 @@ using namespace random;
 // Custom includes
 #include "interface.hpp"
 
-class solver : public interface {
+class solver final : public interface {
 	public:
 		solver() = default;
 		~solver() = default;
@@ -39,8 +39,12 @@ class solver : public interface {
 		double random_construct(drandom_generator<> *rng, double alpha) noexcept(false);
 		
 		// Constructs a solution from a given chromosome.
-		// Returns the evaluation of the solution.
-		double decode(const chromosome& c) noexcept(false);
+		// Returns the evaluation of the solution. The genes of the
+		// compact chromosomes are only compared, so they are decoded
+		// without converting the chromosome first.
+		double decode(const chromosome<>& c) noexcept(false);
+		double decode(const chromosome<float>& c) noexcept(false);
+		double decode(const chromosome<fixed16>& c) noexcept(false);
 		
 		// Explores this solution's neighbourhood and stores:
 		// - the best neighbour if BI is true (best improvement)
@@ -63,6 +67,12 @@ class solver : public interface {
 		
 	private:
 
+		/* DECODER */
+
+		// Constructs a solution assigning the cities in the order given
+		// by the second component of the pairs in 'vc'.
+		double decode_sorted(const vector<pair<double, int> >& vc) noexcept(false);
+
 		/* GREEDY CONSTRUCTOR */
 
 		typedef pair<int, interface::role> location_role;
@@ -77,6 +87,43 @@ class solver : public interface {
 		)
 		const;
 
+		// Candidate stored in the priority queues of the greedy
+		// constructors. The queues are updated lazily: the capacity used
+		// at every location has a version, and a candidate evaluated with
+		// an older version, or that can no longer be assigned, is
+		// discarded when it reaches the top of its queue.
+		struct queued_candidate {
+			double cost, dist;
+			int city_idx, loc_idx;
+			role r;
+			int version;
+
+			// Order in which the candidates were chosen when all of them
+			// were evaluated: by cost, then by distance, then by city,
+			// location and role.
+			bool operator> (const queued_candidate& q) const;
+		};
+		typedef priority_queue<queued_candidate, vector<queued_candidate>, greater<queued_candidate> > candidate_queue;
+
+		// Pushes into 'Q' the candidates of city 'city_idx' at location
+		// 'loc_idx' that can still be assigned, evaluated with the current
+		// capacity of the location, whose version is 'version'.
+		void push_candidates
+		(
+			int city_idx, int loc_idx, int version,
+			const vector<char>& blocked, candidate_queue& Q
+		)
+		const;
+
+		// Pops from 'Q' the candidates that are outdated or can no longer
+		// be assigned. Returns false if 'Q' becomes empty.
+		bool clean_top
+		(
+			const vector<char>& blocked, const vector<int>& loc_version,
+			candidate_queue& Q
+		)
+		const;
+
 		// Auxiliar function: returns whether there is at least one centre type
 		// available for location 'loc_idx' that can serve the cities already
 		// being served plus city 'city_idx'.
@@ -99,14 +146,12 @@ class solver : public interface {
 		// That is, are there other locations with a centre installed
 		// in them, other than 'loc_idx' to serve the cities in
 		// 'cities_served' ** with the same role ** ?
-		// Store these new locations in 'what_locs'.
-		// Remember:
-		//   what_locs[c] = -> invalid location index if cities_served[c] = 0
-		//                  -> valid location index if otherwise
+		// Store these new locations in 'what_locs':
+		//   what_locs[i] = location that serves city cities_served[i].first
 		bool can_remove_centre
 		(
 			int loc_idx,
-			const vector<role>& cities_served, vector<int>& what_locs
+			const vector<pair<int, role> >& cities_served, vector<int>& what_locs
 		)
 		const;
 
@@ -114,7 +159,7 @@ class solver : public interface {
 		// structures. The new solution is stored in 'neigh'.
 		void delete_centre
 		(
-			int loc_idx, const vector<role>& cities_served,
+			int loc_idx, const vector<pair<int, role> >& cities_served,
 			const vector<int>& new_locations, problem **neigh
 		)
 		const;
@@ -127,5 +172,21 @@ class solver : public interface {
 		// Replaces the centre from location 'l' and updates all data
 		// structures. The new solution is stored in 'neigh'.
 		void replace_centre(int loc_idx, int centre_idx, problem **neigh) const;
+
+		// Buffers of can_remove_centre, kept between calls so that they
+		// are not allocated for every location:
+		// - the cities served sorted by the capacity they add
+		// - the capacity occupied at the locations that receive cities,
+		//   valid only where 'scratch_touched' is not 0
+		// - the locations that received cities in the current call
+		mutable vector<pair<double, int> > scratch_sorted_cities;
+		mutable vector<double> scratch_cap;
+		mutable vector<char> scratch_touched;
+		mutable vector<int> scratch_touched_locs;
+
+		// Buffers of best_neighbour: the cities served by a location and
+		// the locations that would serve them if its centre was removed.
+		vector<pair<int, role> > scratch_cities_served;
+		vector<int> scratch_new_locations;
 };
 
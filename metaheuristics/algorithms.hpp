@@ -24,8 +24,10 @@
 #pragma once
 
 #include <metaheuristics/algorithms/metaheuristic.hpp>
+#include <metaheuristics/algorithms/observer.hpp>
 #include <metaheuristics/algorithms/genetic_algorithms/genetic_algorithm.hpp>
 #include <metaheuristics/algorithms/genetic_algorithms/brkga.hpp>
 #include <metaheuristics/algorithms/genetic_algorithms/rkga.hpp>
 #include <metaheuristics/algorithms/local_search/local_search.hpp>
 #include <metaheuristics/algorithms/grasp/grasp.hpp>
+#include <metaheuristics/algorithms/portfolio/portfolio.hpp>
@@ -26,6 +26,8 @@
 #include <metaheuristics/algorithms/genetic_algorithms/brkga.hpp>
 
 // C++ includes
+#include <algorithm>
+#include <cassert>
 #include <queue>
 
 #if defined (GENETICS_VERBOSE)
@@ -42,58 +44,120 @@ namespace algorithms {
 
 // PUBLIC
 
-template<class G>
-brkga<G>::brkga() : genetic_algorithm<G>() {
-	N_ELITE = 0;
+template<class G, class P, typename T>
+brkga<G,P,T>::brkga() : genetic_algorithm<G,T>() {
+	N_ELITE = init_N_ELITE = 0;
 }
 
-template<class G>
-brkga<G>::brkga
+template<class G, class P, typename T>
+brkga<G,P,T>::brkga
 (
 	size_t ps, size_t mps, size_t ess, size_t n_gen,
 	size_t c_size, double in_p
 )
-: genetic_algorithm<G>(ps, mps, n_gen, c_size, in_p)
+: genetic_algorithm<G,T>(ps, mps, n_gen, c_size, in_p)
 {
-	N_ELITE = ess;
+	N_ELITE = init_N_ELITE = ess;
+	init_N_MUTANT = mps;
+	init_in_prob = in_p;
 }
 
-template<class G>
-brkga<G>::~brkga() { }
+template<class G, class P, typename T>
+brkga<G,P,T>::~brkga() { }
 
-template<class G>
-void brkga<G>::reset_algorithm() {
-	GA<G>::reset_genetic_algorithm();
+template<class G, class P, typename T>
+void brkga<G,P,T>::reset_algorithm() {
+	GA<G,T>::reset_genetic_algorithm();
 
 	elite_copying_time = 0.0;
 }
 
-template<class G>
-const structures::individual& brkga<G>::get_best_individual() const {
-	return GA<G>::population[ elite_set[0].second ];
+template<class G, class P, typename T>
+void brkga<G,P,T>::set_adaptive_parameters(bool a) {
+	adaptive = a;
+	if (adaptive) {
+		GA<G,T>::set_diversity_tracking(true);
+	}
+}
+
+template<class G, class P, typename T>
+void brkga<G,P,T>::set_adaptive_bounds(
+	size_t min_e, size_t max_e,
+	size_t min_m, size_t max_m,
+	double min_p, double max_p
+)
+{
+	assert(0 < min_e and min_e <= max_e);
+	assert(min_m <= max_m);
+	assert(min_p <= max_p);
+
+	min_elite = min_e;
+	max_elite = max_e;
+	min_mutant = min_m;
+	max_mutant = max_m;
+	min_in_prob = min_p;
+	max_in_prob = max_p;
+	adaptive_bounds_set = true;
+}
+
+template<class G, class P, typename T>
+void brkga<G,P,T>::set_adaptive_window(size_t w) {
+	adaptive_window = w;
 }
 
-template<class G>
-bool brkga<G>::execute_algorithm(structures::problem<G> *best, double& current_best_f) {
+template<class G, class P, typename T>
+const structures::individual<T>& brkga<G,P,T>::get_best_individual() const {
+	return GA<G,T>::population[ elite_set[0].second ];
+}
+
+template<class G, class P, typename T>
+size_t brkga<G,P,T>::get_elite_size() const {
+	return N_ELITE;
+}
+
+template<class G, class P, typename T>
+size_t brkga<G,P,T>::get_mutant_size() const {
+	return GA<G,T>::N_MUTANT;
+}
+
+template<class G, class P, typename T>
+double brkga<G,P,T>::get_inheritance_probability() const {
+	return GA<G,T>::in_prob;
+}
+
+template<class G, class P, typename T>
+bool brkga<G,P,T>::execute_algorithm(structures::problem<G> *best, double& current_best_f) {
+	// the solutions are decoded as instances of P
+	assert(dynamic_cast<P *>(best) != nullptr);
+	
+	init_adaptive_parameters();
+	
 	if (not are_set_sizes_correct()) {
 		std::cerr << MH_ERROR << std::endl;
 		std::cerr << "    Sizes chosen will lead to errors:" << std::endl;
 		std::cerr << "    NUMBER OF MUTANTS + NUMBER OF ELITE >= POPULATION SIZE" << std::endl;
-		std::cerr << "    " << GA<G>::N_MUTANT + N_ELITE << " >= "
-				  << GA<G>::pop_size << std::endl;
+		std::cerr << "    " << GA<G,T>::N_MUTANT + N_ELITE << " >= "
+				  << GA<G,T>::pop_size << std::endl;
 		return false;
 	}
 	
+	// wall time of the execution, for the metrics
+	profiling::metrics::scope wall(META<G>::stats);
+	
+	// the solutions decoded are recycled through the pool
+	META<G>::prepare_solutions();
+	
 	// initialise random number generators
-	GA<G>::initialise_generators();
+	GA<G,T>::initialise_generators();
 	elite_rng.init_uniform(0, N_ELITE - 1);
-	if (META<G>::seed_rng) {
-		elite_rng.seed_random_engine();
-	}
+	META<G>::seed_generator(elite_rng, 2);
 	// set algorithm to its initial state
 	reset_algorithm();
 	
-	#if defined (GENETICS_DEBUG)
+	// generation from which the execution starts
+	size_t first_gen = 1;
+	
+	#if defined (GENETICS_VERBOSE)
 	// verbose variables
 	double prev_best_fit;
 	double best_fit;
@@ -103,23 +167,41 @@ bool brkga<G>::execute_algorithm(structures::problem<G> *best, double& current_b
 	timing::time_point bbegin, bend, send, begin, end;
 	
 	#if defined (GENETICS_DEBUG)
-	std::cout << "BRKGA - Generating initial population (" << GA<G>::pop_size << ")" << std::endl;
-	#endif
-	
-	begin = timing::now();
-	GA<G>::initialize_population(best);
-	end = timing::now();
-	GA<G>::initial_time += timing::elapsed_seconds(begin, end);
-	
-	#if defined (GENETICS_DEBUG)
-	std::cout << "BRKGA - Initializing elite set (" << N_ELITE << ")" << std::endl;
+	std::cout << "BRKGA - Generating initial population (" << GA<G,T>::pop_size << ")" << std::endl;
 	#endif
 	
-	elite_set.resize(N_ELITE);
-	track_elite_individuals();
+	if (not META<G>::resume_file.empty()) {
+		if (not GA<G,T>::load_checkpoint(first_gen)) {
+			return false;
+		}
+		++first_gen;
+	}
+	else {
+		begin = timing::now();
+		GA<G,T>::initialize_population(best);
+		end = timing::now();
+		GA<G,T>::initial_time += timing::elapsed_seconds(begin, end);
+		META<G>::record_latency(
+			profiling::metrics::phase::initial_population,
+			timing::elapsed_seconds(begin, end)
+		);
+		
+		#if defined (GENETICS_DEBUG)
+		std::cout << "BRKGA - Initializing elite set (" << N_ELITE << ")" << std::endl;
+		#endif
+		
+		elite_set.resize(N_ELITE);
+		track_elite_individuals();
+		
+		if (adaptive) {
+			adaptive_best = elite_set[0].first;
+			initial_diversity = GA<G,T>::diversity.get_mean_gene_deviation();
+			n_stalled = 0;
+		}
+	}
 	
 	#if defined (GENETICS_DEBUG)
-	GA<G>::print_current_population();
+	GA<G,T>::print_current_population();
 	print_elite_set();
 	#endif
 	
@@ -128,28 +210,31 @@ bool brkga<G>::execute_algorithm(structures::problem<G> *best, double& current_b
 		<< setw(8)  << " "
 		<< setw(18) << "Elaps. Time (s)"
 		<< setw(18) << "Obj. Function"
-		<< setw(12) << "Gen./" << GA<G>::N_GEN
+		<< setw(12) << "Gen./" << GA<G,T>::N_GEN
 		<< std::endl;
 
-	best_fit = GA<G>::get_best_individual().get_fitness();
+	best_fit = GA<G,T>::get_best_individual().get_fitness();
 	prev_best_fit = best_fit;
 
 	std::cout
 		<< setw(8)  << "**"
-		<< setw(18) << GA<G>::initial_time
+		<< setw(18) << GA<G,T>::initial_time
 		<< setw(18) << best_fit
 		<< setw(12) << 0
 		<< std::endl;
 	#endif
 	
-	population_set next_gen(GA<G>::pop_size, GA<G>::chrom_size);
+	population_set<T> next_gen(GA<G,T>::pop_size, GA<G,T>::chrom_size);
+	
+	// the observer may stop the execution at the end of any generation
+	bool stop = META<G>::obs != nullptr and not GA<G,T>::notify_generation(first_gen - 1);
 	
 	bbegin = timing::now();
-	for (size_t g = 1; g <= GA<G>::N_GEN; ++g) {
+	for (size_t g = first_gen; g <= GA<G,T>::N_GEN and not stop; ++g) {
 		
 		#if defined (GENETICS_DEBUG)
 		std::cout << "BRKGA - Generating " << g << "-th generation" << std::endl;
-		GA<G>::print_current_population();
+		GA<G,T>::print_current_population();
 		print_elite_set();
 		std::cout << "    * Copying elite individuals..." << std::endl;
 		#endif
@@ -159,7 +244,9 @@ bool brkga<G>::execute_algorithm(structures::problem<G> *best, double& current_b
 		begin = timing::now();
 		copy_elite_individuals(best, next_gen, m);
 		end = timing::now();
-		elite_copying_time += timing::elapsed_seconds(begin, end);
+		const double te = timing::elapsed_seconds(begin, end);
+		elite_copying_time += te;
+		META<G>::record_latency(profiling::metrics::phase::elite_copy, te);
 		
 		#if defined (GENETICS_DEBUG)
 		std::cout << std::endl;
@@ -167,9 +254,11 @@ bool brkga<G>::execute_algorithm(structures::problem<G> *best, double& current_b
 		#endif
 		
 		begin = timing::now();
-		GA<G>::generate_mutants(best, m, N_ELITE + GA<G>::N_MUTANT, next_gen, m);
+		GA<G,T>::generate_mutants(best, m, N_ELITE + GA<G,T>::N_MUTANT, next_gen, m);
 		end = timing::now();
-		GA<G>::mutant_time += timing::elapsed_seconds(begin, end);
+		const double tm = timing::elapsed_seconds(begin, end);
+		GA<G,T>::mutant_time += tm;
+		META<G>::record_latency(profiling::metrics::phase::mutants, tm);
 		
 		#if defined (GENETICS_DEBUG)
 		std::cout << std::endl;
@@ -177,18 +266,35 @@ bool brkga<G>::execute_algorithm(structures::problem<G> *best, double& current_b
 		#endif
 		
 		begin = timing::now();
-		GA<G>::generate_crossovers(best, next_gen, m);
+		GA<G,T>::generate_crossovers(best, next_gen, m);
 		end = timing::now();
-		GA<G>::crossover_time += timing::elapsed_seconds(begin, end);
+		const double tc = timing::elapsed_seconds(begin, end);
+		GA<G,T>::crossover_time += tc;
+		META<G>::record_latency(profiling::metrics::phase::crossover, tc);
 		
 		#if defined (GENETICS_DEBUG)
 		std::cout << std::endl;
 		std::cout << "    * Swapping generations..." << std::endl;
 		#endif
 		
-		GA<G>::population = next_gen;
+		GA<G,T>::population = next_gen;
+		GA<G,T>::update_diversity();
+		if (adaptive) {
+			adapt_parameters();
+		}
 		track_elite_individuals();
 		
+		META<G>::record(profiling::metrics::counter::generations);
+		META<G>::record_latency(profiling::metrics::phase::generation, te + tm + tc);
+		
+		if (META<G>::checkpoint_due(g)) {
+			GA<G,T>::save_checkpoint(g, bbegin);
+		}
+		
+		if (META<G>::obs != nullptr) {
+			stop = not GA<G,T>::notify_generation(g);
+		}
+		
 		send = timing::now();
 		
 		#if defined (GENETICS_DEBUG)
@@ -196,8 +302,8 @@ bool brkga<G>::execute_algorithm(structures::problem<G> *best, double& current_b
 		#endif
 		
 		#if defined (GENETICS_VERBOSE)
-		best_fit = GA<G>::get_best_individual().get_fitness();
-		double etime = timing::elapsed_seconds(bbegin, send) + GA<G>::initial_time;
+		best_fit = GA<G,T>::get_best_individual().get_fitness();
+		double etime = timing::elapsed_seconds(bbegin, send) + GA<G,T>::initial_time;
 
 		if (best_fit > prev_best_fit) {
 			prev_best_fit = best_fit;
@@ -216,36 +322,40 @@ bool brkga<G>::execute_algorithm(structures::problem<G> *best, double& current_b
 		#endif
 	}
 	bend = timing::now();
-	GA<G>::total_time += timing::elapsed_seconds(bbegin, bend);
+	GA<G,T>::total_time += timing::elapsed_seconds(bbegin, bend);
+	
+	if (not META<G>::finish_checkpoints()) {
+		return false;
+	}
 	
 	#if defined (GENETICS_VERBOSE)
-	std::cout << "Generated all generations in " << GA<G>::total_time << " s" << std::endl;
+	std::cout << "Generated all generations in " << GA<G,T>::total_time << " s" << std::endl;
 	#endif
 	
-	const structures::individual& fittest_individual = GA<G>::get_best_individual();
-	current_best_f = best->decode(fittest_individual.get_chromosome());
+	const structures::individual<T>& fittest_individual = GA<G,T>::get_best_individual();
+	current_best_f = static_cast<P *>(best)->decode(fittest_individual.get_chromosome());
 	
 	return true;
 }
 
-template<class G>
-void brkga<G>::print_performance() const {
+template<class G, class P, typename T>
+void brkga<G,P,T>::print_performance() const {
 	std::cout << "BRKGA algorithm performance:" << std::endl;
-	std::cout << "    Total generation time:             " << GA<G>::total_time << " s" << std::endl;
-	std::cout << "    Average generation average:        " << GA<G>::total_time/static_cast<double>(GA<G>::N_GEN) << " s" << std::endl;
+	std::cout << "    Total generation time:             " << GA<G,T>::total_time << " s" << std::endl;
+	std::cout << "    Average generation average:        " << GA<G,T>::total_time/static_cast<double>(GA<G,T>::N_GEN) << " s" << std::endl;
 	std::cout << "    Total copying elite time:          " << elite_copying_time << " s" << std::endl;
-	std::cout << "    Average copying elite time:        " << elite_copying_time/static_cast<double>(GA<G>::N_GEN) << " s" << std::endl;
-	std::cout << "    Total mutant generation time:      " << GA<G>::mutant_time << " s" << std::endl;
-	std::cout << "    Average mutant generation time:    " << GA<G>::mutant_time/static_cast<double>(GA<G>::N_GEN) << " s" << std::endl;
-	std::cout << "    Total crossover generation time:   " << GA<G>::crossover_time << " s" << std::endl;
-	std::cout << "    Average crossover generation time: " << GA<G>::crossover_time/static_cast<double>(GA<G>::N_GEN) << " s" << std::endl;
+	std::cout << "    Average copying elite time:        " << elite_copying_time/static_cast<double>(GA<G,T>::N_GEN) << " s" << std::endl;
+	std::cout << "    Total mutant generation time:      " << GA<G,T>::mutant_time << " s" << std::endl;
+	std::cout << "    Average mutant generation time:    " << GA<G,T>::mutant_time/static_cast<double>(GA<G,T>::N_GEN) << " s" << std::endl;
+	std::cout << "    Total crossover generation time:   " << GA<G,T>::crossover_time << " s" << std::endl;
+	std::cout << "    Average crossover generation time: " << GA<G,T>::crossover_time/static_cast<double>(GA<G,T>::N_GEN) << " s" << std::endl;
 	std::cout << std::endl;
 }
 
 // Information display functions
 
-template<class G>
-void brkga<G>::print_elite_set() const {
+template<class G, class P, typename T>
+void brkga<G,P,T>::print_elite_set() const {
 	for (size_t it = 0; it < N_ELITE; ++it) {
 		std::cout << "        elite idx= " << elite_set[it].second << std::endl;
 	}
@@ -254,34 +364,44 @@ void brkga<G>::print_elite_set() const {
 
 // Population-generation functions
 
-template<class G>
-void brkga<G>::get_two_parents(size_t& p1, size_t& p2) {
+template<class G, class P, typename T>
+void brkga<G,P,T>::evaluate_individuals(
+	const structures::problem<G> *p, population_set<T>& set, size_t A, size_t B
+)
+const
+{
+	GA<G,T>::template evaluate_range<P>(p, set, A, B);
+}
+
+
+template<class G, class P, typename T>
+void brkga<G,P,T>::get_two_parents(size_t& p1, size_t& p2) {
 	size_t idx1 = elite_rng.get_uniform();
 	p1 = elite_set[idx1].second;
 
-	p2 = GA<G>::population_rng.get_uniform();
+	p2 = GA<G,T>::population_rng.get_uniform();
 	while (p2 == p1 or is_elite_individual(p2)) {
-		p2 = GA<G>::population_rng.get_uniform();
+		p2 = GA<G,T>::population_rng.get_uniform();
 	}
 }
 
-template<class G>
-void brkga<G>::copy_elite_individuals(
+template<class G, class P, typename T>
+void brkga<G,P,T>::copy_elite_individuals(
 	const structures::problem<G> *,
-	population_set& next_gen, size_t& m
+	population_set<T>& next_gen, size_t& m
 )
 {
-	assert(m < (GA<G>::pop_size) );
+	assert(m < (GA<G,T>::pop_size) );
 
 	for (size_t it = 0; it < N_ELITE; ++it) {
-		next_gen[m + it] = GA<G>::population[ elite_set[it].second ];
+		next_gen[m + it] = GA<G,T>::population[ elite_set[it].second ];
 	}
 	m += N_ELITE;
 }
 
-template<class G>
-bool brkga<G>::is_elite_individual(size_t idx) const {
-	assert(idx < (GA<G>::pop_size) );
+template<class G, class P, typename T>
+bool brkga<G,P,T>::is_elite_individual(size_t idx) const {
+	assert(idx < (GA<G,T>::pop_size) );
 
 	size_t it = 0;
 	while (it < N_ELITE) {
@@ -294,14 +414,14 @@ bool brkga<G>::is_elite_individual(size_t idx) const {
 	return false;
 }
 
-template<class G>
-void brkga<G>::track_elite_individuals() {
+template<class G, class P, typename T>
+void brkga<G,P,T>::track_elite_individuals() {
 	// sort individuals by their fitness
 	std::priority_queue<std::pair<double, size_t> > fitness_individual;
-	for (size_t i = 0; i < GA<G>::pop_size; ++i) {
+	for (size_t i = 0; i < GA<G,T>::pop_size; ++i) {
 		fitness_individual.push(
 			std::pair<double, size_t>(
-				GA<G>::population[i].get_fitness(),
+				GA<G,T>::population[i].get_fitness(),
 				i
 			)
 		);
@@ -314,12 +434,148 @@ void brkga<G>::track_elite_individuals() {
 	}
 }
 
+// Adaptive parameters
+
+template<class G, class P, typename T>
+void brkga<G,P,T>::init_adaptive_parameters() {
+	N_ELITE = init_N_ELITE;
+	GA<G,T>::N_MUTANT = init_N_MUTANT;
+	GA<G,T>::in_prob = init_in_prob;
+	
+	if (not adaptive) {
+		return;
+	}
+	
+	const size_t ps = GA<G,T>::pop_size;
+	if (not adaptive_bounds_set) {
+		min_elite = std::max<size_t>(1, ps/10);
+		max_elite = std::max(min_elite, ps/4);
+		min_mutant = ps/20;
+		max_mutant = std::max(min_mutant, (3*ps)/10);
+		min_in_prob = 0.5;
+		max_in_prob = 0.8;
+	}
+	
+	N_ELITE = std::min(std::max(N_ELITE, min_elite), max_elite);
+	GA<G,T>::N_MUTANT = std::min(std::max(GA<G,T>::N_MUTANT, min_mutant), max_mutant);
+	GA<G,T>::in_prob = std::min(std::max(GA<G,T>::in_prob, min_in_prob), max_in_prob);
+}
+
+template<class G, class P, typename T>
+void brkga<G,P,T>::adapt_parameters() {
+	const size_t old_N_ELITE = N_ELITE;
+	
+	// the elite set is not up to date yet: use the population directly
+	const double best_f = genetic_algorithm<G,T>::get_best_individual().get_fitness();
+	
+	if (best_f > adaptive_best) {
+		// improvement: intensify the search
+		adaptive_best = best_f;
+		n_stalled = 0;
+		
+		if (N_ELITE < max_elite) {
+			++N_ELITE;
+		}
+		if (GA<G,T>::N_MUTANT > min_mutant) {
+			--GA<G,T>::N_MUTANT;
+		}
+		GA<G,T>::in_prob = std::min(max_in_prob, GA<G,T>::in_prob + adaptive_prob_step);
+	}
+	else {
+		++n_stalled;
+		
+		const double div = GA<G,T>::diversity.get_mean_gene_deviation();
+		const bool converged = div < adaptive_diversity_ratio*initial_diversity;
+		
+		if (n_stalled >= adaptive_window or converged) {
+			// stagnation: diversify the search
+			n_stalled = 0;
+			
+			const size_t de = std::max<size_t>(1, (max_elite - min_elite)/4);
+			const size_t dm = std::max<size_t>(1, (max_mutant - min_mutant)/4);
+			
+			N_ELITE = (N_ELITE > min_elite + de ? N_ELITE - de : min_elite);
+			GA<G,T>::N_MUTANT = std::min(max_mutant, GA<G,T>::N_MUTANT + dm);
+			GA<G,T>::in_prob = std::max(min_in_prob, GA<G,T>::in_prob - adaptive_prob_step);
+		}
+	}
+	
+	// there must be at least one crossover individual
+	while (N_ELITE + GA<G,T>::N_MUTANT >= GA<G,T>::pop_size and GA<G,T>::N_MUTANT > 0) {
+		--GA<G,T>::N_MUTANT;
+	}
+	while (N_ELITE + GA<G,T>::N_MUTANT >= GA<G,T>::pop_size and N_ELITE > 1) {
+		--N_ELITE;
+	}
+	
+	if (N_ELITE != old_N_ELITE) {
+		elite_set.resize(N_ELITE);
+		elite_rng.init_uniform(0, N_ELITE - 1);
+	}
+}
+
+// Checkpoints
+
+template<class G, class P, typename T>
+checkpointing::algorithm_tag brkga<G,P,T>::get_checkpoint_tag() const {
+	return checkpointing::algorithm_tag::brkga;
+}
+
+template<class G, class P, typename T>
+void brkga<G,P,T>::write_state(std::ostream& os) const {
+	GA<G,T>::write_state(os);
+	
+	checkpointing::write_value(os, elite_copying_time);
+	elite_rng.write_state(os);
+	
+	checkpointing::write_value(os, N_ELITE);
+	for (size_t it = 0; it < N_ELITE; ++it) {
+		checkpointing::write_value(os, elite_set[it].first);
+		checkpointing::write_value(os, elite_set[it].second);
+	}
+	
+	checkpointing::write_value(os, n_stalled);
+	checkpointing::write_value(os, adaptive_best);
+	checkpointing::write_value(os, initial_diversity);
+}
+
+template<class G, class P, typename T>
+bool brkga<G,P,T>::read_state(std::istream& is) {
+	if (not GA<G,T>::read_state(is)) {
+		return false;
+	}
+	
+	bool ok =
+		checkpointing::read_value(is, elite_copying_time) and
+		elite_rng.read_state(is) and
+		checkpointing::read_value(is, N_ELITE);
+	
+	// GA<G,T>::read_state guarantees that N_MUTANT < pop_size
+	if (not ok or N_ELITE == 0 or N_ELITE >= GA<G,T>::pop_size - GA<G,T>::N_MUTANT) {
+		return false;
+	}
+	
+	elite_set.resize(N_ELITE);
+	for (size_t it = 0; it < N_ELITE; ++it) {
+		if (not checkpointing::read_value(is, elite_set[it].first) or
+			not checkpointing::read_value(is, elite_set[it].second) or
+			elite_set[it].second >= GA<G,T>::pop_size)
+		{
+			return false;
+		}
+	}
+	return
+		checkpointing::read_value(is, n_stalled) and
+		checkpointing::read_value(is, adaptive_best) and
+		checkpointing::read_value(is, initial_diversity);
+}
+
 // Sanity check
 
-template<class G>
-bool brkga<G>::are_set_sizes_correct() const {
+template<class G, class P, typename T>
+bool brkga<G,P,T>::are_set_sizes_correct() const {
 	// there must be at least one crossover individual
-	return N_ELITE + GA<G>::N_MUTANT < GA<G>::pop_size;
+	return N_ELITE + GA<G,T>::N_MUTANT < GA<G,T>::pop_size;
 }
 
 } // -- namespace algorithms
@@ -73,20 +73,56 @@ namespace algorithms {
  * (range [ @ref N_ELITE + @ref genetic_algorithm::N_MUTANT, @ref genetic_algorithm::pop_size)),
  * are crossover individuals.
  * 
+ * The sizes @ref N_ELITE, @ref genetic_algorithm::N_MUTANT and the
+ * probability @ref genetic_algorithm::in_prob can be adapted during the
+ * execution (see @ref set_adaptive_parameters). In this mode, after every
+ * generation:
+ * - if the best fitness improved, the search is intensified: one more
+ * elite individual, one less mutant, and the inheritance probability
+ * is increased by @ref adaptive_prob_step.
+ * - if the best fitness has not improved for @ref adaptive_window
+ * generations, or the diversity of the population (see
+ * @ref population_diversity::get_mean_gene_deviation) dropped below
+ * @ref adaptive_diversity_ratio times its initial value, the search is
+ * diversified: the elite set shrinks, the mutant set grows (both by a
+ * quarter of their allowed ranges) and the inheritance probability
+ * is decreased by @ref adaptive_prob_step.
+ * 
+ * All values are kept within their bounds (see @ref set_adaptive_bounds)
+ * and so that at least one crossover individual is generated. This is
+ * a simplified form of the self-adapting schemes of
+ \verbatim
+ The multi-parent biased random-key genetic algorithm with implicit
+ path-relinking and its real-world applications
+ Andrade, Carlos E. and Toso, Rodrigo F. and Gonçalves, José F. and Resende, Mauricio G. C.
+ 2021, European Journal of Operational Research, Volume 289, Number 1
+ \endverbatim
+ * 
  * This algorithm needs the implementation of the following methods:
  * - @ref problem::clone
+ * - @ref problem::copy
+ * - @ref problem::clear
  * - @ref problem::decode
  * 
  * See @ref genetic_algorithm for information on compilation flags.
  * 
  * @param G The type of the engine of the random generator (see metaheuristics::drng).
+ * @param P The class of the solutions of the problem. The default, the
+ * interface @ref structures::problem, decodes the chromosomes through the
+ * virtual methods. If @e P is the (final) class implementing the problem,
+ * the compiler can call, and inline, its @ref problem::decode directly.
+ * The instances given to @ref execute_algorithm must be of class @e P.
+ * @param T The type of the genes of the chromosomes (see
+ * @ref genetic_algorithm).
  * @param size_t Type of the numbers generated by the discrete random generator (see metaheuristics::drng).
  * @param double Type of the numbers generated by the continuous random generator (see metaheuristics::crng).
  */
 template<
-	class G = std::default_random_engine
+	class G = std::default_random_engine,
+	class P = structures::problem<G>,
+	typename T = double
 >
-class brkga : public genetic_algorithm<G> {
+class brkga : public genetic_algorithm<G,T> {
 	public:
 		/// Constructor.
 		brkga();
@@ -119,12 +155,55 @@ class brkga : public genetic_algorithm<G> {
 		 */
 		void reset_algorithm();
 		
+		/**
+		 * @brief Enables or disables the adaptive control of the parameters.
+		 * 
+		 * Enabling it also enables the tracking of the population's
+		 * diversity (see @ref genetic_algorithm::set_diversity_tracking).
+		 * Disabled by default.
+		 */
+		void set_adaptive_parameters(bool a);
+		/**
+		 * @brief Sets the bounds of the adapted parameters.
+		 * 
+		 * If not set, the bounds are those recommended in the literature:
+		 * [10%, 25%] of the population for the elite set, [5%, 30%] for
+		 * the mutant set, and [0.5, 0.8] for the inheritance probability.
+		 * The values given in the constructor are used as initial values,
+		 * clamped to these bounds.
+		 * @param min_e Minimum size of the elite set (at least 1).
+		 * @param max_e Maximum size of the elite set.
+		 * @param min_m Minimum size of the mutant set.
+		 * @param max_m Maximum size of the mutant set.
+		 * @param min_p Minimum inheritance probability.
+		 * @param max_p Maximum inheritance probability.
+		 */
+		void set_adaptive_bounds(
+			size_t min_e, size_t max_e,
+			size_t min_m, size_t max_m,
+			double min_p, double max_p
+		);
+		/**
+		 * @brief Sets the number of generations without improvement
+		 * before diversifying.
+		 * 
+		 * Sets the value of @ref adaptive_window to @e w.
+		 */
+		void set_adaptive_window(size_t w);
+		
 		/**
 		 * @brief Returns the individual with the highest fitness.
 		 * 
 		 * This individual is retrieved from @ref elite_set.
 		 */
-		const structures::individual& get_best_individual() const;
+		const structures::individual<T>& get_best_individual() const;
+		
+		/// Returns the current size of the elite set (see @ref N_ELITE).
+		size_t get_elite_size() const;
+		/// Returns the current size of the mutant set (see @ref genetic_algorithm::N_MUTANT).
+		size_t get_mutant_size() const;
+		/// Returns the current inheritance probability (see @ref genetic_algorithm::in_prob).
+		double get_inheritance_probability() const;
 		
 		/**
 		 * @brief Executes the BRKGA algorithm.
@@ -174,8 +253,54 @@ class brkga : public genetic_algorithm<G> {
 		 */
 		std::vector<std::pair<double, size_t> > elite_set;
 
+		/// Are the parameters adapted during the execution?
+		bool adaptive = false;
+		/// Were the bounds set by the user?
+		bool adaptive_bounds_set = false;
+		/// Minimum size of the elite set in adaptive mode.
+		size_t min_elite = 1;
+		/// Maximum size of the elite set in adaptive mode.
+		size_t max_elite = 1;
+		/// Minimum size of the mutant set in adaptive mode.
+		size_t min_mutant = 0;
+		/// Maximum size of the mutant set in adaptive mode.
+		size_t max_mutant = 0;
+		/// Minimum inheritance probability in adaptive mode.
+		double min_in_prob = 0.5;
+		/// Maximum inheritance probability in adaptive mode.
+		double max_in_prob = 0.8;
+		/// Generations without improvement before diversifying.
+		size_t adaptive_window = 10;
+		/// Change of the inheritance probability at every adaptation.
+		double adaptive_prob_step = 0.05;
+		/// Diversity, relative to the initial one, that triggers diversification.
+		double adaptive_diversity_ratio = 0.25;
+
+		/// Elite set size given in the constructor.
+		size_t init_N_ELITE = 0;
+		/// Mutant set size given in the constructor.
+		size_t init_N_MUTANT = 0;
+		/// Inheritance probability given in the constructor.
+		double init_in_prob = 1.0;
+		/// Generations since the last improvement.
+		size_t n_stalled = 0;
+		/// Best fitness found so far (used in adaptive mode).
+		double adaptive_best = 0.0;
+		/// Diversity of the initial population (used in adaptive mode).
+		double initial_diversity = 0.0;
+
 	protected:
 
+		/**
+		 * @brief Evaluates the individuals within the range [A,B) of @e set.
+		 *
+		 * Calls @ref genetic_algorithm::evaluate_range with class @e P.
+		 */
+		void evaluate_individuals(
+			const structures::problem<G> *p, population_set<T>& set,
+			size_t A, size_t B
+		) const;
+
 		// Information display functions
 		/// Display to standard output the elite individuals
 		void print_elite_set() const;
@@ -200,7 +325,7 @@ class brkga : public genetic_algorithm<G> {
 		 * @pre @e m < @ref genetic_algorithm::pop_size
 		 */
 		void copy_elite_individuals
-		(const structures::problem<G> *p, population_set& next_gen, size_t& m);
+		(const structures::problem<G> *p, population_set<T>& next_gen, size_t& m);
 		/**
 		 * @brief Returns whether the @e i-th individual is an elite individual or not.
 		 * @pre @e i < @ref genetic_algorithm::pop_size.
@@ -215,6 +340,38 @@ class brkga : public genetic_algorithm<G> {
 		 */
 		void track_elite_individuals();
 
+		// Adaptive parameters
+		/**
+		 * @brief Sets the parameters to their initial values.
+		 *
+		 * Restores the values given in the constructor. In adaptive mode,
+		 * computes the default bounds (if not set) and clamps the values
+		 * to them.
+		 */
+		void init_adaptive_parameters();
+		/**
+		 * @brief Adapts the parameters after a generation.
+		 *
+		 * Intensifies or diversifies the search as explained in the
+		 * description of the class. Re-initialises @ref elite_rng and
+		 * resizes @ref elite_set if the size of the elite set changed.
+		 */
+		void adapt_parameters();
+
+		// Checkpoints
+		/// Returns @ref checkpointing::algorithm_tag::brkga.
+		checkpointing::algorithm_tag get_checkpoint_tag() const;
+		/**
+		 * @brief Writes the state of the algorithm into @e os.
+		 *
+		 * Extends @ref genetic_algorithm::write_state with
+		 * @ref elite_copying_time, the state of @ref elite_rng, the
+		 * elite set and the state of the adaptive parameters.
+		 */
+		void write_state(std::ostream& os) const;
+		/// Reads the state written with @ref write_state.
+		bool read_state(std::istream& is);
+
 		// Sanity check
 		/**
 		 * @brief Makes sure that the different populations sizes are correct.
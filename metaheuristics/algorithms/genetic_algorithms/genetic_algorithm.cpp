@@ -26,7 +26,9 @@
 #include <metaheuristics/algorithms/genetic_algorithms/genetic_algorithm.hpp>
 
 // C++ includes
+#include <type_traits>
 #include <iostream>
+#include <sstream>
 #include <limits>
 
 #if defined (GENETICS_VERBOSE)
@@ -34,17 +36,15 @@
 #endif
 
 // metaheuristics includes
-#if defined (GENETICS_DEBUG)
 #include <metaheuristics/macros.hpp>
-#endif
 
 namespace metaheuristics {
 namespace algorithms {
 
 // PUBLIC
 
-template<class G>
-genetic_algorithm<G>::genetic_algorithm
+template<class G, typename T>
+genetic_algorithm<G,T>::genetic_algorithm
 (
 	size_t ps, size_t mps, size_t n_gen,
 	size_t c_size, double in_p
@@ -60,8 +60,8 @@ genetic_algorithm<G>::genetic_algorithm
 	reset_genetic_algorithm();
 }
 
-template<class G>
-const structures::individual& genetic_algorithm<G>::get_best_individual() const {
+template<class G, typename T>
+const structures::individual<T>& genetic_algorithm<G,T>::get_best_individual() const {
 	double f = -std::numeric_limits<double>::max();
 	size_t best = 0;
 	
@@ -75,23 +75,33 @@ const structures::individual& genetic_algorithm<G>::get_best_individual() const
 	return population[best];
 }
 
-template<class G>
-const structures::individual& genetic_algorithm<G>::get_individual(size_t i) const {
+template<class G, typename T>
+const structures::individual<T>& genetic_algorithm<G,T>::get_individual(size_t i) const {
 	assert(i < pop_size);
 	return population[i];
 }
 
-template<class G>
-size_t genetic_algorithm<G>::population_size() const {
+template<class G, typename T>
+size_t genetic_algorithm<G,T>::population_size() const {
 	return population.size();
 }
 
+template<class G, typename T>
+void genetic_algorithm<G,T>::set_diversity_tracking(bool t) {
+	track_diversity = t;
+}
+
+template<class G, typename T>
+const population_diversity& genetic_algorithm<G,T>::get_diversity() const {
+	return diversity;
+}
+
 // PROTECTED
 
 // Information display functions
 
-template<class G>
-void genetic_algorithm<G>::print_current_population() const {
+template<class G, typename T>
+void genetic_algorithm<G,T>::print_current_population() const {
 	std::cout << "    * Current population:" << std::endl;
 	for (size_t i = 0; i < pop_size; ++i) {
 		std::cout << "        " << i << ": " << population[i] << std::endl;
@@ -101,8 +111,8 @@ void genetic_algorithm<G>::print_current_population() const {
 
 // Algorithm-related functions
 
-template<class G>
-void genetic_algorithm<G>::initialize_population(const structures::problem<G> *p) {
+template<class G, typename T>
+void genetic_algorithm<G,T>::initialize_population(const structures::problem<G> *p) {
 	population.clear();
 	population.resize(pop_size, chrom_size);
 
@@ -111,65 +121,116 @@ void genetic_algorithm<G>::initialize_population(const structures::problem<G> *p
 		std::cout << "    pre: " << i << ": " << population[i] << std::endl;
 		#endif
 
-		generate_mutant(p, population[i]);
+		generate_mutant(population[i]);
+	}
+	evaluate_individuals(p, population, 0, pop_size);
 
-		#if defined (GENETICS_DEBUG)
+	#if defined (GENETICS_DEBUG)
+	for (size_t i = 0; i < pop_size; ++i) {
 		std::cout << "    post: " << i << ": " << population[i] << std::endl;
 		std::cout << std::endl;
-		#endif
+	}
+	#endif
+
+	if (track_diversity) {
+		diversity.init(pop_size, chrom_size);
+		diversity.update(population);
 	}
 }
 
-template<class G>
-void genetic_algorithm<G>::generate_mutants(
+template<class G, typename T>
+void genetic_algorithm<G,T>::update_diversity() {
+	if (track_diversity) {
+		diversity.update(population);
+	}
+}
+
+template<class G, typename T>
+void genetic_algorithm<G,T>::generate_mutants(
 	const structures::problem<G> *p, size_t A, size_t B,
-	population_set& next_gen, size_t& m
+	population_set<T>& next_gen, size_t& m
 )
 {
 	for (m = A; m < B; ++m) {
-		generate_mutant(p, next_gen[m]);
+		generate_mutant(next_gen[m]);
+	}
+	evaluate_individuals(p, next_gen, A, B);
 
-		#if defined (GENETICS_VERBOSE)
-		std::cout << "        " << m << ": " << next_gen[m] << std::endl;
-		#endif
+	#if defined (GENETICS_VERBOSE)
+	for (size_t i = A; i < B; ++i) {
+		std::cout << "        " << i << ": " << next_gen[i] << std::endl;
 	}
+	#endif
 }
 
-template<class G>
-void genetic_algorithm<G>::generate_crossovers(
+template<class G, typename T>
+void genetic_algorithm<G,T>::generate_crossovers(
 	const structures::problem<G> *p,
-	population_set& next_gen, size_t& m
+	population_set<T>& next_gen, size_t& m
 )
 {
 	size_t par1_idx, par2_idx;
+	const size_t first = m;
+
+	#if defined (GENETICS_VERBOSE)
+	std::vector<std::pair<size_t, size_t> > parents;
+	#endif
 
 	for (; m < pop_size; ++m) {
 		get_two_parents(par1_idx, par2_idx);
-		crossover(p, par1_idx, par2_idx, next_gen[m]);
+		crossover(par1_idx, par2_idx, next_gen[m]);
 
 		#if defined (GENETICS_VERBOSE)
+		parents.push_back(std::make_pair(par1_idx, par2_idx));
+		#endif
+	}
+	evaluate_individuals(p, next_gen, first, pop_size);
+
+	#if defined (GENETICS_VERBOSE)
+	for (size_t i = first; i < pop_size; ++i) {
 		std::cout
 			<< "        "
-			<< m << ": (" << par1_idx << " x " << par2_idx << ")"
-			<< "    " << next_gen[m]
+			<< i << ": (" << parents[i - first].first << " x " << parents[i - first].second << ")"
+			<< "    " << next_gen[i]
 			<< std::endl;
-		#endif
 	}
+	#endif
 }
 
 // Population-generation functions
 
-template<class G>
-void genetic_algorithm<G>::evaluate_individual(
-	const structures::problem<G> *p, structures::individual& i
+template<class G, typename T>
+template<class P>
+bool genetic_algorithm<G,T>::decode_individual(
+	const structures::problem<G> *p, structures::individual<T>& i,
+	bool timed, double& s, bool& allocated
 )
 const
 {
-	structures::problem<G> *copy = p->clone();
+	P *copy = static_cast<P *>(META<G>::solutions->acquire_clone(p, &allocated));
 
+	timing::time_point begin;
+	if (timed) {
+		begin = timing::now();
+	}
+
+	bool feasible = true;
 	try {
-		// decode the chromosome into a solution of the problem<G>
-		const double F = copy->decode(i.get_chromosome());
+		// decode the chromosome into a solution of the problem<G>. If P
+		// does not decode chromosomes with genes of type T, the decode
+		// goes through the interface, which converts the genes.
+		double F;
+		if constexpr (decodes_genes<P>(0)) {
+			F = copy->decode(i.get_chromosome());
+		}
+		else {
+			structures::problem<G> *q = copy;
+			F = q->decode(i.get_chromosome());
+		}
+
+		if (timed) {
+			s = timing::elapsed_seconds(begin, timing::now());
+		}
 
 		#if defined (GENETICS_DEBUG)
 		if (not copy->sanity_check(std::cerr)) {
@@ -180,70 +241,259 @@ const
 
 		// store the quality of the solution in the individual
 		i.set_fitness(F);
-
-		// free memory
-		delete copy;
 	}
 	catch (const structures::infeasible_exception& e) {
+		if (timed) {
+			s = timing::elapsed_seconds(begin, timing::now());
+		}
+
 		// store the quality of the solution in the individual
 		i.set_fitness(-std::numeric_limits<double>::max());
+		feasible = false;
+	}
+
+	// recycle memory
+	META<G>::solutions->release(copy);
+	return feasible;
+}
 
-		// free memory
-		delete copy;
+template<class G, typename T>
+void genetic_algorithm<G,T>::record_decode(bool feasible, double s, bool allocated) const {
+	META<G>::record(profiling::metrics::counter::clones);
+	if (allocated) {
+		META<G>::record(profiling::metrics::counter::allocations);
+	}
+	META<G>::record(profiling::metrics::counter::decodes);
+	META<G>::record_latency(profiling::metrics::phase::decode, s);
+	if (not feasible) {
+		META<G>::record(profiling::metrics::counter::infeasible_decodes);
 	}
 }
 
-template<class G>
-void genetic_algorithm<G>::generate_mutant(
-	const structures::problem<G> *p, structures::individual& i
+template<class G, typename T>
+void genetic_algorithm<G,T>::evaluate_individual(
+	const structures::problem<G> *p, structures::individual<T>& i
 )
+const
 {
-	// generate chromosome
-	zero_one_rng.make_n_uniform(&i.get_chromosome()[0], i.get_chromosome().size());
+	// the decode is timed only when the metrics are collected
+	double s = 0.0;
+	bool allocated = false;
+	const bool feasible = decode_individual<structures::problem<G> >
+		(p, i, META<G>::stats != nullptr, s, allocated);
+	record_decode(feasible, s, allocated);
+}
+
+template<class G, typename T>
+void genetic_algorithm<G,T>::evaluate_individuals(
+	const structures::problem<G> *p, population_set<T>& set, size_t A, size_t B
+)
+const
+{
+	evaluate_range<structures::problem<G> >(p, set, A, B);
+}
+
+template<class G, typename T>
+template<class P>
+void genetic_algorithm<G,T>::evaluate_range(
+	const structures::problem<G> *p, population_set<T>& set, size_t A, size_t B
+)
+const
+{
+	if (META<G>::pool == nullptr) {
+		// the decode is timed only when the metrics are collected
+		const bool timed = META<G>::stats != nullptr;
+		double s = 0.0;
+		bool allocated = false;
+		for (size_t i = A; i < B; ++i) {
+			const bool feasible = decode_individual<P>(p, set[i], timed, s, allocated);
+			record_decode(feasible, s, allocated);
+		}
+		return;
+	}
+
+	// the metrics can only be modified by one thread: the outcome
+	// of every decode is kept and recorded once all have finished
+	const bool timed = META<G>::stats != nullptr;
+	std::vector<double> seconds(B - A, 0.0);
+	std::vector<char> feasible(B - A, 1);
+	std::vector<char> allocated(B - A, 0);
+
+	META<G>::pool->parallel_for(A, B,
+		[&](size_t i) -> void {
+			bool a = false;
+			feasible[i - A] = decode_individual<P>(p, set[i], timed, seconds[i - A], a);
+			allocated[i - A] = a;
+		}
+	);
 
-	// compute the fitness of an individual
-	evaluate_individual(p, i);
+	for (size_t k = 0; k < B - A; ++k) {
+		record_decode(feasible[k], seconds[k], allocated[k]);
+	}
 }
 
-template<class G>
-void genetic_algorithm<G>::crossover(
-	const structures::problem<G> *p, size_t par1_idx, size_t par2_idx,
-	structures::individual& child
+template<class G, typename T>
+void genetic_algorithm<G,T>::generate_mutant(structures::individual<T>& i) {
+	// generate chromosome
+	structures::chromosome<T>& c = i.get_chromosome();
+	if constexpr (std::is_same<T, double>::value) {
+		zero_one_rng.make_n_uniform(&c[0], c.size());
+	}
+	else {
+		for (size_t g = 0; g < c.size(); ++g) {
+			c[g] = T(zero_one_rng.get_uniform());
+		}
+	}
+}
+
+template<class G, typename T>
+void genetic_algorithm<G,T>::crossover(
+	size_t par1_idx, size_t par2_idx, structures::individual<T>& child
 )
 {
-	const structures::individual& parent1 = population[par1_idx];
-	const structures::individual& parent2 = population[par2_idx];
+	const structures::individual<T>& parent1 = population[par1_idx];
+	const structures::individual<T>& parent2 = population[par2_idx];
 
 	for (size_t i = 0; i < chrom_size; ++i) {
-		const double g1 = parent1.get_gene(i);
-		const double g2 = parent2.get_gene(i);
+		const T g1 = parent1.get_gene(i);
+		const T g2 = parent2.get_gene(i);
 
 		const double rand = zero_one_rng.get_uniform();
-		const double selected_gene = (rand <= in_prob ? g1 : g2);
+		const T selected_gene = (rand <= in_prob ? g1 : g2);
 
 		child.set_gene(i, selected_gene);
 	}
-
-	evaluate_individual(p, child);
 }
 
-template<class G>
-void genetic_algorithm<G>::reset_genetic_algorithm() {
+template<class G, typename T>
+void genetic_algorithm<G,T>::reset_genetic_algorithm() {
 	total_time = 0.0;
 	initial_time = 0.0;
 	crossover_time = 0.0;
 	mutant_time = 0.0;
+	observed_best = -std::numeric_limits<double>::max();
 }
 
-template<class G>
-void genetic_algorithm<G>::initialise_generators() {
+template<class G, typename T>
+void genetic_algorithm<G,T>::initialise_generators() {
 	zero_one_rng.init_uniform(0, 1);
 	population_rng.init_uniform(0, pop_size - 1);
 
-	if (META<G>::seed_rng) {
-		zero_one_rng.seed_random_engine();
-		population_rng.seed_random_engine();
+	META<G>::seed_generator(zero_one_rng, 0);
+	META<G>::seed_generator(population_rng, 1);
+}
+
+template<class G, typename T>
+bool genetic_algorithm<G,T>::notify_generation(size_t g) {
+	const double best = get_best_individual().get_fitness();
+	if (best > observed_best) {
+		observed_best = best;
+		META<G>::obs->on_improvement(best);
+	}
+	return META<G>::obs->on_generation(*this, g, best);
+}
+
+// Checkpoints
+
+template<class G, typename T>
+void genetic_algorithm<G,T>::write_state(std::ostream& os) const {
+	checkpointing::write_value(os, total_time);
+	checkpointing::write_value(os, initial_time);
+	checkpointing::write_value(os, crossover_time);
+	checkpointing::write_value(os, mutant_time);
+
+	zero_one_rng.write_state(os);
+	population_rng.write_state(os);
+
+	checkpointing::write_value(os, pop_size);
+	checkpointing::write_value(os, chrom_size);
+	checkpointing::write_value(os, sizeof(T));
+	checkpointing::write_value(os, N_MUTANT);
+	checkpointing::write_value(os, in_prob);
+
+	for (size_t i = 0; i < pop_size; ++i) {
+		checkpointing::write_value(os, population[i].get_fitness());
+		checkpointing::write_values(os, &population[i].get_chromosome()[0], chrom_size);
+	}
+}
+
+template<class G, typename T>
+bool genetic_algorithm<G,T>::read_state(std::istream& is) {
+	size_t ps, cs, gs;
+
+	bool ok =
+		checkpointing::read_value(is, total_time) and
+		checkpointing::read_value(is, initial_time) and
+		checkpointing::read_value(is, crossover_time) and
+		checkpointing::read_value(is, mutant_time) and
+		zero_one_rng.read_state(is) and
+		population_rng.read_state(is) and
+		checkpointing::read_value(is, ps) and
+		checkpointing::read_value(is, cs) and
+		checkpointing::read_value(is, gs);
+
+	if (not ok or ps != pop_size or cs != chrom_size or gs != sizeof(T)) {
+		return false;
+	}
+	if (not checkpointing::read_value(is, N_MUTANT) or
+		not checkpointing::read_value(is, in_prob))
+	{
+		return false;
+	}
+	// there must be at least one crossover individual, and the
+	// population must be stored entirely in the stream
+	if (N_MUTANT >= pop_size or not (0.0 <= in_prob and in_prob <= 1.0) or
+		not checkpointing::fits_in_stream(is, pop_size, sizeof(double) + chrom_size*sizeof(T)))
+	{
+		return false;
+	}
+
+	population.clear();
+	population.resize(pop_size, chrom_size);
+	for (size_t i = 0; i < pop_size; ++i) {
+		double f;
+		if (not checkpointing::read_value(is, f) or
+			not checkpointing::read_values(is, &population[i].get_chromosome()[0], chrom_size))
+		{
+			return false;
+		}
+		population[i].set_fitness(f);
+	}
+
+	if (track_diversity) {
+		diversity.init(pop_size, chrom_size);
+		diversity.update(population);
+	}
+	return true;
+}
+
+template<class G, typename T>
+void genetic_algorithm<G,T>::save_checkpoint(size_t g, const timing::time_point& bbegin) {
+	std::ostringstream ss(std::ios::binary);
+	checkpointing::write_header(ss, get_checkpoint_tag());
+	checkpointing::write_value(ss, g);
+
+	// the total time is only accumulated at the end of the execution
+	const double t = total_time;
+	total_time += timing::elapsed_seconds(bbegin, timing::now());
+	write_state(ss);
+	total_time = t;
+
+	META<G>::write_checkpoint(ss.str());
+}
+
+template<class G, typename T>
+bool genetic_algorithm<G,T>::load_checkpoint(size_t& g) {
+	std::ifstream fin;
+	if (not META<G>::open_resume_file(fin, get_checkpoint_tag())) {
+		return false;
+	}
+	if (not checkpointing::read_value(fin, g) or not read_state(fin)) {
+		std::cerr << MH_ERROR << std::endl;
+		std::cerr << "    Checkpoint does not match the parameters of the algorithm" << std::endl;
+		return false;
 	}
+	return true;
 }
 
 
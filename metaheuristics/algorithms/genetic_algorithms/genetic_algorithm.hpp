@@ -24,33 +24,25 @@
 #pragma once
 
 // C++ includes
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 // metaheursitics includes
+#include <metaheuristics/algorithms/genetic_algorithms/population_diversity.hpp>
+#include <metaheuristics/algorithms/genetic_algorithms/population_set.hpp>
 #include <metaheuristics/algorithms/metaheuristic.hpp>
 #include <metaheuristics/random/random_generator.hpp>
 #include <metaheuristics/structures/infeasible_exception.hpp>
 #include <metaheuristics/structures/chromosome.hpp>
 #include <metaheuristics/structures/individual.hpp>
 #include <metaheuristics/structures/problem.hpp>
+#include <metaheuristics/misc/checkpoint.hpp>
 #include <metaheuristics/misc/time.hpp>
 
 namespace metaheuristics {
 namespace algorithms {
 
-/**
- * @brief Typedef for the population set.
- * 
- * Basically, a shorthand for the vector that contains elements
- * of type @ref structures::individual and uses an allocator specially
- * for that class (see @ref structures::allocator_individual).
- */
-typedef
-	std::vector<
-		structures::individual,
-		structures::allocator_individual<structures::individual>
-	> population_set;
-
 /**
  * @brief Abstract class to implement genetic algorithms.
  * 
@@ -74,10 +66,32 @@ typedef
 	\endverbatim
  * to see the contents of the population (i.e., the genes of each individual).
  * 
+ * The progress of the algorithm can also be followed at run time with
+ * an @ref observer (see @ref metaheuristic::set_observer), which is
+ * notified after every generation.
+ * 
+ * The state of the algorithm can be saved periodically and the execution
+ * resumed later (see @ref metaheuristic::set_checkpointing and
+ * @ref metaheuristic::set_resume_file). A resumed execution produces
+ * exactly the same population as an execution that was never interrupted.
+ * 
+ * If a thread pool is given (see @ref metaheuristic::set_thread_pool)
+ * the individuals of every generation are decoded in parallel. The
+ * chromosomes are generated before, in the calling thread, so the
+ * population is the same regardless of the number of threads.
+ * 
+ * The genes of the chromosomes are of type double by default. Genes of
+ * type float, or of type @ref structures::fixed16, take a half or a
+ * quarter of the memory, and suffice for decoders that only need the
+ * order of the genes. The random numbers are generated as doubles and
+ * converted to the type of the genes.
+ * 
  * @param G The type of the engine of the random generator (see metaheuristics::drng).
+ * @param T The type of the genes of the chromosomes (see @ref structures::chromosome).
  */
 template<
-	class G = std::default_random_engine
+	class G = std::default_random_engine,
+	typename T = double
 >
 class genetic_algorithm : public metaheuristic<G> {
 	public:
@@ -108,12 +122,12 @@ class genetic_algorithm : public metaheuristic<G> {
 		virtual ~genetic_algorithm() = default;
 		
 		/// Returns a constant reference to the individual with largest fitness.
-		virtual const structures::individual& get_best_individual() const;
+		virtual const structures::individual<T>& get_best_individual() const;
 		/**
 		 * @brief Returns a constant reference to the i-th individual.
 		 * @pre @e i < @ref pop_size.
 		 */
-		const structures::individual& get_individual(size_t i) const;
+		const structures::individual<T>& get_individual(size_t i) const;
 		
 		/**
 		 * @brief Returns the size of the population.
@@ -121,6 +135,23 @@ class genetic_algorithm : public metaheuristic<G> {
 		 */
 		size_t population_size() const;
 		
+		/**
+		 * @brief Enables or disables the tracking of the population's diversity.
+		 * 
+		 * When enabled, the measures in @ref diversity are updated
+		 * after the population is initialised and after every generation.
+		 * Disabled by default.
+		 */
+		void set_diversity_tracking(bool t);
+		/**
+		 * @brief Returns the diversity measures of the current population.
+		 * 
+		 * Only meaningful if the tracking was enabled (see
+		 * @ref set_diversity_tracking) before executing the algorithm.
+		 * @returns Returns a constant reference to @ref diversity.
+		 */
+		const population_diversity& get_diversity() const;
+		
 		/**
 		 * @brief Executes a genetic algorithm.
 		 * @param[out] p The solution obtained using the genetic algorithm.
@@ -166,7 +197,15 @@ class genetic_algorithm : public metaheuristic<G> {
 		double in_prob = 1.0;
 
 		/// The population of individuals.
-		population_set population;
+		population_set<T> population;
+
+		/// Is the diversity of the population tracked?
+		bool track_diversity = false;
+		/// Diversity measures of @ref population.
+		population_diversity diversity;
+
+		/// Best fitness notified to the observer.
+		double observed_best = 0.0;
 
 	protected:
 
@@ -192,6 +231,13 @@ class genetic_algorithm : public metaheuristic<G> {
 		 * the fitness is kept.
 		 */
 		void initialize_population(const structures::problem<G> *p);
+		/**
+		 * @brief Updates the diversity measures of the population.
+		 *
+		 * Does nothing if the tracking of the diversity is disabled
+		 * (see @ref track_diversity).
+		 */
+		void update_diversity();
 		/**
 		 * @brief The individuals within the range [A,B) are replaced with mutants.
 		 * @param[in] p The problem<G> for which a solution will be generated with each chromosome.
@@ -204,7 +250,7 @@ class genetic_algorithm : public metaheuristic<G> {
 		 */
 		void generate_mutants(
 			const structures::problem<G> *p, size_t A, size_t B,
-			population_set& next_gen, size_t& m
+			population_set<T>& next_gen, size_t& m
 		);
 
 		/**
@@ -230,11 +276,11 @@ class genetic_algorithm : public metaheuristic<G> {
 		 */
 		void generate_crossovers(
 			const structures::problem<G> *p,
-			population_set& next_gen, size_t& m
+			population_set<T>& next_gen, size_t& m
 		);
 
 		/**
-		 * @brief Evaluates an individual.
+		 * @brief Decodes an individual.
 		 *
 		 * Creates a solution using method @ref problem<G>::decode and @e i's
 		 * chromosome. Then sets @e i's fitness using the cost of that
@@ -244,52 +290,118 @@ class genetic_algorithm : public metaheuristic<G> {
 		 * @ref structures::infeasible_exception the fitness is set to
 		 * minus infinity.
 		 *
+		 * Does not modify the metrics, so that it can be called by
+		 * several threads at the same time.
+		 *
+		 * @tparam P The class of the solutions of the problem. The methods
+		 * of @e P are called directly (instead of through the virtual
+		 * interface) if @e P is a final class.
 		 * @param[in] p The problem<G> for which a solution will be generated
-		 * with @e i's chromosome.
+		 * with @e i's chromosome. Its class must be @e P, or derive from it.
 		 * @param[out] i Inidividual from which the solution is generated.
+		 * @param[in] timed Is the decode timed?
+		 * @param[out] s The time of the decode, in seconds, if @e timed.
+		 * @param[out] allocated Was the copy of @e p allocated, instead
+		 * of taken from the pool of solutions?
 		 * @pre Inidividual @e i has its chromosome set.
 		 * @post Inidividual @e i is given its fitness.
+		 * @returns Returns false if the solution was infeasible.
 		 */
-		void evaluate_individual
-		(const structures::problem<G> *p, structures::individual& i) const;
+		template<class P>
+		bool decode_individual(
+			const structures::problem<G> *p, structures::individual<T>& i,
+			bool timed, double& s, bool& allocated
+		) const;
+		/**
+		 * @brief Can class @e P decode a chromosome<T> directly?
+		 * 
+		 * True if a method @e decode of @e P, and not only of the
+		 * interface @ref structures::problem, takes a chromosome
+		 * with genes of type @e T. Call with argument 0.
+		 */
+		template<class P>
+		static constexpr auto decodes_genes(int)
+		-> decltype(
+			std::declval<P&>().decode(std::declval<const structures::chromosome<T>&>()),
+			bool()
+		)
+		{
+			return true;
+		}
+		/// See @ref decodes_genes(int).
+		template<class P>
+		static constexpr bool decodes_genes(...) {
+			return false;
+		}
+		/// Records a decode that took @e s seconds into the metrics.
+		void record_decode(bool feasible, double s, bool allocated) const;
 		/**
-		 * @brief Generates a mutant individual.
+		 * @brief Evaluates an individual.
 		 *
-		 * Generates its random chromosome, and evaluates the individual
-		 * (see @ref evaluate_individual(const problem<G>*, individual&)const )
+		 * Decodes the individual (see @ref decode_individual). If
+		 * the metrics are collected, the decode is timed and counted.
 		 *
 		 * @param[in] p The problem<G> for which a solution will be generated
 		 * with @e i's chromosome.
 		 * @param[out] i Inidividual from which the solution is generated.
-		 * @post Inidividual @e i is given its chromosome and fitness.
+		 * @pre Inidividual @e i has its chromosome set.
+		 * @post Inidividual @e i is given its fitness.
 		 */
-		void generate_mutant
-		(const structures::problem<G> *p, structures::individual& i);
+		void evaluate_individual
+		(const structures::problem<G> *p, structures::individual<T>& i) const;
+		/**
+		 * @brief Evaluates the individuals within the range [A,B) of @e set.
+		 *
+		 * Genetic algorithms that know the class of the solutions
+		 * override this method to call @ref evaluate_range with it.
+		 * @pre The individuals have their chromosome set.
+		 */
+		virtual void evaluate_individuals(
+			const structures::problem<G> *p, population_set<T>& set,
+			size_t A, size_t B
+		) const;
+		/**
+		 * @brief Evaluates the individuals within the range [A,B) of @e set.
+		 *
+		 * The individuals are evaluated in parallel if a thread pool
+		 * was given (see @ref metaheuristic::set_thread_pool), and one
+		 * after the other otherwise (see @ref decode_individual).
+		 * @tparam P The class of the solutions of the problem.
+		 * @pre The individuals have their chromosome set.
+		 */
+		template<class P>
+		void evaluate_range(
+			const structures::problem<G> *p, population_set<T>& set,
+			size_t A, size_t B
+		) const;
+		/**
+		 * @brief Generates the random chromosome of a mutant individual.
+		 *
+		 * The individual is not evaluated.
+		 * @param[out] i Inidividual whose chromosome is generated.
+		 */
+		void generate_mutant(structures::individual<T>& i);
 
 		/**
 		 * @brief Makes the crossover of @e i-th and @e j-th individuals.
 		 *
 		 * @e son is the result of making the crossover of the @e i-th
 		 * and @e j-th individuals. With probability @ref in_prob,
-		 * @e son will inherit @e i's gene.
+		 * @e son will inherit @e i's gene. The child is not evaluated.
 		 *
-		 * @param[in] p The problem<G> for which a solution will be generated
-		 * with @e i's chromosome.
 		 * @param[in] i First parent.
 		 * @param[in] j Second parent.
 		 * @param[out] child The result of the crossover of @e i-th and @e j-th
 		 * individuals.
 		 */
-		void crossover(
-			const structures::problem<G> *p, size_t i, size_t j,
-			structures::individual& child
-		);
+		void crossover(size_t i, size_t j, structures::individual<T>& child);
 
 		/**
 		 * @brief Resets the genetic algorithm to a partial initial state.
 		 *
 		 * Sets the variables @ref total_time, @ref initial_time,
-		 * @ref crossover_time, @ref mutant_time to 0.
+		 * @ref crossover_time, @ref mutant_time to 0, and
+		 * @ref observed_best to minus infinity.
 		 *
 		 * Seeds the random number generators @ref zero_one_rng and
 		 * @ref population_rng.
@@ -298,11 +410,58 @@ class genetic_algorithm : public metaheuristic<G> {
 
 		/// Initialise the random generators to the appropriate ranges.
 		void initialise_generators();
+
+		/**
+		 * @brief Notifies the observer of the end of generation @e g.
+		 *
+		 * Calls @ref observer::on_improvement if the largest fitness
+		 * in the population improved since the last notification,
+		 * and then @ref observer::on_generation.
+		 * @pre The observer is not null.
+		 * @returns Returns false if the algorithm has to stop.
+		 */
+		bool notify_generation(size_t g);
+
+		// Checkpoints
+
+		/// Returns the algorithm that is written in the checkpoints.
+		virtual checkpointing::algorithm_tag get_checkpoint_tag() const = 0;
+		/**
+		 * @brief Writes the state of the algorithm into @e os.
+		 *
+		 * The state consists of the timers, the state of the random
+		 * number generators, the values of @ref N_MUTANT and
+		 * @ref in_prob, the size of the genes, and the population
+		 * (fitness and genes of every individual). Genetic algorithms with more state must
+		 * extend this method.
+		 */
+		virtual void write_state(std::ostream& os) const;
+		/**
+		 * @brief Reads the state written with @ref write_state.
+		 * @returns Returns false if the state could not be read or if
+		 * it was written with a different population or chromosome size,
+		 * or with genes of a different type.
+		 */
+		virtual bool read_state(std::istream& is);
+		/**
+		 * @brief Writes a checkpoint after generation @e g.
+		 * @param g The generation just finished.
+		 * @param bbegin The moment the first generation of this
+		 * execution started, used to save the elapsed time.
+		 */
+		void save_checkpoint(size_t g, const timing::time_point& bbegin);
+		/**
+		 * @brief Restores the state saved in @ref metaheuristic::resume_file.
+		 * @param[out] g The last generation completed before the
+		 * checkpoint was written.
+		 * @returns Returns false if the checkpoint could not be read.
+		 */
+		bool load_checkpoint(size_t& g);
 };
 
 /// Shorthand for the genetic_algorithm class template
-template<class G>
-using GA = genetic_algorithm<G>;
+template<class G, typename T = double>
+using GA = genetic_algorithm<G,T>;
 
 } // -- namespace algorithms
 } // -- namespace metaheuristics
@@ -0,0 +1,147 @@
+/*********************************************************************
+ *
+ * Collection of heuristic and metaheuristic algorithms
+ *
+ * Copyright (C) 2018-2020  Lluís Alemany Puig
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Contact: Lluís Alemany Puig (lluis.alemany.puig@gmail.com)
+ * 
+ *********************************************************************/
+
+#include <metaheuristics/algorithms/genetic_algorithms/population_diversity.hpp>
+
+// C++ includes
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <cmath>
+
+namespace metaheuristics {
+namespace algorithms {
+
+// MODIFIERS
+
+void population_diversity::init(size_t pop_size, size_t chrom_size) {
+	gene_mean.assign(chrom_size, 0.0);
+	gene_var.assign(chrom_size, 0.0);
+	fitness_buffer.assign(pop_size, 0.0);
+	n_updates = 0;
+}
+
+// PRIVATE
+
+void population_diversity::finish_update() {
+	const size_t pop_size = fitness_buffer.size();
+	const size_t n_genes = gene_mean.size();
+	const double infeasible = -std::numeric_limits<double>::max();
+	
+	double sum_f = 0.0;
+	double sum_f2 = 0.0;
+	size_t n_feasible = 0;
+	min_fitness = std::numeric_limits<double>::max();
+	max_fitness = -std::numeric_limits<double>::max();
+	
+	for (size_t i = 0; i < pop_size; ++i) {
+		const double f = fitness_buffer[i];
+		if (f != infeasible) {
+			sum_f += f;
+			sum_f2 += f*f;
+			min_fitness = std::min(min_fitness, f);
+			max_fitness = std::max(max_fitness, f);
+			++n_feasible;
+		}
+	}
+	
+	// from sums to means and variances
+	const double N = static_cast<double>(pop_size);
+	double sum_dev = 0.0;
+	for (size_t g = 0; g < n_genes; ++g) {
+		gene_mean[g] /= N;
+		gene_var[g] = std::max(0.0, gene_var[g]/N - gene_mean[g]*gene_mean[g]);
+		sum_dev += std::sqrt(gene_var[g]);
+	}
+	mean_gene_dev = (n_genes > 0 ? sum_dev/static_cast<double>(n_genes) : 0.0);
+	
+	n_infeasible = pop_size - n_feasible;
+	if (n_feasible > 0) {
+		const double F = static_cast<double>(n_feasible);
+		mean_fitness = sum_f/F;
+		dev_fitness = std::sqrt(std::max(0.0, sum_f2/F - mean_fitness*mean_fitness));
+	}
+	else {
+		min_fitness = max_fitness = mean_fitness = dev_fitness = 0.0;
+	}
+	
+	// count the different fitness values (sorting is done in place)
+	std::sort(fitness_buffer.begin(), fitness_buffer.end());
+	n_unique_fitness = static_cast<size_t>(
+		std::unique(fitness_buffer.begin(), fitness_buffer.end())
+		- fitness_buffer.begin()
+	);
+	
+	++n_updates;
+}
+
+// GETTERS
+
+size_t population_diversity::get_n_updates() const {
+	return n_updates;
+}
+
+double population_diversity::get_gene_mean(size_t i) const {
+	assert(i < gene_mean.size());
+	return gene_mean[i];
+}
+
+double population_diversity::get_gene_variance(size_t i) const {
+	assert(i < gene_var.size());
+	return gene_var[i];
+}
+
+double population_diversity::get_mean_gene_deviation() const {
+	return mean_gene_dev;
+}
+
+double population_diversity::get_min_fitness() const {
+	return min_fitness;
+}
+
+double population_diversity::get_max_fitness() const {
+	return max_fitness;
+}
+
+double population_diversity::get_mean_fitness() const {
+	return mean_fitness;
+}
+
+double population_diversity::get_fitness_deviation() const {
+	return dev_fitness;
+}
+
+double population_diversity::get_fitness_spread() const {
+	return max_fitness - min_fitness;
+}
+
+size_t population_diversity::get_n_unique_fitness() const {
+	return n_unique_fitness;
+}
+
+size_t population_diversity::get_n_infeasible() const {
+	return n_infeasible;
+}
+
+} // -- namespace algorithms
+} // -- namespace metaheuristics
@@ -0,0 +1,175 @@
+/*********************************************************************
+ *
+ * Collection of heuristic and metaheuristic algorithms
+ *
+ * Copyright (C) 2018-2020  Lluís Alemany Puig
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Contact: Lluís Alemany Puig (lluis.alemany.puig@gmail.com)
+ * 
+ *********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+// metaheursitics includes
+#include <metaheuristics/algorithms/genetic_algorithms/population_set.hpp>
+
+namespace metaheuristics {
+namespace algorithms {
+
+/**
+ * @brief Diversity measures of a population.
+ * 
+ * Summarises a population of individuals with:
+ * - the mean and the variance of every gene (see @ref get_gene_mean,
+ * @ref get_gene_variance),
+ * - the mean of the per-gene standard deviations
+ * (see @ref get_mean_gene_deviation), a scalar summary of how spread
+ * the chromosomes are in the unit hypercube,
+ * - the minimum, maximum, mean and standard deviation of the fitness
+ * of the feasible individuals,
+ * - the number of different fitness values (see @ref get_n_unique_fitness),
+ * - the number of infeasible individuals (those whose fitness is
+ * minus infinity, see @ref genetic_algorithm::evaluate_individual).
+ * 
+ * The measures are computed in a single pass over the population
+ * (see @ref update), at a cost of O(population size x chromosome size).
+ * The memory needed is allocated only once, in @ref init, so that
+ * updating the measures every generation does not allocate memory.
+ */
+class population_diversity {
+	public:
+		/// Default constructor.
+		population_diversity() = default;
+		/// Destructor.
+		~population_diversity() = default;
+		
+		// MODIFIERS
+		
+		/**
+		 * @brief Allocates the memory needed to compute the measures.
+		 * @param pop_size Size of the population.
+		 * @param chrom_size Size of the chromosome of each individual.
+		 */
+		void init(size_t pop_size, size_t chrom_size);
+		
+		/**
+		 * @brief Computes the measures of population @e pop.
+		 * @param T The type of the genes of the individuals.
+		 * @pre Method @ref init has been called with the size of @e pop
+		 * and the size of its individuals' chromosomes.
+		 */
+		template<typename T>
+		void update(const population_set<T>& pop);
+		
+		// GETTERS
+		
+		/// Returns the number of times method @ref update has been called.
+		size_t get_n_updates() const;
+		
+		/// Returns the mean of the @e i-th gene.
+		double get_gene_mean(size_t i) const;
+		/// Returns the variance of the @e i-th gene.
+		double get_gene_variance(size_t i) const;
+		/// Returns the mean of the standard deviations of all genes.
+		double get_mean_gene_deviation() const;
+		
+		/// Returns the smallest fitness among the feasible individuals.
+		double get_min_fitness() const;
+		/// Returns the largest fitness among the feasible individuals.
+		double get_max_fitness() const;
+		/// Returns the mean of the fitness of the feasible individuals.
+		double get_mean_fitness() const;
+		/// Returns the standard deviation of the fitness of the feasible individuals.
+		double get_fitness_deviation() const;
+		/// Returns the difference between the largest and the smallest fitness.
+		double get_fitness_spread() const;
+		/// Returns the number of different fitness values in the population.
+		size_t get_n_unique_fitness() const;
+		/// Returns the number of infeasible individuals.
+		size_t get_n_infeasible() const;
+
+	private:
+		/**
+		 * @brief Computes the measures from the sums of the genes.
+		 * 
+		 * Called at the end of @ref update, which leaves the sums of
+		 * the genes and of their squares in @ref gene_mean and
+		 * @ref gene_var, and the fitness of the individuals in
+		 * @ref fitness_buffer.
+		 */
+		void finish_update();
+		
+		/// Sum of the values of every gene (later, their mean).
+		std::vector<double> gene_mean;
+		/// Sum of the squares of every gene (later, their variance).
+		std::vector<double> gene_var;
+		/// Buffer used to count the different fitness values.
+		std::vector<double> fitness_buffer;
+
+		/// Mean of the standard deviations of the genes.
+		double mean_gene_dev = 0.0;
+		/// Smallest feasible fitness.
+		double min_fitness = 0.0;
+		/// Largest feasible fitness.
+		double max_fitness = 0.0;
+		/// Mean of the feasible fitness values.
+		double mean_fitness = 0.0;
+		/// Standard deviation of the feasible fitness values.
+		double dev_fitness = 0.0;
+		/// Number of different fitness values.
+		size_t n_unique_fitness = 0;
+		/// Number of infeasible individuals.
+		size_t n_infeasible = 0;
+		/// Number of calls to @ref update.
+		size_t n_updates = 0;
+};
+
+template<typename T>
+void population_diversity::update(const population_set<T>& pop) {
+	assert(pop.size() == fitness_buffer.size());
+	
+	const size_t n_genes = gene_mean.size();
+	std::fill(gene_mean.begin(), gene_mean.end(), 0.0);
+	std::fill(gene_var.begin(), gene_var.end(), 0.0);
+	
+	for (size_t i = 0; i < pop.size(); ++i) {
+		const structures::chromosome<T>& c = pop[i].get_chromosome();
+		assert(c.size() == n_genes);
+		
+		// accumulate the genes of the individual: independent iterations
+		// so that the compiler can vectorise the loop
+		const T *genes = &c[0];
+		double *__restrict__ S = gene_mean.data();
+		double *__restrict__ S2 = gene_var.data();
+		for (size_t g = 0; g < n_genes; ++g) {
+			const double x = static_cast<double>(genes[g]);
+			S[g] += x;
+			S2[g] += x*x;
+		}
+		
+		fitness_buffer[i] = pop[i].get_fitness();
+	}
+	
+	finish_update();
+}
+
+} // -- namespace algorithms
+} // -- namespace metaheuristics
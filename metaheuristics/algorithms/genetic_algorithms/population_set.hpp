@@ -0,0 +1,52 @@
+/*********************************************************************
+ *
+ * Collection of heuristic and metaheuristic algorithms
+ *
+ * Copyright (C) 2018-2020  Lluís Alemany Puig
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Contact: Lluís Alemany Puig (lluis.alemany.puig@gmail.com)
+ * 
+ *********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <vector>
+
+// metaheursitics includes
+#include <metaheuristics/structures/individual.hpp>
+
+namespace metaheuristics {
+namespace algorithms {
+
+/**
+ * @brief Typedef for the population set.
+ * 
+ * Basically, a shorthand for the vector that contains elements
+ * of type @ref structures::individual and uses an allocator specially
+ * for that class (see @ref structures::allocator_individual).
+ * 
+ * @param T The type of the genes of the individuals.
+ */
+template<typename T = double>
+using population_set =
+	std::vector<
+		structures::individual<T>,
+		structures::allocator_individual<structures::individual<T> >
+	>;
+
+} // -- namespace algorithms
+} // -- namespace metaheuristics
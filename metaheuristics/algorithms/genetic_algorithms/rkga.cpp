@@ -26,6 +26,7 @@
 #include <metaheuristics/algorithms/genetic_algorithms/rkga.hpp>
 
 // C++ includes
+#include <cassert>
 #include <iostream>
 #if defined (GENETICS_DEBUG)
 #include <iomanip>
@@ -33,50 +34,60 @@
 
 // metaheuristics includes
 #include <metaheuristics/misc/time.hpp>
-#if defined (GENETICS_DEBUG)
 #include <metaheuristics/macros.hpp>
-#endif
 
 namespace metaheuristics {
 namespace algorithms {
 
 // PUBLIC
 
-template<class G>
-rkga<G>::rkga
+template<class G, class P, typename T>
+rkga<G,P,T>::rkga
 (
 	size_t ps, size_t mps, size_t n_gen,
 	size_t c_size, double in_p
 )
-: genetic_algorithm<G>(ps, mps, n_gen, c_size, in_p)
+: genetic_algorithm<G,T>(ps, mps, n_gen, c_size, in_p)
 {
 	
 }
 
 // MODIFIERS
 
-template<class G>
-void rkga<G>::reset_algorithm() {
-	GA<G>::reset_genetic_algorithm();
+template<class G, class P, typename T>
+void rkga<G,P,T>::reset_algorithm() {
+	GA<G,T>::reset_genetic_algorithm();
 }
 
-template<class G>
-bool rkga<G>::execute_algorithm(structures::problem<G> *best, double& current_best_f) {
+template<class G, class P, typename T>
+bool rkga<G,P,T>::execute_algorithm(structures::problem<G> *best, double& current_best_f) {
+	// the solutions are decoded as instances of P
+	assert(dynamic_cast<P *>(best) != nullptr);
+	
 	if (not are_set_sizes_correct()) {
 		std::cerr << MH_ERROR << std::endl;
 		std::cerr << "    Sizes chosen will lead to errors:" << std::endl;
 		std::cerr << "    N_MUTANT >= pop_size" << std::endl;
-		std::cerr << "    " << GA<G>::N_MUTANT << " >= " << GA<G>::pop_size << std::endl;
+		std::cerr << "    " << GA<G,T>::N_MUTANT << " >= " << GA<G,T>::pop_size << std::endl;
 		return false;
 	}
 	
+	// wall time of the execution, for the metrics
+	profiling::metrics::scope wall(META<G>::stats);
+	
+	// the solutions decoded are recycled through the pool
+	META<G>::prepare_solutions();
+	
 	// initialise random number generators
-	GA<G>::initialise_generators();
+	GA<G,T>::initialise_generators();
 	// set algorithm to its initial state
 	reset_algorithm();
 	
+	// generation from which the execution starts
+	size_t first_gen = 1;
+	
 	// verbose variables
-	#if defined (GENETICS_DEBUG)
+	#if defined (GENETICS_VERBOSE)
 	double best_fit;
 	double prev_best_fit;
 	#endif
@@ -85,16 +96,28 @@ bool rkga<G>::execute_algorithm(structures::problem<G> *best, double& current_be
 	timing::time_point bbegin, bend, send, begin, end;
 	
 	#if defined (GENETICS_DEBUG)
-	std::cout << "RKGA - Generating initial population (" << GA<G>::pop_size << ")" << std::endl;
+	std::cout << "RKGA - Generating initial population (" << GA<G,T>::pop_size << ")" << std::endl;
 	#endif
 	
-	begin = timing::now();
-	GA<G>::initialize_population(best);
-	end = timing::now();
-	GA<G>::initial_time += timing::elapsed_seconds(begin, end);
+	if (not META<G>::resume_file.empty()) {
+		if (not GA<G,T>::load_checkpoint(first_gen)) {
+			return false;
+		}
+		++first_gen;
+	}
+	else {
+		begin = timing::now();
+		GA<G,T>::initialize_population(best);
+		end = timing::now();
+		GA<G,T>::initial_time += timing::elapsed_seconds(begin, end);
+		META<G>::record_latency(
+			profiling::metrics::phase::initial_population,
+			timing::elapsed_seconds(begin, end)
+		);
+	}
 	
 	#if defined (GENETICS_DEBUG)
-	GA<G>::print_current_population();
+	GA<G,T>::print_current_population();
 	#endif
 	
 	#if defined (GENETICS_VERBOSE)
@@ -102,33 +125,38 @@ bool rkga<G>::execute_algorithm(structures::problem<G> *best, double& current_be
 		<< setw(4)  << " "
 		<< setw(18) << "Elaps. Time (s)"
 		<< setw(18) << "Obj. Function"
-		<< setw(12) << "Gen./" << GA<G>::N_GEN << std::endl;
+		<< setw(12) << "Gen./" << GA<G,T>::N_GEN << std::endl;
 
-	best_fit = GA<G>::get_best_individual().get_fitness();
+	best_fit = GA<G,T>::get_best_individual().get_fitness();
 	prev_best_fit = best_fit;
 
 	std::cout
 		<< setw(4)  << "**"
-		<< setw(18) << GA<G>::initial_time
+		<< setw(18) << GA<G,T>::initial_time
 		<< setw(18) << best_fit
 		<< setw(12) << -1 << std::endl;
 	#endif
 	
-	population_set next_gen(GA<G>::pop_size, GA<G>::chrom_size);
+	population_set<T> next_gen(GA<G,T>::pop_size, GA<G,T>::chrom_size);
+	
+	// the observer may stop the execution at the end of any generation
+	bool stop = META<G>::obs != nullptr and not GA<G,T>::notify_generation(first_gen - 1);
 	
 	bbegin = timing::now();
-	for (size_t g = 1; g <= GA<G>::N_GEN; ++g) {
+	for (size_t g = first_gen; g <= GA<G,T>::N_GEN and not stop; ++g) {
 		#if defined (GENETICS_DEBUG)
 		std::cout << "RKGA - Generating " << g << "-th generation" << std::endl;
-		GA<G>::print_current_population();
+		GA<G,T>::print_current_population();
 		std::cout << "    * Generating mutants..." << std::endl;
 		#endif
 		
 		size_t m = 0;
 		begin = timing::now();
-		GA<G>::generate_mutants(best, 0, GA<G>::N_MUTANT, next_gen, m);
+		GA<G,T>::generate_mutants(best, 0, GA<G,T>::N_MUTANT, next_gen, m);
 		end = timing::now();
-		GA<G>::mutant_time += timing::elapsed_seconds(begin, end);
+		const double tm = timing::elapsed_seconds(begin, end);
+		GA<G,T>::mutant_time += tm;
+		META<G>::record_latency(profiling::metrics::phase::mutants, tm);
 		
 		#if defined (GENETICS_DEBUG)
 		std::cout << std::endl;
@@ -136,16 +164,31 @@ bool rkga<G>::execute_algorithm(structures::problem<G> *best, double& current_be
 		#endif
 		
 		begin = timing::now();
-		GA<G>::generate_crossovers(best, next_gen, m);
+		GA<G,T>::generate_crossovers(best, next_gen, m);
 		end = timing::now();
-		GA<G>::crossover_time += timing::elapsed_seconds(begin, end);
+		const double tc = timing::elapsed_seconds(begin, end);
+		GA<G,T>::crossover_time += tc;
+		META<G>::record_latency(profiling::metrics::phase::crossover, tc);
 		
 		#if defined (GENETICS_DEBUG)
 		std::cout << std::endl;
 		std::cout << "    * Swapping generations..." << std::endl;
 		#endif
 		
-		GA<G>::population = next_gen;
+		GA<G,T>::population = next_gen;
+		GA<G,T>::update_diversity();
+		
+		META<G>::record(profiling::metrics::counter::generations);
+		META<G>::record_latency(profiling::metrics::phase::generation, tm + tc);
+		
+		if (META<G>::checkpoint_due(g)) {
+			GA<G,T>::save_checkpoint(g, bbegin);
+		}
+		
+		if (META<G>::obs != nullptr) {
+			stop = not GA<G,T>::notify_generation(g);
+		}
+		
 		send = timing::now();
 		
 		#if defined (GENETICS_DEBUG)
@@ -153,7 +196,7 @@ bool rkga<G>::execute_algorithm(structures::problem<G> *best, double& current_be
 		#endif
 		
 		#if defined (GENETICS_VERBOSE)
-		best_fit = GA<G>::get_best_individual().get_fitness();
+		best_fit = GA<G,T>::get_best_individual().get_fitness();
 		double etime = timing::elapsed_seconds(bbegin, send);
 
 		if (best_fit > prev_best_fit) {
@@ -172,26 +215,30 @@ bool rkga<G>::execute_algorithm(structures::problem<G> *best, double& current_be
 		#endif
 	}
 	bend = timing::now();
-	GA<G>::total_time += timing::elapsed_seconds(bbegin, bend);
+	GA<G,T>::total_time += timing::elapsed_seconds(bbegin, bend);
+	
+	if (not META<G>::finish_checkpoints()) {
+		return false;
+	}
 	
 	#if defined (GENETICS_VERBOSE)
-	std::cout << "Generated all generations in " << GA<G>::total_time << " s" << std::endl;
+	std::cout << "Generated all generations in " << GA<G,T>::total_time << " s" << std::endl;
 	#endif
 	
-	const structures::individual& fittest_individual = GA<G>::get_best_individual();
-	current_best_f = best->decode(fittest_individual.get_chromosome());
+	const structures::individual<T>& fittest_individual = GA<G,T>::get_best_individual();
+	current_best_f = static_cast<P *>(best)->decode(fittest_individual.get_chromosome());
 	return true;
 }
 
-template<class G>
-void rkga<G>::print_performance() const {
+template<class G, class P, typename T>
+void rkga<G,P,T>::print_performance() const {
 	std::cout << "RKGA algorithm performance:" << std::endl;
-	std::cout << "    Total generation average:          " << GA<G>::total_time << std::endl;
-	std::cout << "    Average generation average:        " << GA<G>::total_time/static_cast<double>(GA<G>::N_GEN) << std::endl;
-	std::cout << "    Total mutant generation time:      " << GA<G>::mutant_time << std::endl;
-	std::cout << "    Average mutant generation time:    " << GA<G>::mutant_time/static_cast<double>(GA<G>::N_GEN) << std::endl;
-	std::cout << "    Total crossover generation time:   " << GA<G>::crossover_time << std::endl;
-	std::cout << "    Average crossover generation time: " << GA<G>::crossover_time/static_cast<double>(GA<G>::N_GEN) << std::endl;
+	std::cout << "    Total generation average:          " << GA<G,T>::total_time << std::endl;
+	std::cout << "    Average generation average:        " << GA<G,T>::total_time/static_cast<double>(GA<G,T>::N_GEN) << std::endl;
+	std::cout << "    Total mutant generation time:      " << GA<G,T>::mutant_time << std::endl;
+	std::cout << "    Average mutant generation time:    " << GA<G,T>::mutant_time/static_cast<double>(GA<G,T>::N_GEN) << std::endl;
+	std::cout << "    Total crossover generation time:   " << GA<G,T>::crossover_time << std::endl;
+	std::cout << "    Average crossover generation time: " << GA<G,T>::crossover_time/static_cast<double>(GA<G,T>::N_GEN) << std::endl;
 	std::cout << std::endl;
 }
 
@@ -199,22 +246,39 @@ void rkga<G>::print_performance() const {
 
 // Algorithm-related functions
 
-template<class G>
-void rkga<G>::get_two_parents(size_t& p1, size_t& p2) {
-	p1 = GA<G>::population_rng.get_uniform();
+template<class G, class P, typename T>
+void rkga<G,P,T>::evaluate_individuals(
+	const structures::problem<G> *p, population_set<T>& set, size_t A, size_t B
+)
+const
+{
+	GA<G,T>::template evaluate_range<P>(p, set, A, B);
+}
+
+
+template<class G, class P, typename T>
+void rkga<G,P,T>::get_two_parents(size_t& p1, size_t& p2) {
+	p1 = GA<G,T>::population_rng.get_uniform();
 
-	p2 = GA<G>::population_rng.get_uniform();
+	p2 = GA<G,T>::population_rng.get_uniform();
 	while (p2 == p1) {
-		p2 = GA<G>::population_rng.get_uniform();
+		p2 = GA<G,T>::population_rng.get_uniform();
 	}
 }
 
 // Sanity check
 
-template<class G>
-bool rkga<G>::are_set_sizes_correct() const {
+template<class G, class P, typename T>
+bool rkga<G,P,T>::are_set_sizes_correct() const {
 	// there must be at least one crossover individual
-	return rkga<G>::N_MUTANT < rkga<G>::pop_size;
+	return rkga<G,P,T>::N_MUTANT < rkga<G,P,T>::pop_size;
+}
+
+// Checkpoints
+
+template<class G, class P, typename T>
+checkpointing::algorithm_tag rkga<G,P,T>::get_checkpoint_tag() const {
+	return checkpointing::algorithm_tag::rkga;
 }
 
 } // -- namespace algorithms
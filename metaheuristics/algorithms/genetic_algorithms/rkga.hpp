@@ -71,16 +71,27 @@ namespace algorithms {
  * 
  * This algorithm needs the implementation of the following methods:
  * - @ref problem::clone
+ * - @ref problem::copy
+ * - @ref problem::clear
  * - @ref problem::decode
  * 
  * See @ref genetic_algorithm for information on compilation flags.
  * 
  * @param G The type of the engine of the random generator (see metaheuristics::drng).
+ * @param P The class of the solutions of the problem. The default, the
+ * interface @ref structures::problem, decodes the chromosomes through the
+ * virtual methods. If @e P is the (final) class implementing the problem,
+ * the compiler can call, and inline, its @ref problem::decode directly.
+ * The instances given to @ref execute_algorithm must be of class @e P.
+ * @param T The type of the genes of the chromosomes (see
+ * @ref genetic_algorithm).
  */
 template<
-	class G = std::default_random_engine
+	class G = std::default_random_engine,
+	class P = structures::problem<G>,
+	typename T = double
 >
-class rkga : public genetic_algorithm<G> {
+class rkga : public genetic_algorithm<G,T> {
 	public:
 		/// Default constructor
 		rkga() = default;
@@ -134,6 +145,16 @@ class rkga : public genetic_algorithm<G> {
 
 	protected:
 
+		/**
+		 * @brief Evaluates the individuals within the range [A,B) of @e set.
+		 *
+		 * Calls @ref genetic_algorithm::evaluate_range with class @e P.
+		 */
+		void evaluate_individuals(
+			const structures::problem<G> *p, population_set<T>& set,
+			size_t A, size_t B
+		) const;
+
 		// Sanity check
 		/**
 		 * @brief Makes sure that the different populations sizes are correct.
@@ -142,6 +163,10 @@ class rkga : public genetic_algorithm<G> {
 		 */
 		bool are_set_sizes_correct() const;
 
+		// Checkpoints
+		/// Returns @ref checkpointing::algorithm_tag::rkga.
+		checkpointing::algorithm_tag get_checkpoint_tag() const;
+
 	private:
 		/**
 		 * @brief Implementation of the parents choice.
@@ -26,7 +26,11 @@
 #include <metaheuristics/algorithms/grasp/grasp.hpp>
 
 // C++ includes
+#include <algorithm>
+#include <cassert>
+#include <sstream>
 #include <limits>
+#include <vector>
 #include <iostream>
 
 #if defined (GRASP_VERBOSE)
@@ -34,19 +38,241 @@
 #endif
 
 // metaheuristics includes
-#if defined (GRASP_DEBUG)
 #include <metaheuristics/macros.hpp>
-#endif
 
 namespace metaheuristics {
 namespace algorithms {
 
 // PRIVATE
 
+template<class G, class P>
+bool grasp<G,P>::save_checkpoint(
+	size_t it, const structures::problem<G> *best, double best_f,
+	const timing::time_point& bbegin
+)
+{
+	std::ostringstream ss(std::ios::binary);
+	checkpointing::write_header(ss, checkpointing::algorithm_tag::grasp);
+	checkpointing::write_value(ss, it);
+
+	// the total time is only accumulated at the end of the execution
+	checkpointing::write_value(ss, total_time + timing::elapsed_seconds(bbegin, timing::now()));
+	checkpointing::write_value(ss, construct_time);
+	checkpointing::write_value(ss, local_search_time);
+	drng.write_state(ss);
+
+	// the best solution is stored only if one was found
+	const bool has_best = best_f > -std::numeric_limits<double>::max();
+	checkpointing::write_value(ss, best_f);
+	checkpointing::write_value(ss, has_best);
+	if (has_best and not best->write_solution(ss)) {
+		return false;
+	}
+
+	META<G>::write_checkpoint(ss.str());
+	return true;
+}
+
+template<class G, class P>
+bool grasp<G,P>::load_checkpoint(size_t& it, structures::problem<G> *best, double& best_f) {
+	std::ifstream fin;
+	if (not META<G>::open_resume_file(fin, checkpointing::algorithm_tag::grasp)) {
+		return false;
+	}
+
+	bool has_best;
+	bool ok =
+		checkpointing::read_value(fin, it) and
+		checkpointing::read_value(fin, total_time) and
+		checkpointing::read_value(fin, construct_time) and
+		checkpointing::read_value(fin, local_search_time) and
+		drng.read_state(fin) and
+		checkpointing::read_value(fin, best_f) and
+		checkpointing::read_value(fin, has_best);
+
+	if (ok and has_best) {
+		ok = best->read_solution(fin);
+	}
+	if (not ok) {
+		std::cerr << MH_ERROR << std::endl;
+		std::cerr << "    Could not read the state of the algorithm from the checkpoint" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+template<class G, class P>
+void grasp<G,P>::seed_iteration(random::drandom_generator<G,size_t>& rng, size_t it) const {
+	if (META<G>::seed_rng and not META<G>::seed_fixed) {
+		rng.seed_random_engine();
+	}
+	else {
+		// unseeded executions are also reproducible
+		rng.seed_random_engine(META<G>::seed_value, it);
+	}
+}
+
+// 'it', 'current_best_f' and 'bbegin' are only displayed with GRASP_VERBOSE
+template<class G, class P>
+bool grasp<G,P>::execute_iteration(
+	[[maybe_unused]] size_t it, structures::problem<G> *r,
+	random::drandom_generator<G,size_t>& rng, local_search<G,P>& ls,
+	profiling::metrics *m, [[maybe_unused]] double current_best_f,
+	[[maybe_unused]] const timing::time_point& bbegin,
+	double& lsc, double& tc, double& tl
+)
+const
+{
+	timing::time_point begin, end;
+	if (m != nullptr) {
+		m->add(profiling::metrics::counter::empties);
+		m->add(profiling::metrics::counter::grasp_iterations);
+	}
+	lsc = -std::numeric_limits<double>::max();
+	tl = 0.0;
+	
+	try {
+		begin = timing::now();
+		double rcc = static_cast<P *>(r)->random_construct(&rng, alpha);
+		end = timing::now();
+		tc = timing::elapsed_seconds(begin, end);
+		if (m != nullptr) {
+			m->add_latency(profiling::metrics::phase::construct, tc);
+		}
+		
+		#if defined (GRASP_DEBUG)
+		if (not r->sanity_check(std::cerr)) {
+			std::cerr << MH_ERROR << std::endl;
+			std::cerr << "    Sanity check failed on solution returned by 'random_construct'." << std::endl;
+			r->print(std::cerr, "");
+		}
+		#endif
+		
+		#if defined (GRASP_VERBOSE)
+		if (rcc > current_best_f) {
+			std::cout << setw(8) << "**R.C.";
+		}
+		else {
+			std::cout << setw(8) << "R.C.";
+		}
+
+		std::cout
+			<< setw(15) << " "
+			<< setw(18) << timing::elapsed_seconds(bbegin, timing::now())
+			<< setw(18) << rcc
+			<< setw(12) << it
+			<< std::endl;
+		#endif
+		
+		lsc = rcc;
+		begin = timing::now();
+		ls.execute_algorithm(r, lsc);
+		end = timing::now();
+		tl = timing::elapsed_seconds(begin, end);
+		if (m != nullptr) {
+			m->add_latency(profiling::metrics::phase::grasp_iteration, tc + tl);
+		}
+		
+		#if defined (GRASP_DEBUG)
+		if (not r->sanity_check(std::cerr)) {
+			std::cerr << MH_ERROR << std::endl;
+			std::cerr << "Sanity check failed on solution returned by local search algorithm." << std::endl;
+			r->print(std::cerr, "");
+		}
+		#endif
+		
+		#if defined (GRASP_VERBOSE)
+		if (lsc > rcc and lsc != numeric_limits<double>::max()) {
+			std::cout << setw(8) << " ";
+
+			if (lsc > current_best_f) {
+				std::cout << setw(15) << "**L.S.";
+			}
+			else {
+				std::cout << setw(15) << "L.S.";
+			}
+
+			std::cout
+				<< setw(18) << timing::elapsed_seconds(bbegin, timing::now())
+				<< setw(18) << lsc
+				<< setw(12) << it
+				<< std::endl;
+		}
+		#endif
+		
+		return true;
+	}
+	catch (const structures::infeasible_exception& e) {
+		end = timing::now();
+		tc = timing::elapsed_seconds(begin, end);
+		if (m != nullptr) {
+			m->add_latency(profiling::metrics::phase::construct, tc);
+			m->add_latency(profiling::metrics::phase::grasp_iteration, tc);
+			m->add(profiling::metrics::counter::infeasible_constructions);
+		}
+		
+		#if defined (GRASP_VERBOSE)
+		std::cout
+			<< setw(8)  << "R.C."
+			<< setw(15) << " "
+			<< setw(18) << timing::elapsed_seconds(bbegin, timing::now())
+			<< setw(18) << -1
+			<< setw(12) << it
+			<< std::endl;
+
+		std::cout
+			<< setw(8)  << " "
+			<< setw(15) << "L.S."
+			<< setw(18) << timing::elapsed_seconds(bbegin, timing::now())
+			<< setw(18) << -1
+			<< setw(12) << it
+			<< std::endl;
+		#endif
+	}
+	
+	return false;
+}
+
+template<class G, class P>
+bool grasp<G,P>::finish_iteration(
+	size_t it, const structures::problem<G> *r, bool feasible, double lsc,
+	structures::problem<G> *best, double& current_best_f,
+	const timing::time_point& bbegin, bool& stop
+)
+{
+	if (feasible) {
+		if (META<G>::obs != nullptr) {
+			META<G>::obs->on_local_optimum(r, lsc);
+		}
+		
+		if (lsc > current_best_f) {
+			current_best_f = lsc;
+			best->copy(r);
+			
+			if (META<G>::obs != nullptr) {
+				META<G>::obs->on_improvement(current_best_f);
+			}
+		}
+	}
+	
+	if (META<G>::checkpoint_due(it)) {
+		if (not save_checkpoint(it, best, current_best_f, bbegin)) {
+			std::cerr << MH_ERROR << std::endl;
+			std::cerr << "    The problem does not implement 'write_solution'." << std::endl;
+			return false;
+		}
+	}
+	
+	if (META<G>::obs != nullptr) {
+		stop = not META<G>::obs->on_iteration(it, current_best_f);
+	}
+	return true;
+}
+
 // PUBLIC
 
-template<class G>
-grasp<G>::grasp
+template<class G, class P>
+grasp<G,P>::grasp
 (
 	size_t mg, size_t ml, double a,
 	const structures::local_search_policy& lsp
@@ -61,75 +287,91 @@ grasp<G>::grasp
 
 // SETTERS
 
-template<class G>
-void grasp<G>::set_local_search_policy(const structures::local_search_policy& lsp) {
+template<class G, class P>
+void grasp<G,P>::set_local_search_policy(const structures::local_search_policy& lsp) {
 	LSP = lsp;
 }
 
-template<class G>
-void grasp<G>::set_max_iterations_grasp(size_t max) {
+template<class G, class P>
+void grasp<G,P>::set_max_iterations_grasp(size_t max) {
 	MAX_ITER_GRASP = max;
 }
 
-template<class G>
-void grasp<G>::set_max_iterations_local(size_t max) {
+template<class G, class P>
+void grasp<G,P>::set_max_iterations_local(size_t max) {
 	MAX_ITER_LOCAL = max;
 }
 
-template<class G>
-void grasp<G>::reset_algorithm() {
+template<class G, class P>
+void grasp<G,P>::reset_algorithm() {
 	total_time = 0.0;
 	construct_time = 0.0;
 	local_search_time = 0.0;
 	
-	if (META<G>::seed_rng) {
-		drng.seed_random_engine();
-	}
+	META<G>::seed_generator(drng, 0);
 }
 
 // GETTERS
 
-template<class G>
-double grasp<G>::get_total_time() const {
+template<class G, class P>
+double grasp<G,P>::get_total_time() const {
 	return total_time;
 }
 
-template<class G>
-double grasp<G>::get_construct_time() const {
+template<class G, class P>
+double grasp<G,P>::get_construct_time() const {
 	return construct_time;
 }
 
-template<class G>
-double grasp<G>::get_local_search_time() const {
+template<class G, class P>
+double grasp<G,P>::get_local_search_time() const {
 	return local_search_time;
 }
 
-template<class G>
-structures::local_search_policy grasp<G>::get_local_search_policy() const {
+template<class G, class P>
+structures::local_search_policy grasp<G,P>::get_local_search_policy() const {
 	return LSP;
 }
 
-template<class G>
-size_t grasp<G>::get_max_iterations_grasp() const {
+template<class G, class P>
+size_t grasp<G,P>::get_max_iterations_grasp() const {
 	return MAX_ITER_GRASP;
 }
 
-template<class G>
-size_t grasp<G>::get_max_iterations_local() const {
+template<class G, class P>
+size_t grasp<G,P>::get_max_iterations_local() const {
 	return MAX_ITER_LOCAL;
 }
 
-template<class G>
-bool grasp<G>::execute_algorithm(structures::problem<G> *best, double& current_best_f) {
+template<class G, class P>
+bool grasp<G,P>::execute_algorithm(structures::problem<G> *best, double& current_best_f) {
+	// the solutions are constructed as instances of P
+	assert(dynamic_cast<P *>(best) != nullptr);
+	
 	// set algorithm to its initial state
 	reset_algorithm();
 	
+	// wall time of the execution, for the metrics
+	profiling::metrics::scope wall(META<G>::stats);
+	
+	// the solutions constructed, and the neighbours explored by
+	// the local search, are recycled through the pool
+	META<G>::prepare_solutions();
+	
 	// timing variables
-	timing::time_point bbegin, bend, begin, end;
+	timing::time_point bbegin, bend;
 	
-	local_search<G> ls(MAX_ITER_LOCAL, LSP);
 	current_best_f = -std::numeric_limits<double>::max();
 	
+	// iteration from which the execution starts
+	size_t first_it = 1;
+	if (not META<G>::resume_file.empty()) {
+		if (not load_checkpoint(first_it, best, current_best_f)) {
+			return false;
+		}
+		++first_it;
+	}
+	
 	#if defined (GRASP_VERBOSE)
 	std::cout
 		<< setw(8)  << "GRASP"
@@ -140,111 +382,112 @@ bool grasp<G>::execute_algorithm(structures::problem<G> *best, double& current_b
 		<< std::endl;
 	#endif
 	
+	// the observer may stop the execution at the end of any iteration
+	bool stop = false;
+	
 	bbegin = timing::now();
-	for (size_t it = 1; it <= MAX_ITER_GRASP; ++it) {
-		structures::problem<G> *r = best->empty();
+	if (META<G>::pool == nullptr) {
+		local_search<G,P> ls(MAX_ITER_LOCAL, LSP);
+		ls.set_metrics(META<G>::stats);
+		ls.set_problem_pool(META<G>::solutions);
 		
-		try {
-			begin = timing::now();
-			double rcc = r->random_construct(&drng, alpha);
-			end = timing::now();
-			construct_time += timing::elapsed_seconds(begin, end);
-			
-			#if defined (GRASP_DEBUG)
-			if (not r->sanity_check(std::cerr)) {
-				std::cerr << MH_ERROR << std::endl;
-				std::cerr << "    Sanity check failed on solution returned by 'random_construct'." << std::endl;
-				r->print(std::cerr, "");
+		for (size_t it = first_it; it <= MAX_ITER_GRASP and not stop; ++it) {
+			bool allocated = false;
+			structures::problem<G> *r = META<G>::solutions->acquire_empty(best, &allocated);
+			if (allocated) {
+				META<G>::record(profiling::metrics::counter::allocations);
 			}
-			#endif
 			
-			#if defined (GRASP_VERBOSE)
-			if (rcc > current_best_f) {
-				std::cout << setw(8) << "**R.C.";
+			double lsc, tc, tl;
+			const bool feasible = execute_iteration(
+				it, r, drng, ls, META<G>::stats, current_best_f, bbegin, lsc, tc, tl
+			);
+			construct_time += tc;
+			local_search_time += tl;
+			
+			const bool ok = finish_iteration(
+				it, r, feasible, lsc, best, current_best_f, bbegin, stop
+			);
+			META<G>::solutions->release(r);
+			if (not ok) {
+				return false;
 			}
-			else {
-				std::cout << setw(8) << "R.C.";
+		}
+	}
+	else {
+		// as many iterations as threads are executed at the same
+		// time, and their results are kept in the order of the
+		// iterations, as in a sequential execution
+		const size_t n_threads = META<G>::pool->size();
+		
+		// the solutions of the iterations are acquired and released
+		// by this thread, and reused by all the groups of iterations
+		std::vector<structures::problem<G> *> r(n_threads);
+		for (size_t k = 0; k < n_threads; ++k) {
+			bool allocated = false;
+			r[k] = META<G>::solutions->acquire_empty(best, &allocated);
+			if (allocated) {
+				META<G>::record(profiling::metrics::counter::allocations);
 			}
-
-			std::cout
-				<< setw(15) << " "
-				<< setw(18) << timing::elapsed_seconds(bbegin, timing::now())
-				<< setw(18) << rcc
-				<< setw(12) << it
-				<< std::endl;
-			#endif
+		}
+		std::vector<char> feasible(n_threads);
+		std::vector<double> lsc(n_threads), tc(n_threads), tl(n_threads);
+		
+		bool ok = true;
+		for (size_t it = first_it; it <= MAX_ITER_GRASP and not stop and ok; it += n_threads) {
+			const size_t n = std::min(n_threads, MAX_ITER_GRASP - it + 1);
 			
-			double lsc = rcc;
-			begin = timing::now();
-			ls.execute_algorithm(r, lsc);
-			end = timing::now();
-			local_search_time += timing::elapsed_seconds(begin, end);
+			// the metrics can only be modified by one thread
+			std::vector<profiling::metrics> ms(META<G>::stats != nullptr ? n : 0);
 			
-			#if defined (GRASP_DEBUG)
-			if (not r->sanity_check(std::cerr)) {
-				std::cerr << MH_ERROR << std::endl;
-				std::cerr << "Sanity check failed on solution returned by local search algorithm." << std::endl;
-				r->print(std::cerr, "");
-			}
-			#endif
+			META<G>::pool->parallel_for(0, n,
+				[&](size_t k) -> void {
+					random::drandom_generator<G,size_t> rng;
+					seed_iteration(rng, it + k);
+					
+					profiling::metrics *m = (ms.size() > 0 ? &ms[k] : nullptr);
+					local_search<G,P> ls(MAX_ITER_LOCAL, LSP);
+					ls.set_metrics(m);
+					ls.set_problem_pool(META<G>::solutions);
+					
+					// the solution of the previous group of iterations
+					r[k]->clear();
+					feasible[k] = execute_iteration(
+						it + k, r[k], rng, ls, m, current_best_f, bbegin,
+						lsc[k], tc[k], tl[k]
+					);
+				},
+				1
+			);
 			
-			#if defined (GRASP_VERBOSE)
-			if (lsc > rcc and lsc != numeric_limits<double>::max()) {
-				std::cout << setw(8) << " ";
-
-				if (lsc > current_best_f) {
-					std::cout << setw(15) << "**L.S.";
+			for (size_t k = 0; k < n and ok and not stop; ++k) {
+				if (ms.size() > 0) {
+					META<G>::stats->merge(ms[k]);
 				}
-				else {
-					std::cout << setw(15) << "L.S.";
-				}
-
-				std::cout
-					<< setw(18) << timing::elapsed_seconds(bbegin, timing::now())
-					<< setw(18) << lsc
-					<< setw(12) << it
-					<< std::endl;
-			}
-			#endif
-			
-			if (lsc > current_best_f) {
-				current_best_f = lsc;
-				best->copy(r);
+				construct_time += tc[k];
+				local_search_time += tl[k];
+				
+				ok = finish_iteration(
+					it + k, r[k], feasible[k], lsc[k], best, current_best_f, bbegin, stop
+				);
 			}
 		}
-		catch (const structures::infeasible_exception& e) {
-			end = timing::now();
-			construct_time += timing::elapsed_seconds(begin, end);
-			
-			#if defined (GRASP_VERBOSE)
-			std::cout
-				<< setw(8)  << "R.C."
-				<< setw(15) << " "
-				<< setw(18) << timing::elapsed_seconds(bbegin, timing::now())
-				<< setw(18) << -1
-				<< setw(12) << it
-				<< std::endl;
-
-			std::cout
-				<< setw(8)  << " "
-				<< setw(15) << "L.S."
-				<< setw(18) << timing::elapsed_seconds(bbegin, timing::now())
-				<< setw(18) << -1
-				<< setw(12) << it
-				<< std::endl;
-			#endif
-		}
 		
-		delete r;
+		for (size_t k = 0; k < n_threads; ++k) {
+			META<G>::solutions->release(r[k]);
+		}
+		if (not ok) {
+			return false;
+		}
 	}
 	bend = timing::now();
-	total_time = timing::elapsed_seconds(bbegin, bend);
+	total_time += timing::elapsed_seconds(bbegin, bend);
 	
-	return true;
+	return META<G>::finish_checkpoints();
 }
 
-template<class G>
-void grasp<G>::print_performance() const {
+template<class G, class P>
+void grasp<G,P>::print_performance() const {
 	std::cout << "GRASP metaheuristic performance (for a total of " << MAX_ITER_GRASP << " iterations):" << std::endl;
 	std::cout << "    Total execution time:      " << total_time << " s" << std::endl;
 	std::cout << "    Average iteration time:    " << total_time/MAX_ITER_GRASP << " s" << std::endl;
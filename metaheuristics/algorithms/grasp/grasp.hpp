@@ -32,6 +32,8 @@
 #include <metaheuristics/random/random_generator.hpp>
 #include <metaheuristics/structures/policies.hpp>
 #include <metaheuristics/structures/problem.hpp>
+#include <metaheuristics/misc/checkpoint.hpp>
+#include <metaheuristics/misc/time.hpp>
 
 namespace metaheuristics {
 namespace algorithms {
@@ -90,18 +92,48 @@ namespace algorithms {
  * - @ref problem::empty
  * - @ref problem::random_construct
  * - @ref problem::copy
+ * - @ref problem::clear
  * 
  * In case the flag GRASP_DEBUG is defined then these other
  * methods are also required:
  * - @ref problem::sanity_check
  * - @ref problem::print
  * 
+ * The state of the algorithm (the number of iterations done, the best
+ * solution found, the random number generator and the timers) can be
+ * saved periodically and the execution resumed later (see
+ * @ref metaheuristic::set_checkpointing and
+ * @ref metaheuristic::set_resume_file). This requires the implementation
+ * of the methods @ref problem::write_solution and
+ * @ref problem::read_solution.
+ * 
+ * The progress of the algorithm can also be followed at run time with
+ * an @ref observer (see @ref metaheuristic::set_observer). The local
+ * search procedure executed in every iteration is not observed, but
+ * its result is notified with @ref observer::on_local_optimum.
+ * 
+ * If a thread pool is given (see @ref metaheuristic::set_thread_pool)
+ * as many iterations as threads in the pool are executed at the same
+ * time. Each iteration then uses its own random number generator,
+ * seeded with the seed of the algorithm and the index of the
+ * iteration, so the result does not depend on the number of threads
+ * (but differs from the result of a sequential execution). The
+ * observer is notified, and the checkpoints are written, in the
+ * order of the iterations. The times of construction and of local
+ * search are the sum of the times of all threads.
+ * 
  * The local search procedure also has its own compilation flags.
  * See @ref local_search for details.
  * @param G The type of the engine of the random generator (see metaheuristics::drng).
+ * @param P The class of the solutions of the problem. If @e P is the
+ * (final) class implementing the problem, its @ref problem::random_construct
+ * is called directly instead of through the virtual interface, and so is
+ * @ref problem::best_neighbour in the local search. The default is the
+ * interface @ref structures::problem.
  */
 template<
-	class G = std::default_random_engine
+	class G = std::default_random_engine,
+	class P = structures::problem<G>
 >
 class grasp : public metaheuristic<G> {
 	public:
@@ -233,6 +265,86 @@ class grasp : public metaheuristic<G> {
 		double alpha = 1.0;
 		/// Policy for the Local Search procedure.
 		structures::local_search_policy LSP;
+
+	private:
+		/**
+		 * @brief Seeds the generator of iteration @e it.
+		 * 
+		 * Used when the iterations are executed in parallel. The
+		 * generator is seeded with @ref metaheuristic::seed_value and
+		 * stream @e it, or with a non-deterministic seed if the
+		 * algorithm was seeded without a fixed value.
+		 */
+		void seed_iteration(random::drandom_generator<G,size_t>& rng, size_t it) const;
+		/**
+		 * @brief Executes the @e it-th iteration.
+		 * 
+		 * Constructs a random solution and improves it with the
+		 * local search procedure. Can be called by several threads
+		 * at the same time if every call has its own parameters.
+		 * @param it The index of the iteration.
+		 * @param[out] r An empty solution. At the end, the solution
+		 * found in this iteration.
+		 * @param rng The random number generator used for the construction.
+		 * @param ls The local search procedure.
+		 * @param[out] m Metrics of the iteration. Can be null.
+		 * @param current_best_f The cost of the best solution so far.
+		 * @param bbegin The moment the execution started.
+		 * @param[out] lsc The cost of @e r.
+		 * @param[out] tc Time spent on the construction.
+		 * @param[out] tl Time spent on the local search.
+		 * @returns Returns false if the solution constructed was infeasible.
+		 */
+		bool execute_iteration(
+			size_t it, structures::problem<G> *r,
+			random::drandom_generator<G,size_t>& rng, local_search<G,P>& ls,
+			profiling::metrics *m, double current_best_f,
+			const timing::time_point& bbegin,
+			double& lsc, double& tc, double& tl
+		) const;
+		/**
+		 * @brief Finishes the @e it-th iteration.
+		 * 
+		 * Keeps the solution @e r of the iteration if it improves
+		 * the best solution, notifies the observer and writes the
+		 * checkpoint, if due.
+		 * @param it The index of the iteration.
+		 * @param r The solution found in the iteration.
+		 * @param feasible Is @e r feasible?
+		 * @param lsc The cost of @e r.
+		 * @param[out] best The best solution found so far.
+		 * @param[out] current_best_f The cost of @e best.
+		 * @param bbegin The moment the execution started.
+		 * @param[out] stop Set to true if the observer stops the execution.
+		 * @returns Returns false if the checkpoint could not be written.
+		 */
+		bool finish_iteration(
+			size_t it, const structures::problem<G> *r, bool feasible, double lsc,
+			structures::problem<G> *best, double& current_best_f,
+			const timing::time_point& bbegin, bool& stop
+		);
+		/**
+		 * @brief Writes a checkpoint after iteration @e it.
+		 * @param it The iteration just finished.
+		 * @param best The best solution found so far.
+		 * @param best_f The cost of @e best.
+		 * @param bbegin The moment the first iteration of this
+		 * execution started, used to save the elapsed time.
+		 * @returns Returns false if @e best could not be written.
+		 */
+		bool save_checkpoint(
+			size_t it, const structures::problem<G> *best, double best_f,
+			const timing::time_point& bbegin
+		);
+		/**
+		 * @brief Restores the state saved in @ref metaheuristic::resume_file.
+		 * @param[out] it The last iteration completed before the
+		 * checkpoint was written.
+		 * @param[out] best The best solution found so far.
+		 * @param[out] best_f The cost of @e best.
+		 * @returns Returns false if the checkpoint could not be read.
+		 */
+		bool load_checkpoint(size_t& it, structures::problem<G> *best, double& best_f);
 };
 
 } // -- namespace algorithms
@@ -26,6 +26,7 @@
 #include <metaheuristics/algorithms/local_search/local_search.hpp>
 
 // C++ includes
+#include <cassert>
 #include <iostream>
 #if defined (LOCAL_SEARCH_VERBOSE)
 #include <iomanip>
@@ -42,8 +43,8 @@ namespace algorithms {
 
 // PUBLIC
 
-template<class G>
-local_search<G>::local_search(
+template<class G, class P>
+local_search<G,P>::local_search(
 	size_t max, const structures::local_search_policy& lsp
 )
 : metaheuristic<G>()
@@ -55,18 +56,18 @@ local_search<G>::local_search(
 
 // SETTERS
 
-template<class G>
-void local_search<G>::set_local_search_policy(const structures::local_search_policy& lsp) {
+template<class G, class P>
+void local_search<G,P>::set_local_search_policy(const structures::local_search_policy& lsp) {
 	LSP = lsp;
 }
 
-template<class G>
-void local_search<G>::set_max_iterations(size_t max) {
+template<class G, class P>
+void local_search<G,P>::set_max_iterations(size_t max) {
 	MAX_ITER = max;
 }
 
-template<class G>
-void local_search<G>::reset_algorithm() {
+template<class G, class P>
+void local_search<G,P>::reset_algorithm() {
 	total_time = 0.0;
 	neighbourhood_time = 0.0;
 	ITERATION = 1;
@@ -74,36 +75,51 @@ void local_search<G>::reset_algorithm() {
 
 // GETTERS
 
-template<class G>
-double local_search<G>::get_total_time() const {
+template<class G, class P>
+double local_search<G,P>::get_total_time() const {
 	return total_time;
 }
 
-template<class G>
-double local_search<G>::get_neighbourhood_time() const {
+template<class G, class P>
+double local_search<G,P>::get_neighbourhood_time() const {
 	return neighbourhood_time;
 }
 
-template<class G>
-size_t local_search<G>::get_n_iterations() const {
+template<class G, class P>
+size_t local_search<G,P>::get_n_iterations() const {
 	return ITERATION;
 }
 
-template<class G>
-structures::local_search_policy local_search<G>::get_local_search_policy() const {
+template<class G, class P>
+structures::local_search_policy local_search<G,P>::get_local_search_policy() const {
 	return LSP;
 }
 
-template<class G>
-size_t local_search<G>::get_max_iterations() const {
+template<class G, class P>
+size_t local_search<G,P>::get_max_iterations() const {
 	return MAX_ITER;
 }
 
-template<class G>
-bool local_search<G>::execute_algorithm(structures::problem<G> *best, double& current_best_f) {
+template<class G, class P>
+bool local_search<G,P>::execute_algorithm(structures::problem<G> *best, double& current_best_f) {
+	// the neighbourhood is explored as an instance of P
+	assert(dynamic_cast<P *>(best) != nullptr);
+	
 	// set the algorithm to its initial state
 	reset_algorithm();
 	
+	// wall time of the execution, for the metrics
+	profiling::metrics::scope wall(META<G>::stats);
+	
+	// the neighbours are recycled through the pool, also those
+	// that best_neighbour discards (see problem::acquire_neighbour)
+	META<G>::prepare_solutions();
+	struct pool_scope {
+		structures::problem<G> *p;
+		~pool_scope() { p->set_neighbour_pool(nullptr); }
+	} neighbour_pool{best};
+	best->set_neighbour_pool(META<G>::solutions);
+	
 	#if defined (LOCAL_SEARCH_VERBOSE)
 	std::cout
 		<< setw(8)  << " "
@@ -135,11 +151,25 @@ bool local_search<G>::execute_algorithm(structures::problem<G> *best, double& cu
 		neighbour.first = nullptr;
 		neighbour.second = current_best_f;
 		
+		const size_t n_allocated = best->get_n_neighbours_allocated();
 		begin = timing::now();
-		best->best_neighbour(neighbour, LSP);
+		static_cast<P *>(best)->best_neighbour(neighbour, LSP);
 		end = timing::now();
 		neighbourhood_time += timing::elapsed_seconds(begin, end);
 		
+		if (META<G>::stats != nullptr) {
+			META<G>::stats->add(profiling::metrics::counter::local_search_iterations);
+			META<G>::stats->add(
+				profiling::metrics::counter::allocations,
+				best->get_n_neighbours_allocated() - n_allocated
+			);
+			META<G>::stats->add_latency(
+				profiling::metrics::phase::neighbourhood,
+				timing::elapsed_seconds(begin, end)
+			);
+			META<G>::stats->add_neighbours(best->get_n_neighbours_explored());
+		}
+		
 		if (neighbour.first != nullptr) {
 			
 			#if defined (LOCAL_SEARCH_DEBUG)
@@ -165,27 +195,40 @@ bool local_search<G>::execute_algorithm(structures::problem<G> *best, double& cu
 				#endif
 				
 				best->copy(neighbour.first);
+				
+				if (META<G>::obs != nullptr) {
+					META<G>::obs->on_improvement(current_best_f);
+				}
 			}
 			else {
 				improvement = false;
 			}
 			
-			delete neighbour.first;
+			META<G>::solutions->release(neighbour.first);
 		}
 		else {
 			improvement = false;
 		}
 		
+		if (META<G>::obs != nullptr and improvement) {
+			improvement = META<G>::obs->on_iteration(ITERATION, current_best_f);
+		}
+		
 		++ITERATION;
 	}
+	
+	if (META<G>::obs != nullptr) {
+		META<G>::obs->on_local_optimum(best, current_best_f);
+	}
 	bend = timing::now();
 	total_time = timing::elapsed_seconds(bbegin, bend);
+	META<G>::record_latency(profiling::metrics::phase::local_search, total_time);
 	
 	return true;
 }
 
-template<class G>
-void local_search<G>::print_performance() const {
+template<class G, class P>
+void local_search<G,P>::print_performance() const {
 	std::cout << "Local Search algorithm performance:" << std::endl;
 	std::cout << "    Number of iterations:                   " << ITERATION << std::endl;
 	std::cout << "    Total execution time:                   " << total_time << " s" << std::endl;
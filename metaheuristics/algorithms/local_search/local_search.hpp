@@ -70,9 +70,18 @@ namespace algorithms {
 	\endverbatim
  * to run the sanity check on every "best neighbour" found.
  * 
+ * The progress of the algorithm can also be followed at run time with
+ * an @ref observer (see @ref metaheuristic::set_observer).
+ * 
  * This class needs the implementation of the following methods:
  * - @ref problem::best_neighbour
  * - @ref problem::copy
+ * - @ref problem::clear
+ * 
+ * While the neighbourhood is explored, the solution is given the pool
+ * of solutions of the algorithm (see @ref problem::set_neighbour_pool),
+ * so that the neighbours made with @ref problem::acquire_neighbour are
+ * recycled instead of allocated and freed.
  * 
  * In case the flag LOCAL_SEARCH_DEBUG is defined then these other
  * methods are also required:
@@ -80,9 +89,14 @@ namespace algorithms {
  * - @ref problem::print
  * 
  * @param G The type of the engine of the random generator (see metaheuristics::drng).
+ * @param P The class of the solutions of the problem. If @e P is the
+ * (final) class implementing the problem, its @ref problem::best_neighbour
+ * is called directly instead of through the virtual interface. The
+ * default is the interface @ref structures::problem.
  */
 template<
-	class G = std::default_random_engine
+	class G = std::default_random_engine,
+	class P = structures::problem<G>
 >
 class local_search : public metaheuristic<G> {
 	public:
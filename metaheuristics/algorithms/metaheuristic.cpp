@@ -25,6 +25,12 @@
 
 #include <metaheuristics/algorithms/metaheuristic.hpp>
 
+// C++ includes
+#include <iostream>
+
+// metaheuristics includes
+#include <metaheuristics/macros.hpp>
+
 namespace metaheuristics {
 namespace algorithms {
 
@@ -33,6 +39,118 @@ namespace algorithms {
 template<class G>
 void metaheuristic<G>::seed() {
 	seed_rng = true;
+	seed_fixed = false;
+}
+
+template<class G>
+void metaheuristic<G>::seed(uint64_t s) {
+	seed_rng = true;
+	seed_fixed = true;
+	seed_value = s;
+}
+
+template<class G>
+void metaheuristic<G>::set_checkpointing(const std::string& f, size_t period) {
+	checkpoint_file = f;
+	checkpoint_period = period;
+}
+
+template<class G>
+void metaheuristic<G>::set_resume_file(const std::string& f) {
+	resume_file = f;
+}
+
+template<class G>
+void metaheuristic<G>::set_observer(observer<G> *o) {
+	obs = o;
+}
+
+template<class G>
+void metaheuristic<G>::set_metrics(profiling::metrics *m) {
+	stats = m;
+}
+
+template<class G>
+void metaheuristic<G>::set_thread_pool(concurrency::thread_pool *p) {
+	pool = p;
+}
+
+template<class G>
+void metaheuristic<G>::set_problem_pool(structures::problem_pool<G> *p) {
+	solutions = (p == nullptr ? &own_solutions : p);
+}
+
+// GETTERS
+
+template<class G>
+observer<G> *metaheuristic<G>::get_observer() const {
+	return obs;
+}
+
+// PROTECTED
+
+template<class G>
+template<class RNG>
+void metaheuristic<G>::seed_generator(RNG& r, uint64_t stream) const {
+	if (not seed_rng) {
+		return;
+	}
+	if (seed_fixed) {
+		r.seed_random_engine(seed_value, stream);
+	}
+	else {
+		r.seed_random_engine();
+	}
+}
+
+template<class G>
+void metaheuristic<G>::prepare_solutions() {
+	if (solutions == &own_solutions) {
+		own_solutions.clear();
+	}
+}
+
+template<class G>
+bool metaheuristic<G>::checkpoint_due(size_t s) const {
+	return checkpoint_period > 0 and s%checkpoint_period == 0;
+}
+
+template<class G>
+void metaheuristic<G>::write_checkpoint(std::string&& data) {
+	checkpoint_writer.write(checkpoint_file, std::move(data));
+}
+
+template<class G>
+bool metaheuristic<G>::finish_checkpoints() {
+	checkpoint_writer.wait();
+	if (not checkpoint_writer.last_write_succeeded()) {
+		std::cerr << MH_ERROR << std::endl;
+		std::cerr << "    Could not write checkpoint file '"
+				  << checkpoint_file << "'" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+template<class G>
+bool metaheuristic<G>::open_resume_file
+(std::ifstream& fin, const checkpointing::algorithm_tag& t)
+{
+	const std::string f = resume_file;
+	resume_file.clear();
+	
+	fin.open(f.c_str(), std::ios::binary);
+	if (not fin.is_open()) {
+		std::cerr << MH_ERROR << std::endl;
+		std::cerr << "    Could not open checkpoint file '" << f << "'" << std::endl;
+		return false;
+	}
+	if (not checkpointing::read_header(fin, t)) {
+		std::cerr << MH_ERROR << std::endl;
+		std::cerr << "    File '" << f << "' is not a valid checkpoint for this algorithm" << std::endl;
+		return false;
+	}
+	return true;
 }
 
 } // -- namespace algorithms
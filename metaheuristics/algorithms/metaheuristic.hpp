@@ -23,8 +23,18 @@
 
 #pragma once
 
+// C++ includes
+#include <fstream>
+#include <cstdint>
+#include <string>
+
 // metaheuristic includes
+#include <metaheuristics/algorithms/observer.hpp>
+#include <metaheuristics/structures/problem_pool.hpp>
 #include <metaheuristics/structures/problem.hpp>
+#include <metaheuristics/misc/checkpoint.hpp>
+#include <metaheuristics/misc/metrics.hpp>
+#include <metaheuristics/misc/thread_pool.hpp>
 
 namespace metaheuristics {
 namespace algorithms {
@@ -34,6 +44,17 @@ namespace algorithms {
  * 
  * Common variables are:
  * - @ref seed_rng : whether the random generators should be seeded or not.
+ * - @ref seed_fixed, @ref seed_value : whether they are seeded with a
+ * fixed value, so that executions are reproducible.
+ * - @ref checkpoint_file, @ref checkpoint_period : where and how often
+ * the state of the algorithm is saved.
+ * - @ref resume_file : the checkpoint from which the next execution
+ * is resumed.
+ * - @ref obs : the observer notified of the progress of the execution.
+ * - @ref stats : the performance metrics collected during the execution.
+ * - @ref pool : the threads used to execute the algorithm.
+ * - @ref solutions : where the solutions allocated by the algorithm
+ * are recycled.
  * 
  * The methods to implement for are:
  * - @ref reset_algorithm : sets the algorithm to its initial state.
@@ -60,9 +81,95 @@ class metaheuristic {
 		/**
 		 * @brief Seed the random number generators.
 		 * 
-		 * Sets variable @ref seed_rng to true.
+		 * Sets variable @ref seed_rng to true. The seeds are
+		 * non-deterministic.
 		 */
 		void seed();
+		/**
+		 * @brief Seed the random number generators with value @e s.
+		 * 
+		 * Sets variables @ref seed_rng and @ref seed_fixed to true.
+		 * Two executions of an algorithm with the same parameters
+		 * and the same seed are identical.
+		 */
+		void seed(uint64_t s);
+		
+		/**
+		 * @brief Saves the state of the algorithm periodically.
+		 * 
+		 * Every @e period generations (or iterations) the state of the
+		 * algorithm is written into file @e f. The state is copied
+		 * during the execution but the file is written in a background
+		 * thread. A period of 0 disables checkpointing (the default).
+		 * 
+		 * Only the algorithms that implement checkpoints (the genetic
+		 * algorithms and GRASP) use these values.
+		 */
+		void set_checkpointing(const std::string& f, size_t period);
+		/**
+		 * @brief Resumes the next execution from a checkpoint.
+		 * 
+		 * The next call to @ref execute_algorithm continues the
+		 * execution saved in file @e f, instead of starting from
+		 * scratch. The parameters of the algorithm must be the same
+		 * as those of the execution that wrote the checkpoint, except
+		 * for the number of iterations, which can be larger.
+		 */
+		void set_resume_file(const std::string& f);
+		
+		/**
+		 * @brief Sets the observer of the execution.
+		 * 
+		 * The observer is notified of the progress of the algorithm
+		 * (see @ref observer). It is not owned by the algorithm, and
+		 * must outlive the executions. Pass nullptr (the default) to
+		 * disable it.
+		 */
+		void set_observer(observer<G> *o);
+		
+		/**
+		 * @brief Sets where the performance metrics are collected.
+		 * 
+		 * The metrics are not owned by the algorithm, and must outlive
+		 * the executions. They are accumulated over all the executions
+		 * until they are cleared (see @ref profiling::metrics::clear).
+		 * Pass nullptr (the default) to disable their collection.
+		 */
+		void set_metrics(profiling::metrics *m);
+		
+		/**
+		 * @brief Sets the threads used to execute the algorithm.
+		 * 
+		 * The pool is not owned by the algorithm, and must outlive
+		 * the executions. The same pool can be given to several
+		 * algorithms, even if they are executed at the same time.
+		 * Pass nullptr (the default) to execute the algorithm in
+		 * the calling thread only.
+		 * 
+		 * Only the genetic algorithms (which evaluate the individuals
+		 * of a generation in parallel) and GRASP (which executes
+		 * several iterations in parallel) use the pool. The methods
+		 * of the problem must then be safe to call on different
+		 * objects at the same time.
+		 */
+		void set_thread_pool(concurrency::thread_pool *p);
+		
+		/**
+		 * @brief Sets where the solutions allocated by the algorithm are recycled.
+		 * 
+		 * By default, every algorithm uses a pool of its own, which is
+		 * emptied at the beginning of every execution. A pool given
+		 * with this method is not owned by the algorithm, must outlive
+		 * the executions and is never emptied by the algorithm: all the
+		 * executions that use it must solve the same instance of the
+		 * problem. Pass nullptr to use the algorithm's own pool again.
+		 */
+		void set_problem_pool(structures::problem_pool<G> *p);
+		
+		// GETTERS
+		
+		/// Returns the observer of the execution (see @ref set_observer).
+		observer<G> *get_observer() const;
 		
 		/**
 		 * @brief Sets the algorithm to its original state.
@@ -83,6 +190,86 @@ class metaheuristic {
 	protected:
 		/// Variable telling whether the number generators should be seeded or not.
 		bool seed_rng = false;
+		/// Are the number generators seeded with @ref seed_value?
+		bool seed_fixed = false;
+		/// Seed of the number generators, if @ref seed_fixed.
+		uint64_t seed_value = 0;
+		
+		/// File where the checkpoints are written.
+		std::string checkpoint_file;
+		/// Number of generations (or iterations) between two checkpoints.
+		size_t checkpoint_period = 0;
+		/// Checkpoint from which the next execution is resumed.
+		std::string resume_file;
+		/// Writes the checkpoints into @ref checkpoint_file.
+		checkpointing::async_writer checkpoint_writer;
+		
+		/// Observer of the execution (not owned). Null if disabled.
+		observer<G> *obs = nullptr;
+		/// Performance metrics (not owned). Null if disabled.
+		profiling::metrics *stats = nullptr;
+		/// Threads executing the algorithm (not owned). Null if disabled.
+		concurrency::thread_pool *pool = nullptr;
+		
+		/// Pool of solutions owned by the algorithm.
+		structures::problem_pool<G> own_solutions;
+		/// Pool of solutions used by the algorithm: either @ref own_solutions or a pool not owned.
+		structures::problem_pool<G> *solutions = &own_solutions;
+		
+	protected:
+		/**
+		 * @brief Seeds the random number generator @e r.
+		 * 
+		 * Does nothing if @ref seed_rng is false. Otherwise, uses a
+		 * non-deterministic seed or, if @ref seed_fixed is true,
+		 * @ref seed_value. Each generator of an algorithm must use a
+		 * different @e stream.
+		 */
+		template<class RNG>
+		void seed_generator(RNG& r, uint64_t stream) const;
+		
+		/// Adds @e n to counter @e c of @ref stats, if not null.
+		inline void record(const profiling::metrics::counter& c, uint64_t n = 1) const {
+			if (stats != nullptr) {
+				stats->add(c, n);
+			}
+		}
+		/// Adds the latency @e s of phase @e p to @ref stats, if not null.
+		inline void record_latency(const profiling::metrics::phase& p, double s) const {
+			if (stats != nullptr) {
+				stats->add_latency(p, s);
+			}
+		}
+		
+		/**
+		 * @brief Prepares the pool of solutions for a new execution.
+		 * 
+		 * Empties @ref own_solutions if it is the pool used, since it
+		 * may keep solutions of the instance of a previous execution.
+		 */
+		void prepare_solutions();
+		
+		/// Returns true if a checkpoint is due after generation (or iteration) @e s.
+		bool checkpoint_due(size_t s) const;
+		/// Writes the serialised state @e data into @ref checkpoint_file.
+		void write_checkpoint(std::string&& data);
+		/**
+		 * @brief Waits for the last checkpoint to be written.
+		 * @returns Returns false if the last checkpoint could not be
+		 * written.
+		 */
+		bool finish_checkpoints();
+		/**
+		 * @brief Opens the checkpoint in @ref resume_file.
+		 * 
+		 * Also reads and validates its header. Variable @ref resume_file
+		 * is cleared so that the following executions start from scratch.
+		 * @param[out] fin Stream positioned right after the header.
+		 * @param[in] t The algorithm that should have written the checkpoint.
+		 * @returns Returns false if the file could not be opened or
+		 * the header is not valid.
+		 */
+		bool open_resume_file(std::ifstream& fin, const checkpointing::algorithm_tag& t);
 };
 
 /// Shorthand for the genetic_algorithm class template
@@ -0,0 +1,62 @@
+/*********************************************************************
+ *
+ * Collection of heuristic and metaheuristic algorithms
+ *
+ * Copyright (C) 2018-2020  Lluís Alemany Puig
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Contact: Lluís Alemany Puig (lluis.alemany.puig@gmail.com)
+ * 
+ *********************************************************************/
+
+#pragma once
+
+#include <metaheuristics/algorithms/observer.hpp>
+
+namespace metaheuristics {
+namespace algorithms {
+
+// PUBLIC
+
+template<class G>
+bool observer<G>::on_generation(const genetic_algorithm<G,double>&, size_t, double) {
+	return true;
+}
+
+template<class G>
+bool observer<G>::on_generation(const genetic_algorithm<G,float>&, size_t, double) {
+	return true;
+}
+
+template<class G>
+bool observer<G>::on_generation
+(const genetic_algorithm<G,structures::fixed16>&, size_t, double)
+{
+	return true;
+}
+
+template<class G>
+bool observer<G>::on_iteration(size_t, double) {
+	return true;
+}
+
+template<class G>
+void observer<G>::on_improvement(double) { }
+
+template<class G>
+void observer<G>::on_local_optimum(const structures::problem<G> *, double) { }
+
+} // -- namespace algorithms
+} // -- namespace metaheuristics
@@ -0,0 +1,121 @@
+/*********************************************************************
+ *
+ * Collection of heuristic and metaheuristic algorithms
+ *
+ * Copyright (C) 2018-2020  Lluís Alemany Puig
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Contact: Lluís Alemany Puig (lluis.alemany.puig@gmail.com)
+ * 
+ *********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <random>
+
+// metaheuristics includes
+#include <metaheuristics/structures/fixed16.hpp>
+#include <metaheuristics/structures/problem.hpp>
+
+namespace metaheuristics {
+namespace algorithms {
+
+template<class G, typename T>
+class genetic_algorithm;
+
+/**
+ * @brief Observer of the execution of an algorithm.
+ * 
+ * An observer is notified of the progress of an algorithm at run time,
+ * which allows streaming telemetry, plotting the convergence of the
+ * algorithm, or implementing stopping rules without recompiling the
+ * library with the verbose macros.
+ * 
+ * Derive from this class and override the events needed. By default
+ * every event does nothing and never stops the algorithm.
+ * 
+ * The events are:
+ * - @ref on_generation : after every generation of a genetic algorithm.
+ * The initial population is notified as generation 0.
+ * - @ref on_iteration : after every iteration of GRASP and of the
+ * local search.
+ * - @ref on_improvement : every time the best solution found improves.
+ * - @ref on_local_optimum : every time a local search procedure finishes.
+ * 
+ * The events returning a boolean value can stop the execution: the
+ * algorithm stops as soon as one of them returns false, and finishes
+ * as if it had reached its maximum number of iterations.
+ * 
+ * Set the observer of an algorithm with @ref metaheuristic::set_observer.
+ * Algorithms without an observer only check a null pointer once per
+ * generation (or iteration).
+ * 
+ * @param G The type of engine used by the random number generators.
+ */
+template<
+	class G = std::default_random_engine
+>
+class observer {
+	public:
+		/// Default constructor.
+		observer() = default;
+		/// Destructor.
+		virtual ~observer() = default;
+		
+		/**
+		 * @brief Called after every generation of a genetic algorithm.
+		 * @param ga The algorithm. Its population is the new generation.
+		 * @param g The index of the generation.
+		 * @param best The largest fitness in the population.
+		 * @returns Returns false to stop the algorithm.
+		 */
+		virtual bool on_generation
+		(const genetic_algorithm<G,double>& ga, size_t g, double best);
+		/// Called after every generation of a genetic algorithm with genes of type float.
+		virtual bool on_generation
+		(const genetic_algorithm<G,float>& ga, size_t g, double best);
+		/// Called after every generation of a genetic algorithm with genes of type @ref structures::fixed16.
+		virtual bool on_generation
+		(const genetic_algorithm<G,structures::fixed16>& ga, size_t g, double best);
+		
+		/**
+		 * @brief Called after every iteration of GRASP and local search.
+		 * @param it The index of the iteration.
+		 * @param best The cost of the best solution found so far.
+		 * @returns Returns false to stop the algorithm.
+		 */
+		virtual bool on_iteration(size_t it, double best);
+		
+		/**
+		 * @brief Called when the best solution found improves.
+		 * @param best The cost of the new best solution.
+		 */
+		virtual void on_improvement(double best);
+		
+		/**
+		 * @brief Called when a local search procedure finishes.
+		 * 
+		 * In GRASP, called after the local search of every iteration.
+		 * @param p The solution found by the local search.
+		 * @param c The cost of @e p.
+		 */
+		virtual void on_local_optimum(const structures::problem<G> *p, double c);
+};
+
+} // -- namespace algorithms
+} // -- namespace metaheuristics
+
+#include <metaheuristics/algorithms/observer.cpp>
@@ -0,0 +1,277 @@
+/*********************************************************************
+ *
+ * Collection of heuristic and metaheuristic algorithms
+ *
+ * Copyright (C) 2018-2020  Lluís Alemany Puig
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Contact: Lluís Alemany Puig (lluis.alemany.puig@gmail.com)
+ * 
+ *********************************************************************/
+
+#pragma once
+
+#include <metaheuristics/algorithms/portfolio/portfolio.hpp>
+
+// C++ includes
+#include <system_error>
+#include <exception>
+#include <thread>
+
+namespace metaheuristics {
+namespace algorithms {
+
+// MEMBER OBSERVER
+
+template<class G>
+portfolio<G>::member_observer::member_observer(portfolio<G> *pf, observer<G> *o) {
+	P = pf;
+	member = o;
+}
+
+template<class G>
+bool portfolio<G>::member_observer::on_generation
+(const genetic_algorithm<G,double>& ga, size_t g, double best)
+{
+	const bool go = (member == nullptr or member->on_generation(ga, g, best));
+	return not P->must_stop() and go;
+}
+
+template<class G>
+bool portfolio<G>::member_observer::on_generation
+(const genetic_algorithm<G,float>& ga, size_t g, double best)
+{
+	const bool go = (member == nullptr or member->on_generation(ga, g, best));
+	return not P->must_stop() and go;
+}
+
+template<class G>
+bool portfolio<G>::member_observer::on_generation
+(const genetic_algorithm<G,structures::fixed16>& ga, size_t g, double best)
+{
+	const bool go = (member == nullptr or member->on_generation(ga, g, best));
+	return not P->must_stop() and go;
+}
+
+template<class G>
+bool portfolio<G>::member_observer::on_iteration(size_t it, double best) {
+	const bool go = (member == nullptr or member->on_iteration(it, best));
+	return not P->must_stop() and go;
+}
+
+template<class G>
+void portfolio<G>::member_observer::on_improvement(double best) {
+	if (member != nullptr) {
+		member->on_improvement(best);
+	}
+	P->update_incumbent(best);
+}
+
+template<class G>
+void portfolio<G>::member_observer::on_local_optimum
+(const structures::problem<G> *p, double c)
+{
+	if (member != nullptr) {
+		member->on_local_optimum(p, c);
+	}
+}
+
+// PRIVATE
+
+template<class G>
+void portfolio<G>::update_incumbent(double best) {
+	std::lock_guard<std::mutex> lock(incumbent_mutex);
+	if (has_incumbent and best <= incumbent) {
+		return;
+	}
+	
+	has_incumbent = true;
+	incumbent = best;
+	if (META<G>::obs != nullptr) {
+		META<G>::obs->on_improvement(best);
+	}
+	if (use_target and best >= target) {
+		stop = true;
+	}
+}
+
+template<class G>
+bool portfolio<G>::must_stop() {
+	if (not stop and time_budget > 0.0 and
+		timing::elapsed_seconds(begin, timing::now()) >= time_budget)
+	{
+		stop = true;
+	}
+	return stop;
+}
+
+// PUBLIC
+
+// SETTERS
+
+template<class G>
+void portfolio<G>::add_algorithm(metaheuristic<G> *a, bool improve) {
+	algorithms.push_back(a);
+	improves.push_back(improve);
+}
+
+template<class G>
+void portfolio<G>::set_time_budget(double s) {
+	time_budget = s;
+}
+
+template<class G>
+void portfolio<G>::set_target(double t) {
+	use_target = true;
+	target = t;
+}
+
+template<class G>
+void portfolio<G>::reset_algorithm() {
+	total_time = 0.0;
+	winner = algorithms.size();
+	has_incumbent = false;
+	incumbent = 0.0;
+	stop = false;
+	for (metaheuristic<G> *a : algorithms) {
+		a->reset_algorithm();
+	}
+}
+
+// GETTERS
+
+template<class G>
+double portfolio<G>::get_total_time() const {
+	return total_time;
+}
+
+template<class G>
+size_t portfolio<G>::get_winner() const {
+	return winner;
+}
+
+template<class G>
+bool portfolio<G>::was_stopped() const {
+	return stop;
+}
+
+template<class G>
+bool portfolio<G>::execute_algorithm(structures::problem<G> *p, double& c) {
+	const size_t N = algorithms.size();
+	
+	begin = timing::now();
+	winner = N;
+	has_incumbent = false;
+	incumbent = 0.0;
+	stop = false;
+	
+	// every algorithm works on its own solution
+	std::vector<structures::problem<G> *> solutions(N, nullptr);
+	std::vector<double> costs(N, c);
+	std::vector<char> finished(N, 0);
+	// exception thrown by each algorithm, if any
+	std::vector<std::exception_ptr> errors(N);
+	
+	// the observers of the algorithms are restored after the execution
+	std::vector<observer<G> *> previous(N);
+	std::vector<member_observer> observers;
+	observers.reserve(N);
+	for (size_t i = 0; i < N; ++i) {
+		previous[i] = algorithms[i]->get_observer();
+		observers.push_back(member_observer(this, previous[i]));
+	}
+	
+	// the observers are restored and the solutions deleted also when
+	// building a solution throws
+	struct members_scope {
+		std::vector<metaheuristic<G> *>& algorithms;
+		std::vector<observer<G> *>& previous;
+		std::vector<structures::problem<G> *>& solutions;
+		~members_scope() {
+			for (size_t i = 0; i < algorithms.size(); ++i) {
+				algorithms[i]->set_observer(previous[i]);
+				delete solutions[i];
+			}
+		}
+	} members{algorithms, previous, solutions};
+	
+	// no exception leaves a thread: the first one is rethrown below,
+	// after all the algorithms have stopped
+	auto run =
+	[&](size_t i) -> void {
+		try {
+			finished[i] = algorithms[i]->execute_algorithm(solutions[i], costs[i]);
+			if (finished[i]) {
+				update_incumbent(costs[i]);
+			}
+		}
+		catch (const structures::infeasible_exception&) {
+			finished[i] = false;
+		}
+		catch (...) {
+			finished[i] = false;
+			errors[i] = std::current_exception();
+			stop = true;
+		}
+	};
+	
+	for (size_t i = 0; i < N; ++i) {
+		solutions[i] = (improves[i] ? p->clone() : p->empty());
+		algorithms[i]->set_observer(&observers[i]);
+	}
+	
+	// the algorithms for which no thread could be started are
+	// executed in the calling thread, after the first one
+	std::vector<std::thread> threads;
+	threads.reserve(N);
+	size_t n_started = 1;
+	try {
+		for (; n_started < N; ++n_started) {
+			threads.push_back(std::thread(run, n_started));
+		}
+	}
+	catch (const std::system_error&) { }
+	for (size_t i = 0; i < N; ++i) {
+		if (i == 0 or i >= n_started) {
+			run(i);
+		}
+	}
+	for (std::thread& t : threads) {
+		t.join();
+	}
+	total_time = timing::elapsed_seconds(begin, timing::now());
+	
+	for (size_t i = 0; i < N; ++i) {
+		if (errors[i] != nullptr) {
+			std::rethrow_exception(errors[i]);
+		}
+	}
+	
+	// keep the best solution, the first algorithm wins the ties
+	for (size_t i = 0; i < N; ++i) {
+		if (finished[i] and (winner == N or costs[i] > costs[winner])) {
+			winner = i;
+		}
+	}
+	if (winner < N) {
+		p->copy(solutions[winner]);
+		c = costs[winner];
+	}
+	
+	return winner < N;
+}
+
+} // -- namespace algorithms
+} // -- namespace metaheuristics
@@ -0,0 +1,267 @@
+/*********************************************************************
+ *
+ * Collection of heuristic and metaheuristic algorithms
+ *
+ * Copyright (C) 2018-2020  Lluís Alemany Puig
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Contact: Lluís Alemany Puig (lluis.alemany.puig@gmail.com)
+ * 
+ *********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <random>
+#include <vector>
+#include <atomic>
+#include <mutex>
+
+// metaheursitics includes
+#include <metaheuristics/algorithms/metaheuristic.hpp>
+#include <metaheuristics/algorithms/observer.hpp>
+#include <metaheuristics/structures/problem.hpp>
+#include <metaheuristics/misc/time.hpp>
+
+namespace metaheuristics {
+namespace algorithms {
+
+/**
+ * @brief Portfolio of algorithms executed concurrently.
+ * 
+ * Given an instance of a problem @e p, with cost @e c, every algorithm
+ * added to the portfolio (see @ref add_algorithm) is executed in its
+ * own thread on its own solution: either a copy of @e p or an empty
+ * solution built with @ref problem::empty. The best solution found
+ * among all of them is returned in @e p. Which algorithm finds the best
+ * solution usually depends on the instance, and racing several of them
+ * avoids having to choose one in advance.
+ * 
+ * The algorithms share the incumbent: the cost of the best solution
+ * found so far by any of them. All the algorithms are stopped as soon
+ * as
+ * - the incumbent reaches the target (see @ref set_target), or
+ * - the time budget is exhausted (see @ref set_time_budget).
+ * 
+ * The algorithms are stopped through their observers (see
+ * @ref observer): the portfolio replaces the observer of every
+ * algorithm during the execution, and restores it afterwards.
+ * Therefore, an algorithm stops at the end of its current generation
+ * (or iteration). The observer that an algorithm had before the
+ * execution is still notified of the events of that algorithm, and can
+ * still stop it. The observer of the portfolio, if any, is notified of
+ * the improvements of the incumbent. Since the algorithms are executed
+ * concurrently, an observer shared by several algorithms, or by an
+ * algorithm and the portfolio, is notified from several threads.
+ * 
+ * Local search improves the solution it is given: if it is part of the
+ * portfolio it has to be added so that it works on a copy of @e p, and
+ * @e p must be a solution to the problem, for example, one built with
+ * @ref problem::greedy_construct. The other algorithms construct their
+ * own solutions from an empty one.
+ * 
+ * The algorithms are not owned by the portfolio, and must not be shared
+ * by two portfolios executed at the same time. Their parameters, seeds,
+ * checkpoints and metrics are set as usual, but two algorithms must not
+ * share the same metrics, nor the same checkpoint file. The progress
+ * printed when the library is compiled with the verbose flags of the
+ * algorithms is mixed.
+ * 
+ * This class needs the implementation of the following methods:
+ * - @ref problem::empty
+ * - @ref problem::clone
+ * - @ref problem::copy
+ * 
+ * as well as those needed by the algorithms of the portfolio. The
+ * copies of @e p are modified concurrently, so they must not share
+ * mutable data.
+ * 
+ * @param G The type of the engine of the random generator (see metaheuristics::drng).
+ */
+template<
+	class G = std::default_random_engine
+>
+class portfolio : public metaheuristic<G> {
+	public:
+		/// Default constructor.
+		portfolio() = default;
+		/// Destructor.
+		~portfolio() = default;
+		
+		// SETTERS
+		
+		/**
+		 * @brief Adds algorithm @e a to the portfolio.
+		 * 
+		 * The algorithm is not owned by the portfolio, and must
+		 * outlive the executions.
+		 * @param a The algorithm.
+		 * @param improve If true, the algorithm is executed on a copy
+		 * of the solution given to @ref execute_algorithm, as the local
+		 * search needs. Otherwise, it is executed on an empty solution.
+		 */
+		void add_algorithm(metaheuristic<G> *a, bool improve = false);
+		/**
+		 * @brief Sets the time budget of the execution.
+		 * 
+		 * The algorithms are stopped after @e s seconds. A budget of
+		 * 0 (the default) means that there is no time limit.
+		 */
+		void set_time_budget(double s);
+		/**
+		 * @brief Sets the target value of the execution.
+		 * 
+		 * The algorithms are stopped as soon as one of them finds a
+		 * solution with cost at least @e t. By default there is no
+		 * target.
+		 */
+		void set_target(double t);
+		/**
+		 * @brief Resets the algorithm to its initial state.
+		 * 
+		 * Resets the state of the last execution and calls the
+		 * @ref metaheuristic::reset_algorithm method of every
+		 * algorithm of the portfolio. The algorithms, the budget and
+		 * the target are not modified.
+		 */
+		void reset_algorithm();
+		
+		// GETTERS
+		
+		/**
+		 * @brief Returns the total execution time of the portfolio.
+		 * @returns Returns the value that @ref total_time has at
+		 * the end of the execution of @ref execute_algorithm().
+		 */
+		double get_total_time() const;
+		/**
+		 * @brief Returns the algorithm whose solution was returned.
+		 * @returns Returns the index, in the order in which they were
+		 * added, of the algorithm that found the solution returned by
+		 * the last execution. Returns the number of algorithms if no
+		 * algorithm finished its execution.
+		 */
+		size_t get_winner() const;
+		/**
+		 * @brief Returns whether the last execution was stopped.
+		 * @returns Returns true if the algorithms were stopped because
+		 * the target was reached or the budget was exhausted.
+		 */
+		bool was_stopped() const;
+		
+		/**
+		 * @brief Executes the algorithms of the portfolio.
+		 * 
+		 * @param[in] p The instance of the problem.
+		 * @param[in] c The cost of the instance @e p at the beginning of
+		 * the execution.
+		 * @param[out] p The best solution found by the algorithms.
+		 * @param[out] c The cost of the solution stored at @e p at the
+		 * end of the execution of the algorithm.
+		 * @returns Returns false if no algorithm finished its execution,
+		 * in which case @e p and @e c are not modified. An algorithm
+		 * does not finish if its @ref metaheuristic::execute_algorithm
+		 * returns false or throws an @ref structures::infeasible_exception.
+		 * 
+		 * If an algorithm throws any other exception, all the algorithms
+		 * are stopped and, once they have, the exception of the first of
+		 * them (in the order in which they were added) is rethrown. In
+		 * that case @e p and @e c are not modified either. The observers
+		 * of the algorithms are restored in any case.
+		 */
+		bool execute_algorithm(structures::problem<G> *p, double& c);
+
+	private:
+		/**
+		 * @brief Observer set to each algorithm during the execution.
+		 * 
+		 * Updates the incumbent and tells the algorithm to stop when
+		 * the portfolio has to stop. Forwards every event to the
+		 * observer the algorithm had before the execution, if any.
+		 */
+		class member_observer : public observer<G> {
+			public:
+				/**
+				 * @brief Constructor with the portfolio that is being executed.
+				 * @param pf The portfolio.
+				 * @param o The previous observer of the algorithm. Can be null.
+				 */
+				member_observer(portfolio<G> *pf, observer<G> *o);
+				
+				bool on_generation
+				(const genetic_algorithm<G,double>& ga, size_t g, double best);
+				bool on_generation
+				(const genetic_algorithm<G,float>& ga, size_t g, double best);
+				bool on_generation
+				(const genetic_algorithm<G,structures::fixed16>& ga, size_t g, double best);
+				bool on_iteration(size_t it, double best);
+				void on_improvement(double best);
+				void on_local_optimum(const structures::problem<G> *p, double c);
+				
+			private:
+				/// The portfolio being executed.
+				portfolio<G> *P;
+				/// The previous observer of the algorithm (not owned).
+				observer<G> *member;
+		};
+		
+		/// The algorithms of the portfolio (not owned).
+		std::vector<metaheuristic<G> *> algorithms;
+		/// Is each algorithm executed on a copy of the given solution?
+		std::vector<bool> improves;
+		
+		/// Time budget of the execution, in seconds. 0 if there is no limit.
+		double time_budget = 0.0;
+		/// Is there a target value?
+		bool use_target = false;
+		/// Target value of the execution, if @ref use_target.
+		double target = 0.0;
+		
+		/// Total execution time of the portfolio.
+		double total_time = 0.0;
+		/// Algorithm that found the solution returned.
+		size_t winner = 0;
+		
+		/// Beginning of the current execution.
+		timing::time_point begin;
+		/// Protects @ref has_incumbent, @ref incumbent and the calls to
+		/// the observer of the portfolio.
+		std::mutex incumbent_mutex;
+		/// Has any algorithm found a solution yet?
+		bool has_incumbent = false;
+		/// Cost of the best solution found so far by any algorithm.
+		double incumbent = 0.0;
+		/// Must the algorithms stop?
+		std::atomic<bool> stop{false};
+		
+	private:
+		/**
+		 * @brief Updates the incumbent with a solution of cost @e best.
+		 * 
+		 * Stops the algorithms if the incumbent reaches the target.
+		 */
+		void update_incumbent(double best);
+		/**
+		 * @brief Returns true if the algorithms must stop.
+		 * 
+		 * Stops the algorithms if the time budget is exhausted.
+		 */
+		bool must_stop();
+};
+
+} // -- namespace algorithms
+} // -- namespace metaheuristics
+
+#include <metaheuristics/algorithms/portfolio/portfolio.cpp>
@@ -28,6 +28,8 @@ HEADERS += \
 	algorithms/genetic_algorithms/brkga.cpp \
 	algorithms/genetic_algorithms/genetic_algorithm.hpp \
 	algorithms/genetic_algorithms/genetic_algorithm.cpp \
+	algorithms/genetic_algorithms/population_diversity.hpp \
+	algorithms/genetic_algorithms/population_set.hpp \
 	algorithms/genetic_algorithms/rkga.hpp \
 	algorithms/genetic_algorithms/rkga.cpp \
 	algorithms/grasp/grasp.hpp \
@@ -36,7 +38,14 @@ HEADERS += \
 	algorithms/local_search/local_search.cpp \
 	algorithms/metaheuristic.hpp \
 	algorithms/metaheuristic.cpp \
+	algorithms/observer.hpp \
+	algorithms/observer.cpp \
+	algorithms/portfolio/portfolio.hpp \
+	algorithms/portfolio/portfolio.cpp \
 	macros.hpp \
+	misc/checkpoint.hpp \
+	misc/metrics.hpp \
+	misc/thread_pool.hpp \
 	misc/time.hpp \
 	namespaces.hpp \
 	random/random_generator.hpp \
@@ -45,14 +54,21 @@ HEADERS += \
 	random/random_generator.cpp \
 	structures.hpp \
 	structures/chromosome.hpp \
+	structures/chromosome.cpp \
+	structures/fixed16.hpp \
 	structures/individual.hpp \
+	structures/individual.cpp \
 	structures/infeasible_exception.hpp \
 	structures/policies.hpp \
 	structures/problem.hpp \
-	structures/problem.cpp
+	structures/problem.cpp \
+	structures/problem_pool.hpp \
+	structures/problem_pool.cpp
 
 SOURCES += \
+	algorithms/genetic_algorithms/population_diversity.cpp \
+	misc/checkpoint.cpp \
+	misc/metrics.cpp \
+	misc/thread_pool.cpp \
 	misc/time.cpp \
-	structures/chromosome.cpp \
-	structures/individual.cpp \
 	structures/infeasible_exception.cpp
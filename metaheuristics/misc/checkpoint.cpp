@@ -0,0 +1,132 @@
+/*********************************************************************
+ *
+ * Collection of heuristic and metaheuristic algorithms
+ *
+ * Copyright (C) 2018-2020  Lluís Alemany Puig
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Contact: Lluís Alemany Puig (lluis.alemany.puig@gmail.com)
+ * 
+ *********************************************************************/
+
+#include <metaheuristics/misc/checkpoint.hpp>
+
+// C includes
+#include <stdio.h>
+
+// C++ includes
+#include <cstring>
+using namespace std;
+
+namespace metaheuristics {
+namespace checkpointing {
+
+static const char magic[4] = {'M', 'H', 'C', 'K'};
+
+void write_header(ostream& os, const algorithm_tag& t) {
+	os.write(magic, 4);
+	write_value(os, format_version);
+	write_value(os, static_cast<uint32_t>(t));
+}
+
+bool read_header(istream& is, const algorithm_tag& t) {
+	char m[4];
+	uint32_t version, tag;
+	
+	is.read(m, 4);
+	if (not is.good() or memcmp(m, magic, 4) != 0) {
+		return false;
+	}
+	if (not read_value(is, version) or version != format_version) {
+		return false;
+	}
+	if (not read_value(is, tag) or tag != static_cast<uint32_t>(t)) {
+		return false;
+	}
+	return true;
+}
+
+void write_string(ostream& os, const string& s) {
+	write_value(os, static_cast<uint64_t>(s.size()));
+	os.write(s.data(), static_cast<streamsize>(s.size()));
+}
+
+bool fits_in_stream(istream& is, uint64_t n, size_t size) {
+	if (size == 0) {
+		return true;
+	}
+	
+	uint64_t available = max_length;
+	const istream::pos_type cur = is.tellg();
+	if (cur != istream::pos_type(-1)) {
+		is.seekg(0, ios::end);
+		const istream::pos_type end = is.tellg();
+		is.seekg(cur);
+		if (end == istream::pos_type(-1) or not is.good()) {
+			return false;
+		}
+		available = static_cast<uint64_t>(end - cur);
+	}
+	else {
+		// tellg sets the failbit of streams that cannot be positioned
+		is.clear();
+	}
+	return n <= available/size;
+}
+
+bool read_string(istream& is, string& s) {
+	uint64_t n;
+	if (not read_value(is, n) or not fits_in_stream(is, n, 1)) {
+		return false;
+	}
+	s.resize(n);
+	is.read(&s[0], static_cast<streamsize>(n));
+	return is.good();
+}
+
+// async_writer
+
+async_writer::~async_writer() {
+	wait();
+}
+
+void async_writer::write(const string& filename, string&& data) {
+	wait();
+	
+	file = filename;
+	buffer = std::move(data);
+	worker = thread(
+		[this]() -> void {
+			const string tmp = file + ".tmp";
+			ofstream fout(tmp.c_str(), ios::binary | ios::trunc);
+			fout.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+			fout.close();
+			success = (not fout.fail()) and rename(tmp.c_str(), file.c_str()) == 0;
+		}
+	);
+}
+
+void async_writer::wait() {
+	if (worker.joinable()) {
+		worker.join();
+	}
+}
+
+bool async_writer::last_write_succeeded() const {
+	return success;
+}
+
+} // -- namespace checkpointing
+} // -- namespace metaheuristics
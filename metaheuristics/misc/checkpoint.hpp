@@ -0,0 +1,157 @@
+/*********************************************************************
+ *
+ * Collection of heuristic and metaheuristic algorithms
+ *
+ * Copyright (C) 2018-2020  Lluís Alemany Puig
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Contact: Lluís Alemany Puig (lluis.alemany.puig@gmail.com)
+ * 
+ *********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <type_traits>
+#include <fstream>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace metaheuristics {
+namespace checkpointing {
+
+/**
+ * @brief Version of the format of the checkpoint files.
+ * 
+ * Increase it whenever the contents written by any algorithm change.
+ */
+constexpr uint32_t format_version = 2;
+
+/// Algorithms whose state can be written into a checkpoint file.
+enum class algorithm_tag : uint32_t {
+	rkga = 1,
+	brkga = 2,
+	grasp = 3
+};
+
+/**
+ * @brief Writes the header of a checkpoint.
+ * 
+ * The header consists of a magic string, the version of the format
+ * (see @ref format_version) and the algorithm that wrote it.
+ */
+void write_header(std::ostream& os, const algorithm_tag& t);
+/**
+ * @brief Reads the header of a checkpoint.
+ * @returns Returns true if the header is valid, was written with the
+ * current version of the format and by algorithm @e t.
+ */
+bool read_header(std::istream& is, const algorithm_tag& t);
+
+/// Writes the binary representation of @e v.
+template<typename T>
+inline void write_value(std::ostream& os, const T& v) {
+	static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+	os.write(reinterpret_cast<const char *>(&v), sizeof(T));
+}
+/// Writes the binary representation of the @e n values in @e v.
+template<typename T>
+inline void write_values(std::ostream& os, const T *v, size_t n) {
+	static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+	os.write(reinterpret_cast<const char *>(v), static_cast<std::streamsize>(n*sizeof(T)));
+}
+/// Reads the binary representation of @e v.
+template<typename T>
+inline bool read_value(std::istream& is, T& v) {
+	static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+	is.read(reinterpret_cast<char *>(&v), sizeof(T));
+	return is.good();
+}
+/// Reads the binary representation of the @e n values in @e v.
+template<typename T>
+inline bool read_values(std::istream& is, T *v, size_t n) {
+	static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+	is.read(reinterpret_cast<char *>(v), static_cast<std::streamsize>(n*sizeof(T)));
+	return is.good();
+}
+
+/**
+ * @brief Can @e n values of @e size bytes each still be read from @e is?
+ * 
+ * The lengths and sizes read from a checkpoint are checked with this
+ * function before allocating memory for them, so that a corrupted file
+ * is rejected instead of exhausting the memory. If the size of the
+ * stream is not known, the values must take at most @ref max_length bytes.
+ */
+bool fits_in_stream(std::istream& is, uint64_t n, size_t size);
+/// Largest amount of bytes read at once from a stream of unknown size.
+constexpr uint64_t max_length = uint64_t(1) << 32;
+
+/// Writes the length of @e s followed by its characters.
+void write_string(std::ostream& os, const std::string& s);
+/**
+ * @brief Reads a string written with @ref write_string.
+ * @returns Returns false if the string could not be read, or if its
+ * length is larger than the bytes left in @e is (see @ref fits_in_stream).
+ */
+bool read_string(std::istream& is, std::string& s);
+
+/**
+ * @brief Writes checkpoints into files in a background thread.
+ * 
+ * The algorithms serialise their state into a string, which
+ * is handed to this class so that the execution is not stalled
+ * while writing into disk.
+ * 
+ * Every file is first written into a temporary file that is then
+ * renamed, so that an interrupted write never leaves a corrupted
+ * checkpoint.
+ */
+class async_writer {
+	public:
+		/// Default constructor.
+		async_writer() = default;
+		/// Destructor. Waits for the pending write to finish.
+		~async_writer();
+		
+		async_writer(const async_writer&) = delete;
+		async_writer& operator= (const async_writer&) = delete;
+		
+		/**
+		 * @brief Writes @e data into file @e filename.
+		 * 
+		 * Waits for the previous write to finish, and starts
+		 * writing in a background thread.
+		 */
+		void write(const std::string& filename, std::string&& data);
+		/// Waits for the pending write to finish.
+		void wait();
+		/// Returns whether the last finished write succeeded.
+		bool last_write_succeeded() const;
+
+	private:
+		/// Thread writing the data.
+		std::thread worker;
+		/// The data being written.
+		std::string buffer;
+		/// The name of the file being written.
+		std::string file;
+		/// Did the last write succeed?
+		bool success = true;
+};
+
+} // -- namespace checkpointing
+} // -- namespace metaheuristics
@@ -0,0 +1,349 @@
+/*********************************************************************
+ *
+ * Collection of heuristic and metaheuristic algorithms
+ *
+ * Copyright (C) 2018-2020  Lluís Alemany Puig
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Contact: Lluís Alemany Puig (lluis.alemany.puig@gmail.com)
+ * 
+ *********************************************************************/
+
+#include <metaheuristics/misc/metrics.hpp>
+
+// C++ includes
+#include <algorithm>
+#include <cmath>
+using namespace std;
+
+namespace metaheuristics {
+namespace profiling {
+
+// auxiliary functions
+
+namespace {
+
+/// Sets the format of the floating point values in a stream, restoring
+/// the previous format when destroyed.
+class float_format {
+	public:
+		float_format(ostream& o) : os(o) {
+			flags = os.flags();
+			prec = os.precision();
+			os.unsetf(ios::floatfield);
+			os.precision(9);
+		}
+		~float_format() {
+			os.flags(flags);
+			os.precision(prec);
+		}
+	private:
+		ostream& os;
+		ios::fmtflags flags;
+		streamsize prec;
+};
+
+} // -- anonymous namespace
+
+// histogram
+
+histogram::histogram(double m) {
+	min_value = m;
+	clear();
+}
+
+void histogram::add(double v) {
+	++buckets[bucket_of(v)];
+	if (count == 0) {
+		min = max = v;
+	}
+	else {
+		min = std::min(min, v);
+		max = std::max(max, v);
+	}
+	++count;
+	sum += v;
+}
+
+void histogram::merge(const histogram& h) {
+	if (h.count == 0) {
+		return;
+	}
+	for (size_t b = 0; b < n_buckets; ++b) {
+		buckets[b] += h.buckets[b];
+	}
+	if (count == 0) {
+		min = h.min;
+		max = h.max;
+	}
+	else {
+		min = std::min(min, h.min);
+		max = std::max(max, h.max);
+	}
+	count += h.count;
+	sum += h.sum;
+}
+
+void histogram::clear() {
+	buckets.fill(0);
+	count = 0;
+	sum = min = max = 0.0;
+}
+
+uint64_t histogram::get_count() const {
+	return count;
+}
+
+double histogram::get_sum() const {
+	return sum;
+}
+
+double histogram::get_mean() const {
+	return (count == 0 ? 0.0 : sum/static_cast<double>(count));
+}
+
+double histogram::get_min() const {
+	return min;
+}
+
+double histogram::get_max() const {
+	return max;
+}
+
+double histogram::get_percentile(double p) const {
+	if (count == 0) {
+		return 0.0;
+	}
+	
+	const double r = std::ceil(p/100.0*static_cast<double>(count));
+	const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(r));
+	
+	uint64_t cum = 0;
+	size_t b = 0;
+	while (b < n_buckets - 1 and cum + buckets[b] < rank) {
+		cum += buckets[b];
+		++b;
+	}
+	return std::min(std::max(upper_bound(b), min), max);
+}
+
+void histogram::to_json(ostream& os) const {
+	float_format ff(os);
+	os << "{"
+	   << "\"count\": " << count << ", "
+	   << "\"sum\": " << sum << ", "
+	   << "\"mean\": " << get_mean() << ", "
+	   << "\"min\": " << min << ", "
+	   << "\"max\": " << max << ", "
+	   << "\"p50\": " << get_percentile(50) << ", "
+	   << "\"p90\": " << get_percentile(90) << ", "
+	   << "\"p99\": " << get_percentile(99) << ", "
+	   << "\"p999\": " << get_percentile(99.9)
+	   << "}";
+}
+
+void histogram::to_csv(ostream& os) const {
+	float_format ff(os);
+	os << count << ","
+	   << sum << ","
+	   << get_mean() << ","
+	   << min << ","
+	   << max << ","
+	   << get_percentile(50) << ","
+	   << get_percentile(90) << ","
+	   << get_percentile(99) << ","
+	   << get_percentile(99.9);
+}
+
+size_t histogram::bucket_of(double v) const {
+	if (not (v > min_value)) {
+		return 0;
+	}
+	
+	// v/min_value = m*2^e, with m in [0.5, 1)
+	int e;
+	const double m = std::frexp(v/min_value, &e);
+	const size_t octave = static_cast<size_t>(e - 1);
+	const size_t sub = static_cast<size_t>((2.0*m - 1.0)*sub_buckets);
+	return std::min(octave*sub_buckets + sub, n_buckets - 1);
+}
+
+double histogram::upper_bound(size_t b) const {
+	const size_t octave = b/sub_buckets;
+	const size_t sub = b%sub_buckets;
+	const double width = 1.0 + static_cast<double>(sub + 1)/sub_buckets;
+	return std::ldexp(min_value*width, static_cast<int>(octave));
+}
+
+// metrics
+
+metrics::metrics() : neighbours(1.0) {
+	clear();
+}
+
+void metrics::clear() {
+	counters.fill(0);
+	for (histogram& h : latencies) {
+		h.clear();
+	}
+	neighbours.clear();
+	wall_time = 0.0;
+	depth = 0;
+}
+
+void metrics::start() {
+	if (depth == 0) {
+		begin = timing::now();
+	}
+	++depth;
+}
+
+void metrics::stop() {
+	if (depth == 0) {
+		return;
+	}
+	--depth;
+	if (depth == 0) {
+		wall_time += timing::elapsed_seconds(begin, timing::now());
+	}
+}
+
+void metrics::add_neighbours(size_t n) {
+	add(counter::neighbours_explored, n);
+	neighbours.add(static_cast<double>(n));
+}
+
+void metrics::merge(const metrics& m) {
+	for (size_t c = 0; c < counters.size(); ++c) {
+		counters[c] += m.counters[c];
+	}
+	for (size_t p = 0; p < latencies.size(); ++p) {
+		latencies[p].merge(m.latencies[p]);
+	}
+	neighbours.merge(m.neighbours);
+}
+
+uint64_t metrics::get_counter(const counter& c) const {
+	return counters[static_cast<size_t>(c)];
+}
+
+const histogram& metrics::get_latency(const phase& p) const {
+	return latencies[static_cast<size_t>(p)];
+}
+
+const histogram& metrics::get_neighbours_per_iteration() const {
+	return neighbours;
+}
+
+double metrics::get_wall_time() const {
+	return wall_time;
+}
+
+double metrics::get_decodes_per_second() const {
+	if (wall_time <= 0.0) {
+		return 0.0;
+	}
+	return static_cast<double>(get_counter(counter::decodes))/wall_time;
+}
+
+const char *metrics::name(const counter& c) {
+	switch (c) {
+		case counter::decodes:					return "decodes";
+		case counter::infeasible_decodes:		return "infeasible_decodes";
+		case counter::infeasible_constructions:	return "infeasible_constructions";
+		case counter::clones:					return "clones";
+		case counter::empties:					return "empties";
+		case counter::allocations:				return "allocations";
+		case counter::neighbours_explored:		return "neighbours_explored";
+		case counter::generations:				return "generations";
+		case counter::grasp_iterations:			return "grasp_iterations";
+		case counter::local_search_iterations:	return "local_search_iterations";
+		default:								return "unknown";
+	}
+}
+
+const char *metrics::name(const phase& p) {
+	switch (p) {
+		case phase::decode:				return "decode";
+		case phase::initial_population:	return "initial_population";
+		case phase::generation:			return "generation";
+		case phase::elite_copy:			return "elite_copy";
+		case phase::mutants:			return "mutants";
+		case phase::crossover:			return "crossover";
+		case phase::grasp_iteration:	return "grasp_iteration";
+		case phase::construct:			return "construct";
+		case phase::local_search:		return "local_search";
+		case phase::neighbourhood:		return "neighbourhood";
+		default:						return "unknown";
+	}
+}
+
+void metrics::to_json(ostream& os) const {
+	float_format ff(os);
+	
+	os << "{" << endl;
+	os << "  \"wall_time\": " << wall_time << "," << endl;
+	os << "  \"decodes_per_second\": " << get_decodes_per_second() << "," << endl;
+	
+	os << "  \"counters\": {";
+	for (size_t c = 0; c < counters.size(); ++c) {
+		os << (c == 0 ? "" : ",") << endl
+		   << "    \"" << name(static_cast<counter>(c)) << "\": " << counters[c];
+	}
+	os << endl << "  }," << endl;
+	
+	os << "  \"latencies\": {";
+	bool first = true;
+	for (size_t p = 0; p < latencies.size(); ++p) {
+		if (latencies[p].get_count() == 0) {
+			continue;
+		}
+		os << (first ? "" : ",") << endl
+		   << "    \"" << name(static_cast<phase>(p)) << "\": ";
+		latencies[p].to_json(os);
+		first = false;
+	}
+	os << endl << "  }," << endl;
+	
+	os << "  \"neighbours_per_iteration\": ";
+	neighbours.to_json(os);
+	os << endl << "}" << endl;
+}
+
+void metrics::to_csv(ostream& os) const {
+	float_format ff(os);
+	
+	os << "kind,name,count,sum,mean,min,max,p50,p90,p99,p999" << endl;
+	os << "rate,wall_time,," << wall_time << ",,,,,,," << endl;
+	os << "rate,decodes_per_second,," << get_decodes_per_second() << ",,,,,,," << endl;
+	for (size_t c = 0; c < counters.size(); ++c) {
+		os << "counter," << name(static_cast<counter>(c)) << ","
+		   << counters[c] << ",,,,,,,," << endl;
+	}
+	for (size_t p = 0; p < latencies.size(); ++p) {
+		if (latencies[p].get_count() == 0) {
+			continue;
+		}
+		os << "latency," << name(static_cast<phase>(p)) << ",";
+		latencies[p].to_csv(os);
+		os << endl;
+	}
+	os << "histogram,neighbours_per_iteration,";
+	neighbours.to_csv(os);
+	os << endl;
+}
+
+} // -- namespace profiling
+} // -- namespace metaheuristics
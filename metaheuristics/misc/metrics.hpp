@@ -0,0 +1,331 @@
+/*********************************************************************
+ *
+ * Collection of heuristic and metaheuristic algorithms
+ *
+ * Copyright (C) 2018-2020  Lluís Alemany Puig
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Contact: Lluís Alemany Puig (lluis.alemany.puig@gmail.com)
+ * 
+ *********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <iostream>
+#include <cstdint>
+#include <array>
+
+// metaheuristics includes
+#include <metaheuristics/misc/time.hpp>
+
+namespace metaheuristics {
+namespace profiling {
+
+/**
+ * @brief Histogram with logarithmic buckets.
+ * 
+ * Every power of two, from @ref min_value up to @ref min_value * 2^64,
+ * is split into 8 buckets of equal width, so that the percentiles are
+ * estimated with a relative error of at most 12.5%. Values smaller than
+ * @ref min_value fall in the first bucket.
+ * 
+ * The buckets are allocated within the object: adding a value costs
+ * a few arithmetic operations and never allocates memory.
+ */
+class histogram {
+	public:
+		/**
+		 * @brief Constructor.
+		 * @param m Smallest value distinguished by the histogram
+		 * (see @ref min_value).
+		 */
+		histogram(double m = 1e-9);
+		/// Destructor.
+		~histogram() = default;
+		
+		// MODIFIERS
+		
+		/// Adds value @e v to the histogram.
+		void add(double v);
+		/// Adds the values of histogram @e h.
+		void merge(const histogram& h);
+		/// Removes all values.
+		void clear();
+		
+		// GETTERS
+		
+		/// Returns the number of values added.
+		uint64_t get_count() const;
+		/// Returns the sum of the values added.
+		double get_sum() const;
+		/// Returns the mean of the values added.
+		double get_mean() const;
+		/// Returns the smallest value added.
+		double get_min() const;
+		/// Returns the largest value added.
+		double get_max() const;
+		/**
+		 * @brief Returns an estimate of the @e p-th percentile.
+		 * 
+		 * The estimate is the upper bound of the bucket containing
+		 * the percentile, clamped to [@ref get_min(), @ref get_max()].
+		 * @param p A value in [0,100].
+		 * @returns Returns 0 if the histogram is empty.
+		 */
+		double get_percentile(double p) const;
+		
+		/**
+		 * @brief Writes a JSON object with the summary of the histogram.
+		 * 
+		 * The summary contains the count, the sum, the mean, the
+		 * minimum, the maximum and the 50th, 90th, 99th and 99.9th
+		 * percentiles.
+		 */
+		void to_json(std::ostream& os) const;
+		/**
+		 * @brief Writes the summary of the histogram as CSV fields.
+		 * 
+		 * The fields are those of @ref to_json, in the same order,
+		 * separated by commas.
+		 */
+		void to_csv(std::ostream& os) const;
+
+	private:
+		/// Number of buckets in every power of two.
+		static constexpr size_t sub_buckets = 8;
+		/// Total number of buckets.
+		static constexpr size_t n_buckets = 64*sub_buckets;
+		
+		/// Smallest value distinguished by the histogram.
+		double min_value;
+		/// Number of values in each bucket.
+		std::array<uint64_t, n_buckets> buckets;
+		/// Number of values added.
+		uint64_t count = 0;
+		/// Sum of the values added.
+		double sum = 0.0;
+		/// Smallest value added.
+		double min = 0.0;
+		/// Largest value added.
+		double max = 0.0;
+		
+		/// Returns the bucket of value @e v.
+		size_t bucket_of(double v) const;
+		/// Returns the upper bound of the values in bucket @e b.
+		double upper_bound(size_t b) const;
+};
+
+/**
+ * @brief Performance metrics of the execution of the algorithms.
+ * 
+ * Collects:
+ * - counters (see @ref counter): decodes, infeasible decodes, solutions
+ * obtained with @ref structures::problem::clone and
+ * @ref structures::problem::empty (or from a @ref structures::problem_pool),
+ * solutions that had to be allocated because no pool had a free one,
+ * neighbours explored and iterations (or generations) done,
+ * - the distribution of the latency of every phase of the algorithms
+ * (see @ref phase),
+ * - the distribution of the number of neighbours explored per iteration
+ * of the local search,
+ * - the wall time of the executions, used to compute the number of
+ * decodes per second.
+ * 
+ * The metrics are collected only when an object of this class is
+ * given to an algorithm (see @ref algorithms::metaheuristic::set_metrics).
+ * The same object can be given to several executions: the metrics
+ * are accumulated until @ref clear is called.
+ * 
+ * The metrics can be exported in JSON (see @ref to_json) or CSV
+ * (see @ref to_csv) format.
+ */
+class metrics {
+	public:
+		/// Counters of events.
+		enum class counter : size_t {
+			/// Chromosomes decoded.
+			decodes = 0,
+			/// Decodes that threw a @ref structures::infeasible_exception.
+			infeasible_decodes,
+			/// Solutions constructed that turned out to be infeasible.
+			infeasible_constructions,
+			/// Copies of a solution, made with @ref structures::problem::clone or taken from a pool.
+			clones,
+			/// Empty solutions, made with @ref structures::problem::empty or taken from a pool.
+			empties,
+			/// Solutions (also neighbours) allocated because no free solution was in a pool.
+			allocations,
+			/// Neighbours explored by the local search.
+			neighbours_explored,
+			/// Generations of the genetic algorithms.
+			generations,
+			/// Iterations of GRASP.
+			grasp_iterations,
+			/// Iterations of the local search.
+			local_search_iterations,
+			/// Number of counters.
+			n_counters
+		};
+		
+		/// Phases of the algorithms whose latency is measured.
+		enum class phase : size_t {
+			/// Decoding one chromosome (genetic algorithms).
+			decode = 0,
+			/// Generating the initial population (genetic algorithms).
+			initial_population,
+			/// A whole generation (genetic algorithms).
+			generation,
+			/// Copying the elite individuals (BRKGA).
+			elite_copy,
+			/// Generating the mutants of a generation (genetic algorithms).
+			mutants,
+			/// Generating the crossovers of a generation (genetic algorithms).
+			crossover,
+			/// A whole iteration (GRASP).
+			grasp_iteration,
+			/// Constructing a randomised solution (GRASP).
+			construct,
+			/// A whole execution of the local search.
+			local_search,
+			/// Exploring the neighbourhood of a solution (local search).
+			neighbourhood,
+			/// Number of phases.
+			n_phases
+		};
+		
+		/**
+		 * @brief Measures the wall time of an execution within a scope.
+		 * 
+		 * Calls @ref start when constructed and @ref stop when destroyed,
+		 * unless the metrics are null.
+		 */
+		class scope {
+			public:
+				/// Constructor. Calls @ref start on @e m, if not null.
+				scope(metrics *m) : ms(m) {
+					if (ms != nullptr) {
+						ms->start();
+					}
+				}
+				/// Destructor. Calls @ref stop, if the metrics are not null.
+				~scope() {
+					if (ms != nullptr) {
+						ms->stop();
+					}
+				}
+			private:
+				/// The metrics measured.
+				metrics *ms;
+		};
+		
+	public:
+		/// Default constructor.
+		metrics();
+		/// Destructor.
+		~metrics() = default;
+		
+		// MODIFIERS
+		
+		/// Resets all metrics.
+		void clear();
+		
+		/**
+		 * @brief Starts measuring the wall time of an execution.
+		 * 
+		 * Calls can be nested (for example, the local search executed
+		 * in every iteration of GRASP): only the outermost pair of
+		 * calls to @ref start and @ref stop measures the time.
+		 */
+		void start();
+		/// Stops measuring the wall time of an execution.
+		void stop();
+		
+		/// Adds @e n to counter @e c.
+		inline void add(const counter& c, uint64_t n = 1) {
+			counters[static_cast<size_t>(c)] += n;
+		}
+		/// Adds the latency @e s, in seconds, of phase @e p.
+		inline void add_latency(const phase& p, double s) {
+			latencies[static_cast<size_t>(p)].add(s);
+		}
+		/// Adds the number of neighbours explored in one iteration.
+		void add_neighbours(size_t n);
+		/**
+		 * @brief Adds the counters and the distributions of @e m.
+		 * 
+		 * Used to gather the metrics collected by several threads.
+		 * The wall time of @e m is not added, since the executions
+		 * of the threads overlap in time.
+		 */
+		void merge(const metrics& m);
+		
+		// GETTERS
+		
+		/// Returns the value of counter @e c.
+		uint64_t get_counter(const counter& c) const;
+		/// Returns the distribution of the latency of phase @e p.
+		const histogram& get_latency(const phase& p) const;
+		/// Returns the distribution of the neighbours explored per iteration.
+		const histogram& get_neighbours_per_iteration() const;
+		/// Returns the wall time measured, in seconds.
+		double get_wall_time() const;
+		/// Returns the number of decodes per second of wall time.
+		double get_decodes_per_second() const;
+		
+		/// Returns the name of counter @e c.
+		static const char *name(const counter& c);
+		/// Returns the name of phase @e p.
+		static const char *name(const phase& p);
+		
+		// OUTPUT
+		
+		/**
+		 * @brief Writes all metrics as a JSON object.
+		 * 
+		 * Latencies are given in seconds. Only the phases with at
+		 * least one measure are written.
+		 */
+		void to_json(std::ostream& os) const;
+		/**
+		 * @brief Writes all metrics in CSV format.
+		 * 
+		 * Every row is a metric, with the columns
+		 \verbatim
+		 kind,name,count,sum,mean,min,max,p50,p90,p99,p999
+		 \endverbatim
+		 * Counters and rates only fill the column 'count' and 'sum'
+		 * respectively.
+		 */
+		void to_csv(std::ostream& os) const;
+
+	private:
+		/// Values of the counters.
+		std::array<uint64_t, static_cast<size_t>(counter::n_counters)> counters;
+		/// Latency of each phase.
+		std::array<histogram, static_cast<size_t>(phase::n_phases)> latencies;
+		/// Neighbours explored per iteration of the local search.
+		histogram neighbours;
+		
+		/// Wall time measured.
+		double wall_time = 0.0;
+		/// Number of nested calls to @ref start.
+		size_t depth = 0;
+		/// Moment of the outermost call to @ref start.
+		timing::time_point begin;
+};
+
+} // -- namespace profiling
+} // -- namespace metaheuristics
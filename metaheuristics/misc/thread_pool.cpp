@@ -0,0 +1,312 @@
+/*********************************************************************
+ *
+ * Collection of heuristic and metaheuristic algorithms
+ *
+ * Copyright (C) 2018-2020  Lluís Alemany Puig
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Contact: Lluís Alemany Puig (lluis.alemany.puig@gmail.com)
+ * 
+ *********************************************************************/
+
+#include <metaheuristics/misc/thread_pool.hpp>
+
+// C includes
+#if defined (__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// C++ includes
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+using namespace std;
+
+namespace metaheuristics {
+namespace concurrency {
+
+// the pool executing the current thread, and the queue of this thread
+static thread_local thread_pool *current_pool = nullptr;
+static thread_local size_t current_queue = 0;
+
+#if defined (__linux__)
+
+// Parses a list of processors like "0-3,8,10-11".
+static void parse_cpu_list(const string& s, vector<int>& cpus) {
+	stringstream ss(s);
+	string range;
+	while (getline(ss, range, ',')) {
+		const size_t dash = range.find('-');
+		if (dash == string::npos) {
+			cpus.push_back(stoi(range));
+		}
+		else {
+			const int first = stoi(range.substr(0, dash));
+			const int last = stoi(range.substr(dash + 1));
+			for (int c = first; c <= last; ++c) {
+				cpus.push_back(c);
+			}
+		}
+	}
+}
+
+// Returns the processors this process can run on, sorted by NUMA node.
+static vector<int> available_cpus() {
+	vector<int> cpus;
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	if (sched_getaffinity(0, sizeof(cpu_set_t), &set) != 0) {
+		return cpus;
+	}
+	
+	// processors of every NUMA node, in the order of the nodes
+	vector<int> by_node;
+	for (int node = 0; ; ++node) {
+		ifstream fin("/sys/devices/system/node/node" + to_string(node) + "/cpulist");
+		string list;
+		if (not fin.is_open() or not getline(fin, list)) {
+			break;
+		}
+		parse_cpu_list(list, by_node);
+	}
+	
+	for (int c : by_node) {
+		if (CPU_ISSET(c, &set) and find(cpus.begin(), cpus.end(), c) == cpus.end()) {
+			cpus.push_back(c);
+		}
+	}
+	// processors not listed in any node (or no NUMA information)
+	for (int c = 0; c < CPU_SETSIZE; ++c) {
+		if (CPU_ISSET(c, &set) and find(cpus.begin(), cpus.end(), c) == cpus.end()) {
+			cpus.push_back(c);
+		}
+	}
+	return cpus;
+}
+
+#endif
+
+// PUBLIC
+
+thread_pool::thread_pool(size_t n, bool pin) : queues(max<size_t>(n == 0 ? hardware_threads() : n, 1)) {
+	queued = 0;
+	
+	// the last queue is shared by the threads not in the pool,
+	// the other ones belong to the worker threads
+	for (size_t w = 0; w + 1 < queues.size(); ++w) {
+		workers.push_back(thread(&thread_pool::work, this, w));
+	}
+	if (pin) {
+		pin_workers();
+	}
+}
+
+thread_pool::~thread_pool() {
+	{
+	lock_guard<mutex> lock(sleep_mutex);
+	stopping = true;
+	}
+	wake.notify_all();
+	for (thread& t : workers) {
+		t.join();
+	}
+}
+
+void thread_pool::parallel_for(
+	size_t begin, size_t end,
+	const function<void (size_t)>& f, size_t grain
+)
+{
+	if (begin >= end) {
+		return;
+	}
+	const size_t n = end - begin;
+	if (grain == 0) {
+		grain = max<size_t>(1, n/(4*size()));
+	}
+	const size_t n_chunks = (n + grain - 1)/grain;
+	
+	// a single thread, or a single chunk, is executed right away
+	if (size() == 1 or n_chunks == 1) {
+		for (size_t i = begin; i < end; ++i) {
+			f(i);
+		}
+		return;
+	}
+	
+	// threads not in the pool use the shared queue while executing
+	// chunks of this pool
+	thread_pool *previous_pool = current_pool;
+	const size_t previous_queue = current_queue;
+	if (current_pool != this) {
+		current_pool = this;
+		current_queue = queues.size() - 1;
+	}
+	const size_t q = current_queue;
+	
+	job j;
+	j.f = &f;
+	j.pending = n_chunks;
+	
+	// the first chunk is executed by this thread, the
+	// rest are left in its queue for the other threads
+	{
+	lock_guard<mutex> lock(queues[q].m);
+	queued += n_chunks - 1;
+	for (size_t c = n_chunks - 1; c >= 1; --c) {
+		const size_t b = begin + c*grain;
+		queues[q].chunks.push_back(chunk{&j, b, min(b + grain, end)});
+	}
+	}
+	{
+	lock_guard<mutex> lock(sleep_mutex);
+	}
+	wake.notify_all();
+	
+	run(chunk{&j, begin, min(begin + grain, end)});
+	
+	// execute chunks, of this or of other loops, until the
+	// chunks of this loop have finished
+	chunk c;
+	while (j.pending > 0 and take(q, c)) {
+		run(c);
+	}
+	{
+	unique_lock<mutex> lock(j.m);
+	j.done.wait(lock, [&]() -> bool { return j.pending == 0; });
+	}
+	
+	current_pool = previous_pool;
+	current_queue = previous_queue;
+	
+	if (j.error != nullptr) {
+		rethrow_exception(j.error);
+	}
+}
+
+size_t thread_pool::size() const {
+	return queues.size();
+}
+
+thread_pool *thread_pool::current() {
+	return current_pool;
+}
+
+size_t thread_pool::hardware_threads() {
+	#if defined (__linux__)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	if (sched_getaffinity(0, sizeof(cpu_set_t), &set) == 0) {
+		return max(CPU_COUNT(&set), 1);
+	}
+	#endif
+	return max<size_t>(thread::hardware_concurrency(), 1);
+}
+
+// PRIVATE
+
+void thread_pool::work(size_t w) {
+	current_pool = this;
+	current_queue = w;
+	
+	chunk c;
+	while (true) {
+		if (take(w, c)) {
+			run(c);
+			continue;
+		}
+		
+		unique_lock<mutex> lock(sleep_mutex);
+		wake.wait(lock, [&]() -> bool { return stopping or queued > 0; });
+		if (stopping) {
+			return;
+		}
+	}
+}
+
+bool thread_pool::take(size_t q, chunk& c) {
+	if (queued == 0) {
+		return false;
+	}
+	
+	// the newest chunk of the own queue, which is likely
+	// to use the data this thread used last
+	{
+	lock_guard<mutex> lock(queues[q].m);
+	if (not queues[q].chunks.empty()) {
+		c = queues[q].chunks.back();
+		queues[q].chunks.pop_back();
+		--queued;
+		return true;
+	}
+	}
+	
+	// the oldest chunk of another queue
+	for (size_t k = 1; k < queues.size(); ++k) {
+		queue& other = queues[(q + k)%queues.size()];
+		lock_guard<mutex> lock(other.m);
+		if (not other.chunks.empty()) {
+			c = other.chunks.front();
+			other.chunks.pop_front();
+			--queued;
+			return true;
+		}
+	}
+	return false;
+}
+
+void thread_pool::run(const chunk& c) {
+	job& j = *c.j;
+	try {
+		for (size_t i = c.begin; i < c.end; ++i) {
+			(*j.f)(i);
+		}
+	}
+	catch (...) {
+		lock_guard<mutex> lock(j.m);
+		if (j.error == nullptr) {
+			j.error = current_exception();
+		}
+	}
+	
+	// the job may be destroyed as soon as its last chunk is
+	// notified, so the notification is made within the lock
+	lock_guard<mutex> lock(j.m);
+	if (--j.pending == 0) {
+		j.done.notify_all();
+	}
+}
+
+void thread_pool::pin_workers() {
+	#if defined (__linux__)
+	const vector<int> cpus = available_cpus();
+	if (cpus.empty()) {
+		return;
+	}
+	// the first processor is left for the thread that
+	// created the pool, which is not pinned
+	for (size_t w = 0; w < workers.size(); ++w) {
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(cpus[(w + 1)%cpus.size()], &set);
+		pthread_setaffinity_np(workers[w].native_handle(), sizeof(cpu_set_t), &set);
+	}
+	#endif
+}
+
+} // -- namespace concurrency
+} // -- namespace metaheuristics
@@ -0,0 +1,186 @@
+/*********************************************************************
+ *
+ * Collection of heuristic and metaheuristic algorithms
+ *
+ * Copyright (C) 2018-2020  Lluís Alemany Puig
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Contact: Lluís Alemany Puig (lluis.alemany.puig@gmail.com)
+ * 
+ *********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <deque>
+#include <mutex>
+
+namespace metaheuristics {
+namespace concurrency {
+
+/**
+ * @brief Pool of threads that execute loops over ranges of indices.
+ * 
+ * The pool is made of @ref size() threads: the thread that calls
+ * @ref parallel_for plus @ref size() - 1 worker threads created by the
+ * constructor. A loop is split into chunks of consecutive indices, which
+ * are pushed into the queue of the calling thread. Every thread takes
+ * chunks from the back of its own queue and, when it is empty, steals
+ * chunks from the front of the queues of the other threads. Worker
+ * threads sleep while there are no chunks to execute.
+ * 
+ * Calls to @ref parallel_for can be nested: a chunk may call
+ * @ref parallel_for on the same pool (see @ref current), in which case
+ * its chunks are executed by the threads of the pool, and the calling
+ * thread executes chunks while it waits. No thread is created, so
+ * nested loops never use more threads than the pool has. Several
+ * threads not in the pool may also use the same pool at the same time.
+ * 
+ * The algorithms use a pool when one is given to them (see
+ * @ref algorithms::metaheuristic::set_thread_pool). The methods of the
+ * problem (for example @ref structures::problem::best_neighbour) can
+ * also split their work with the pool returned by @ref current.
+ * 
+ * On Linux, the worker threads can be pinned to the processors the
+ * process is allowed to run on. The processors are assigned in the
+ * order of their NUMA node, so that the threads of a small pool share
+ * the same memory node.
+ */
+class thread_pool {
+	public:
+		/**
+		 * @brief Constructor.
+		 * @param n Number of threads of the pool, including the thread
+		 * that calls @ref parallel_for. If 0, the number of processors
+		 * available (see @ref hardware_threads).
+		 * @param pin Pin each worker thread to a different processor
+		 * (only on Linux).
+		 */
+		thread_pool(size_t n = 0, bool pin = false);
+		/// Destructor. Waits for the worker threads to finish.
+		~thread_pool();
+		
+		thread_pool(const thread_pool&) = delete;
+		thread_pool& operator= (const thread_pool&) = delete;
+		
+		/**
+		 * @brief Calls @e f(i) for every @e i in [@e begin, @e end).
+		 * 
+		 * The calls are executed concurrently, in any order, and this
+		 * method returns when all of them have finished. If any call
+		 * throws an exception, the first exception caught is thrown
+		 * again by this method once the rest of the calls finished.
+		 * @param begin First index.
+		 * @param end One past the last index.
+		 * @param f Function called with every index.
+		 * @param grain Number of consecutive indices of every chunk. If 0,
+		 * the range is split into about four chunks per thread.
+		 */
+		void parallel_for(
+			size_t begin, size_t end,
+			const std::function<void (size_t)>& f, size_t grain = 0
+		);
+		
+		/// Returns the number of threads of the pool.
+		size_t size() const;
+		
+		/**
+		 * @brief Returns the pool executing the current thread.
+		 * 
+		 * Within a chunk of a loop (or within a worker thread) this is
+		 * the pool executing it. Returns nullptr otherwise.
+		 */
+		static thread_pool *current();
+		/// Returns the number of processors this process can run on.
+		static size_t hardware_threads();
+
+	private:
+		/// A loop executed with @ref parallel_for.
+		class job {
+			public:
+				/// The function called with every index.
+				const std::function<void (size_t)> *f;
+				/// Number of chunks not finished yet.
+				std::atomic<size_t> pending;
+				/// Protects @ref error and the notifications of the end.
+				std::mutex m;
+				/// Notified when the last chunk finishes.
+				std::condition_variable done;
+				/// First exception thrown by @ref f.
+				std::exception_ptr error;
+		};
+		/// Consecutive indices of a loop.
+		class chunk {
+			public:
+				/// The loop.
+				job *j;
+				/// First index.
+				size_t begin;
+				/// One past the last index.
+				size_t end;
+		};
+		/// Chunks waiting to be executed by a thread.
+		class queue {
+			public:
+				/// Protects @ref chunks.
+				std::mutex m;
+				/// The chunks, the newest at the back.
+				std::deque<chunk> chunks;
+		};
+		
+		/// Worker threads.
+		std::vector<std::thread> workers;
+		/**
+		 * @brief Queues of the threads.
+		 * 
+		 * Queue @e w belongs to the @e w-th worker thread. The last one
+		 * is shared by the threads not in the pool.
+		 */
+		std::vector<queue> queues;
+		
+		/// Number of chunks in the queues.
+		std::atomic<size_t> queued;
+		/// Protects the sleep of the worker threads.
+		std::mutex sleep_mutex;
+		/// Wakes the worker threads up.
+		std::condition_variable wake;
+		/// Tells the worker threads to finish.
+		bool stopping = false;
+		
+	private:
+		/// Loop of the @e w-th worker thread.
+		void work(size_t w);
+		/**
+		 * @brief Takes a chunk from the queues.
+		 * 
+		 * Looks first at the back of queue @e q and then at the front
+		 * of the other queues.
+		 * @returns Returns false if all queues are empty.
+		 */
+		bool take(size_t q, chunk& c);
+		/// Executes chunk @e c and notifies its end.
+		void run(const chunk& c);
+		/// Pins the worker threads to the processors available.
+		void pin_workers();
+};
+
+} // -- namespace concurrency
+} // -- namespace metaheuristics
@@ -32,6 +32,15 @@ namespace metaheuristics {
 	/// Definition of functions for measuring execution time
 	namespace timing { }
 	
+	/// Definition of functions for saving and restoring the state of the algorithms
+	namespace checkpointing { }
+	
+	/// Collection of performance metrics of the algorithms
+	namespace profiling { }
+	
+	/// Execution of the algorithms with several threads
+	namespace concurrency { }
+	
 	/// Structures used by the algorithms
 	namespace structures { }
 	
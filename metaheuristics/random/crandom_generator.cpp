@@ -33,25 +33,18 @@ namespace random {
 
 template<class G, typename cT>
 crandom_generator<G,cT>::crandom_generator() : random_generator<G,cT>() {
-	U = nullptr;
+	init_U = false;
 }
 
 template<class G, typename cT>
-crandom_generator<G,cT>::~crandom_generator() {
-	if (U != nullptr) {
-		delete U;
-	}
-}
+crandom_generator<G,cT>::~crandom_generator() { }
 
 /* Initialisers of the distributions */
 
 template<class G, typename cT>
 void crandom_generator<G,cT>::init_uniform(cT a, cT b) {
-	if (U != nullptr) {
-		delete U;
-		U = nullptr;
-	}
-	U = new std::uniform_real_distribution<cT>(a, b);
+	U = std::uniform_real_distribution<cT>(a, b);
+	init_U = true;
 }
 
 template<class G, typename cT>
@@ -63,9 +56,9 @@ void crandom_generator<G,cT>::init_binomial(cT, double) {
 
 template<class G, typename cT>
 cT crandom_generator<G,cT>::get_uniform() {
-	assert(U != nullptr);
+	assert(init_U);
 
-	cT r = (*U)(random_generator<G,cT>::gen);
+	cT r = U(random_generator<G,cT>::gen);
 	return r;
 }
 
@@ -81,6 +74,20 @@ void crandom_generator<G,cT>::make_n_uniform(cT *u, size_t N) {
 	}
 }
 
+/* State of the generator */
+
+template<class G, typename cT>
+void crandom_generator<G,cT>::write_state(std::ostream& os) const {
+	random_generator<G,cT>::write_state(os);
+	random_generator<G,cT>::write_distribution(os, U, init_U);
+}
+
+template<class G, typename cT>
+bool crandom_generator<G,cT>::read_state(std::istream& is) {
+	return random_generator<G,cT>::read_state(is) and
+		   random_generator<G,cT>::read_distribution(is, U, init_U);
+}
+
 } // -- namespace random
 } // -- namespace metaheuristics
 
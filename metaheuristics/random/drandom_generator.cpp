@@ -26,65 +26,103 @@
 #include <metaheuristics/random/random_generator.hpp>
 
 // C++ includes
+#include <type_traits>
 #include <cassert>
+#include <cstdint>
+#include <limits>
 
 namespace metaheuristics {
 namespace random {
 
 template<class G, typename dT>
 drandom_generator<G,dT>::drandom_generator() : random_generator<G,dT>() {
-	U = nullptr;
-	B = nullptr;
+	init_U = false;
+	init_B = false;
 }
 
 template<class G, typename dT>
-drandom_generator<G,dT>::~drandom_generator() {
-	if (U != nullptr) {
-		delete U;
-	}
-	if (B != nullptr) {
-		delete B;
-	}
-}
+drandom_generator<G,dT>::~drandom_generator() { }
 
 /* Initialisers of the distributions */
 
 template<class G, typename dT>
 void drandom_generator<G,dT>::init_uniform(dT a, dT b) {
-	if (U != nullptr) {
-		delete U;
-		U = nullptr;
-	}
-	U = new std::uniform_int_distribution<dT>(a, b);
+	U = std::uniform_int_distribution<dT>(a, b);
+	init_U = true;
 }
 
 template<class G, typename dT>
 void drandom_generator<G,dT>::init_binomial(dT a, double p) {
-	if (B != nullptr) {
-		delete B;
-		B = nullptr;
-	}
-	B = new std::binomial_distribution<dT>(a, p);
+	B = std::binomial_distribution<dT>(a, p);
+	init_B = true;
 }
 
 /* Get pseudo-random numbers */
 
 template<class G, typename dT>
 dT drandom_generator<G,dT>::get_uniform() {
-	assert(U != nullptr);
+	assert(init_U);
 
-	dT r = (*U)(random_generator<G,dT>::gen);
+	dT r = U(random_generator<G,dT>::gen);
 	return r;
 }
 
 template<class G, typename dT>
 dT drandom_generator<G,dT>::get_binomial() {
-	assert(B != nullptr);
+	assert(init_B);
 
-	dT r = (*B)(random_generator<G,dT>::gen);
+	dT r = B(random_generator<G,dT>::gen);
 	return r;
 }
 
+template<class G, typename dT>
+dT drandom_generator<G,dT>::get_uniform_in(dT a, dT b) {
+	assert(a <= b);
+	
+	typedef typename std::make_unsigned<dT>::type udT;
+	G& gen = random_generator<G,dT>::gen;
+	
+	// the method needs words in which every bit is random
+	constexpr bool words32 =
+		G::min() == 0 and G::max() == std::numeric_limits<uint32_t>::max();
+	constexpr bool words64 =
+		G::min() == 0 and G::max() == std::numeric_limits<uint64_t>::max();
+	
+	// number of values in [a,b], minus one
+	const udT range = udT(b) - udT(a);
+	
+	if constexpr (words32 or words64) {
+		if (uint64_t(range) < std::numeric_limits<uint32_t>::max()) {
+			// the upper bits of a 64-bit word are the best ones
+			auto word =
+			[&]() -> uint64_t {
+				return uint32_t(gen() >> (words64 ? 32 : 0));
+			};
+			
+			// a 32-bit word x in [0, 2^32) is mapped onto (x*s)/2^32 in
+			// [0, s). The low half of the product is the position of x
+			// within its value: words whose low half is smaller than
+			// 2^32 mod s are rejected, so that every value has the same
+			// number of words.
+			const uint32_t s = uint32_t(range) + 1;
+			uint64_t m = word()*s;
+			uint32_t l = uint32_t(m);
+			if (l < s) {
+				const uint32_t t = uint32_t(-s)%s;
+				while (l < t) {
+					m = word()*s;
+					l = uint32_t(m);
+				}
+			}
+			return dT(udT(a) + udT(m >> 32));
+		}
+	}
+	
+	// the interval does not fit the words of the engine
+	std::uniform_int_distribution<dT> D(a, b);
+	return D(gen);
+}
+
 template<class G, typename dT>
 void drandom_generator<G,dT>::make_n_uniform(dT *u, size_t N) {
 	for (size_t i = 0; i < N; ++i) {
@@ -92,6 +130,22 @@ void drandom_generator<G,dT>::make_n_uniform(dT *u, size_t N) {
 	}
 }
 
+/* State of the generator */
+
+template<class G, typename dT>
+void drandom_generator<G,dT>::write_state(std::ostream& os) const {
+	random_generator<G,dT>::write_state(os);
+	random_generator<G,dT>::write_distribution(os, U, init_U);
+	random_generator<G,dT>::write_distribution(os, B, init_B);
+}
+
+template<class G, typename dT>
+bool drandom_generator<G,dT>::read_state(std::istream& is) {
+	return random_generator<G,dT>::read_state(is) and
+		   random_generator<G,dT>::read_distribution(is, U, init_U) and
+		   random_generator<G,dT>::read_distribution(is, B, init_B);
+}
+
 } // -- namespace random
 } // -- namespace metaheuristics
 
@@ -25,6 +25,12 @@
 
 #include <metaheuristics/random/random_generator.hpp>
 
+// C++ includes
+#include <sstream>
+
+// metaheuristics includes
+#include <metaheuristics/misc/checkpoint.hpp>
+
 namespace metaheuristics {
 namespace random {
 
@@ -41,6 +47,64 @@ void random_generator<G,T>::seed_random_engine() {
 	gen = G(r());
 }
 
+template<class G, typename T>
+void random_generator<G,T>::seed_random_engine(uint64_t s, uint64_t stream) {
+	std::seed_seq seq{
+		static_cast<uint32_t>(s), static_cast<uint32_t>(s >> 32),
+		static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32)
+	};
+	gen = G(seq);
+}
+
+template<class G, typename T>
+void random_generator<G,T>::write_state(std::ostream& os) const {
+	std::ostringstream ss;
+	ss << gen;
+	checkpointing::write_string(os, ss.str());
+}
+
+template<class G, typename T>
+bool random_generator<G,T>::read_state(std::istream& is) {
+	std::string s;
+	if (not checkpointing::read_string(is, s)) {
+		return false;
+	}
+	std::istringstream ss(s);
+	ss >> gen;
+	return not ss.fail();
+}
+
+template<class G, typename T>
+template<class D>
+void random_generator<G,T>::write_distribution(std::ostream& os, const D& d, bool init) {
+	checkpointing::write_value(os, init);
+	if (init) {
+		std::ostringstream ss;
+		ss << d;
+		checkpointing::write_string(os, ss.str());
+	}
+}
+
+template<class G, typename T>
+template<class D>
+bool random_generator<G,T>::read_distribution(std::istream& is, D& d, bool& init) {
+	if (not checkpointing::read_value(is, init)) {
+		return false;
+	}
+	if (not init) {
+		d = D();
+		return true;
+	}
+	
+	std::string s;
+	if (not checkpointing::read_string(is, s)) {
+		return false;
+	}
+	std::istringstream ss(s);
+	ss >> d;
+	return not ss.fail();
+}
+
 } // -- namespace random
 } // -- namespace metaheuristics
 
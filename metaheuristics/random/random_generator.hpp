@@ -24,6 +24,8 @@
 #pragma once
 
 // C++ includes
+#include <iostream>
+#include <cstdint>
 #include <random>
 
 namespace metaheuristics {
@@ -62,6 +64,14 @@ class random_generator {
 		
 		/// Initialises the random engine.
 		virtual void seed_random_engine();
+		/**
+		 * @brief Initialises the random engine with a fixed seed.
+		 * 
+		 * Generators seeded with the same seed @e s and the same
+		 * @e stream generate the same sequence of numbers. Different
+		 * streams lead to different sequences.
+		 */
+		virtual void seed_random_engine(uint64_t s, uint64_t stream = 0);
 		
 		/**
 		 * @brief Initialise the uniform distribution.
@@ -85,10 +95,36 @@ class random_generator {
 		
 		/// Generate @e N uniform values and stores them in @e u
 		virtual void make_n_uniform(T *u, size_t N) = 0;
+		
+		/**
+		 * @brief Writes the state of the generator into @e os.
+		 * 
+		 * The state consists of the state of the random engine and
+		 * of the distributions, so that the sequence of numbers
+		 * generated after calling @ref read_state is exactly the
+		 * same as the sequence generated after calling this method.
+		 */
+		virtual void write_state(std::ostream& os) const;
+		/**
+		 * @brief Restores the state written with @ref write_state.
+		 * @returns Returns false if the state could not be read.
+		 */
+		virtual bool read_state(std::istream& is);
 
 	protected:
 		/// Random engine.
 		G gen;
+		
+		/**
+		 * @brief Writes the state of distribution @e d.
+		 * @param init Whether @e d was initialised or not. The state
+		 * of @e d is only written if it was.
+		 */
+		template<class D>
+		static void write_distribution(std::ostream& os, const D& d, bool init);
+		/// Reads the state of a distribution written with @ref write_distribution.
+		template<class D>
+		static bool read_distribution(std::istream& is, D& d, bool& init);
 
 }; // -- class random_generator
 
@@ -98,6 +134,9 @@ class random_generator {
  * Class that generates discrete numbers in both uniform and binomial
  * distributions.
  *
+ * The class is final so that calls through a pointer or a reference
+ * to it are not dispatched through the virtual table.
+ *
  * @param G The random engine used to generate the numbers.
  * @param T The type of the numbers generated (int, char, unsigned int, ...).
  */
@@ -106,7 +145,7 @@ template<
 	typename dT = size_t				  // type of the discrete distributions
 										  // int, char, unsigned int, size_t, ...
 >
-class drandom_generator : public random_generator<G,dT> {
+class drandom_generator final : public random_generator<G,dT> {
 	public:
 		/// Constructor.
 		drandom_generator();
@@ -119,14 +158,43 @@ class drandom_generator : public random_generator<G,dT> {
 		dT get_uniform();
 		dT get_binomial();
 		
+		/**
+		 * @brief Generates a number uniformly at random in [a,b].
+		 * 
+		 * Unlike @ref get_uniform, the interval is given at every
+		 * call, and the distribution initialised with @ref init_uniform
+		 * is not modified. Use it when the interval changes after
+		 * every number generated.
+		 * 
+		 * If the random engine generates 32-bit or 64-bit words the
+		 * number is computed with Lemire's method, which needs a
+		 * division only when the word drawn has to be rejected:
+		 \verbatim
+		 Fast Random Integer Generation in an Interval
+		 Lemire, Daniel
+		 2019, ACM Transactions on Modeling and Computer Simulation, Volume 29, Number 1
+		 \endverbatim
+		 * Otherwise, it is generated with a uniform distribution over
+		 * [a,b].
+		 * @pre @e a <= @e b.
+		 */
+		dT get_uniform_in(dT a, dT b);
+		
 		void make_n_uniform(dT *u, size_t N);
+		
+		void write_state(std::ostream& os) const;
+		bool read_state(std::istream& is);
 
 	private:
 		/// Object to generate integer numbers uniformly at random.
-		std::uniform_int_distribution<dT> *U;
+		std::uniform_int_distribution<dT> U;
+		/// Was @ref U initialised?
+		bool init_U;
 
 		/// Object to generate the numbers following a binomial distribution.
-		std::binomial_distribution<dT> *B;
+		std::binomial_distribution<dT> B;
+		/// Was @ref B initialised?
+		bool init_B;
 		
 }; // -- class drandom_generator
 
@@ -135,6 +203,9 @@ class drandom_generator : public random_generator<G,dT> {
  *
  * Class that generates continuous numbers only in the uniform distribution.
  *
+ * The class is final so that calls through a pointer or a reference
+ * to it are not dispatched through the virtual table.
+ *
  * @param G The random engine used to generate the numbers.
  * @param T The type of the numbers generated (double, float).
  */
@@ -143,7 +214,7 @@ template<
 	typename cT = double				  // type of the continuous distributions
 										  // float, double
 >
-class crandom_generator : public random_generator<G,cT> {
+class crandom_generator final : public random_generator<G,cT> {
 	public:
 		/// Constructor.
 		crandom_generator();
@@ -161,10 +232,15 @@ class crandom_generator : public random_generator<G,cT> {
 		cT get_binomial();
 		
 		void make_n_uniform(cT *u, size_t N);
+		
+		void write_state(std::ostream& os) const;
+		bool read_state(std::istream& is);
 
 	private:
 		/// Object to generate floating point numbers uniformly at random.
-		std::uniform_real_distribution<cT> *U;
+		std::uniform_real_distribution<cT> U;
+		/// Was @ref U initialised?
+		bool init_U;
 
 }; // -- class crandom_generator
 
@@ -26,6 +26,8 @@
 #include <metaheuristics/structures/infeasible_exception.hpp>
 #include <metaheuristics/structures/individual.hpp>
 #include <metaheuristics/structures/chromosome.hpp>
+#include <metaheuristics/structures/fixed16.hpp>
 #include <metaheuristics/structures/policies.hpp>
 #include <metaheuristics/structures/problem.hpp>
+#include <metaheuristics/structures/problem_pool.hpp>
 #include <metaheuristics/random/random_generator.hpp>
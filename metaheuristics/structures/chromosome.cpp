@@ -21,6 +21,8 @@
  * 
  *********************************************************************/
 
+#pragma once
+
 #include <metaheuristics/structures/chromosome.hpp>
 
 // C includes
@@ -33,19 +35,22 @@
 namespace metaheuristics {
 namespace structures {
 
-chromosome::~chromosome() {
+template<typename T>
+chromosome<T>::~chromosome() {
 	clear();
 }
 
 // MEMORY HANDLING
 
-void chromosome::init() {
+template<typename T>
+void chromosome<T>::init() {
 	assert(0 < n_genes);
 	
-	genes = static_cast<double *>(malloc(n_genes*sizeof(double)));
+	genes = static_cast<T *>(malloc(n_genes*sizeof(T)));
 }
 
-void chromosome::clear() {
+template<typename T>
+void chromosome<T>::clear() {
 	if (genes != nullptr) {
 		n_genes = 0;
 		free(genes);
@@ -55,36 +60,41 @@ void chromosome::clear() {
 
 // OPERATORS
 
-chromosome& chromosome::operator= (const chromosome& c) {
+template<typename T>
+chromosome<T>& chromosome<T>::operator= (const chromosome& c) {
 	if (n_genes != c.n_genes) {
 		clear();
 		n_genes = c.n_genes;
-		genes = static_cast<double *>(malloc(n_genes*sizeof(double)));
+		genes = static_cast<T *>(malloc(n_genes*sizeof(T)));
 	}
 	
-	memcpy(genes, c.genes, n_genes*sizeof(double));
+	memcpy(genes, c.genes, n_genes*sizeof(T));
 	return *this;
 }
 
-double& chromosome::operator[] (size_t i) {
+template<typename T>
+T& chromosome<T>::operator[] (size_t i) {
 	assert(i < n_genes);
 	return genes[i];
 }
 
-const double& chromosome::operator[] (size_t i) const {
+template<typename T>
+const T& chromosome<T>::operator[] (size_t i) const {
 	assert(i < n_genes);
 	return genes[i];
 }
 
 // SETTERS
 
-void chromosome::set_size(size_t Ng) {
+template<typename T>
+void chromosome<T>::set_size(size_t Ng) {
 	n_genes = Ng;
 }
 
 // GETTERS
 
-size_t chromosome::size() const {
+template<typename T>
+size_t chromosome<T>::size() const {
 	return (genes != nullptr ? n_genes : 0);
 }
 	
@@ -26,6 +26,9 @@
 // C++ includes
 #include <fstream>
 
+// metaheuristics includes
+#include <metaheuristics/structures/fixed16.hpp>
+
 namespace metaheuristics {
 namespace structures {
 
@@ -35,9 +38,20 @@ namespace structures {
  * A chromosome is a number of genes (see @ref n_genes)
  * that are basically floating point numbers between 0 and 1
  * (see @ref genes).
+ * 
+ * @param T The type of the genes: double, float or @ref fixed16.
+ * The genes must be trivially copyable, and convertible from and
+ * to double.
  */
+template<
+	typename T = double
+>
 class chromosome {
 	public:
+		/// The type of the genes.
+		typedef T gene_type;
+		
+
 		/// Default constructor
 		chromosome() = default;
 		/// Destructor
@@ -46,7 +60,7 @@ class chromosome {
 		// MEMORY HANDLING
 		
 		/**
-		 * @brief Allocates as many floating point values as @ref n_genes
+		 * @brief Allocates as many genes as @ref n_genes
 		 * @pre Variable @ref n_genes must have a strictly positive value.
 		 */
 		void init();
@@ -90,13 +104,13 @@ class chromosome {
 		 * 
 		 * Returns a reference to the i-th gene
 		 */
-		double& operator[] (size_t i);
+		T& operator[] (size_t i);
 		/**
 		 * @brief Acces the i-th gene
 		 * 
 		 * Returns a constant reference to the i-th gene
 		 */
-		const double& operator[] (size_t i) const;
+		const T& operator[] (size_t i) const;
 		
 		// SETTERS
 		
@@ -117,7 +131,7 @@ class chromosome {
 
 	private:
 		/// The list of values between 0 and 1
-		double *genes = nullptr;
+		T *genes = nullptr;
 		/// The size of @ref genes
 		size_t n_genes = 0;
 };
@@ -125,3 +139,5 @@ class chromosome {
 } // -- namespace structures
 } // -- namespace metaheuristics
 
+#include <metaheuristics/structures/chromosome.cpp>
+
@@ -0,0 +1,80 @@
+/*********************************************************************
+ *
+ * Collection of heuristic and metaheuristic algorithms
+ *
+ * Copyright (C) 2018-2020  Lluís Alemany Puig
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Contact: Lluís Alemany Puig (lluis.alemany.puig@gmail.com)
+ * 
+ *********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <cstdint>
+
+namespace metaheuristics {
+namespace structures {
+
+/**
+ * @brief 16-bit fixed-point gene.
+ * 
+ * A number in [0,1) stored in 16 bits: its value is the integer
+ * in @ref bits divided by 2^16. Chromosomes with genes of this type
+ * (see @ref chromosome) take a quarter of the memory of chromosomes
+ * with genes of type double, which suffices for decoders that only
+ * need the order of the genes, or that compare them against coarse
+ * thresholds.
+ * 
+ * A value is rounded down to the nearest multiple of 2^-16. Values
+ * smaller than 0 are stored as 0, and values equal to or larger than
+ * 1 as the largest value smaller than 1.
+ */
+class fixed16 {
+	public:
+		/// Default constructor. The value is 0.
+		fixed16() = default;
+		/// Constructor with a value in [0,1).
+		fixed16(double v) : bits(from_double(v)) { }
+		
+		/// Returns the value of the gene.
+		operator double() const {
+			return static_cast<double>(bits)*(1.0/65536.0);
+		}
+		
+		/// Returns the value of the gene as an integer in [0, 2^16).
+		uint16_t get_bits() const {
+			return bits;
+		}
+
+	private:
+		/// The value of the gene multiplied by 2^16.
+		uint16_t bits = 0;
+		
+		/// Returns the bits of value @e v.
+		static uint16_t from_double(double v) {
+			if (v <= 0.0) {
+				return 0;
+			}
+			if (v >= 1.0) {
+				return UINT16_MAX;
+			}
+			return static_cast<uint16_t>(v*65536.0);
+		}
+};
+
+} // -- namespace structures
+} // -- namespace metaheuristics
@@ -21,31 +21,37 @@
  * 
  *********************************************************************/
 
+#pragma once
+
 #include <metaheuristics/structures/individual.hpp>
 
 namespace metaheuristics {
 namespace structures {
 
-individual::individual(size_t n) {
+template<typename T>
+individual<T>::individual(size_t n) {
 	fitness = 0.0;
 	c.set_size(n);
 }
 
 // MEMORY HANDLING
 		
-void individual::init() {
+template<typename T>
+void individual<T>::init() {
 	fitness = 0;
 	c.init();
 }
 
-void individual::clear() {
+template<typename T>
+void individual<T>::clear() {
 	fitness = 0;
 	c.clear();
 }
 
 // OPERATRS
 
-individual& individual::operator= (const individual& i) {
+template<typename T>
+individual<T>& individual<T>::operator= (const individual& i) {
 	fitness = i.fitness;
 	c = i.c;
 	return *this;
@@ -53,33 +59,40 @@ individual& individual::operator= (const individual& i) {
 
 // SETTERS
 
-void individual::set_fitness(double f) {
+template<typename T>
+void individual<T>::set_fitness(double f) {
 	fitness = f;
 }
 
-void individual::set_gene(size_t i, double g) {
+template<typename T>
+void individual<T>::set_gene(size_t i, T g) {
 	c[i] = g;
 }
 
-void individual::set_n_genes(size_t n) {
+template<typename T>
+void individual<T>::set_n_genes(size_t n) {
 	c.set_size(n);
 }
 
 // GETTERS
 
-chromosome& individual::get_chromosome() {
+template<typename T>
+chromosome<T>& individual<T>::get_chromosome() {
 	return c;
 }
 
-const chromosome& individual::get_chromosome() const {
+template<typename T>
+const chromosome<T>& individual<T>::get_chromosome() const {
 	return c;
 }
 
-double individual::get_fitness() const {
+template<typename T>
+double individual<T>::get_fitness() const {
 	return fitness;
 }
 
-double individual::get_gene(size_t i) const {
+template<typename T>
+T individual<T>::get_gene(size_t i) const {
 	return c[i];
 }
 
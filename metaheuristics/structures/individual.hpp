@@ -25,6 +25,7 @@
 
 // C++ includes
 #include <fstream>
+#include <limits>
 
 // metaheursitics includes
 #include <metaheuristics/structures/chromosome.hpp>
@@ -109,7 +110,12 @@ class allocator_individual {
  * 
  * An individual (in the context of genetic algorithms) is a chromosome
  * (see @ref c) and its value of fitness (see @ref fitness).
+ * 
+ * @param T The type of the genes of the chromosome (see @ref chromosome).
  */
+template<
+	typename T = double
+>
 class individual {
 	public:
 		/// Default constructor.
@@ -164,7 +170,7 @@ class individual {
 		 * 
 		 * Sets the i-th value of @ref chromosome::genes to @e g.
 		 */
-		void set_gene(size_t i, double g);
+		void set_gene(size_t i, T g);
 		/**
 		 * @brief Sets the number of genes of this individual's chromosome.
 		 * 
@@ -175,9 +181,9 @@ class individual {
 		// GETTERS
 		
 		/// Returns a non-constant refernce of @ref c.
-		chromosome& get_chromosome();
+		chromosome<T>& get_chromosome();
 		/// Returns a constant refernce of @ref c.
-		const chromosome& get_chromosome() const;
+		const chromosome<T>& get_chromosome() const;
 		
 		/**
 		 * @brief Returns the fitness of this individual.
@@ -188,11 +194,11 @@ class individual {
 		 * @brief Returns the i-th gene of this individual.
 		 * @returns Returns the i-th value of @ref chromosome::genes.
 		 */
-		double get_gene(size_t i) const;
+		T get_gene(size_t i) const;
 
 	private:
 		/// The chromosome of the individual.
-		chromosome c;
+		chromosome<T> c;
 		/// The fitness of the individual.
 		double fitness = 0.0;
 };
@@ -200,3 +206,4 @@ class individual {
 } // -- namespace structures
 } // -- namespace metaheuristics
 
+#include <metaheuristics/structures/individual.cpp>
@@ -24,19 +24,101 @@
 #pragma once
 
 #include <metaheuristics/structures/problem.hpp>
+#include <metaheuristics/structures/problem_pool.hpp>
 
 namespace metaheuristics {
 namespace structures {
 
+// PRIVATE
+
+template<class G>
+template<typename T>
+double problem<G>::decode_as_double(const chromosome<T>& c) {
+	chromosome<> d;
+	d.set_size(c.size());
+	if (c.size() > 0) {
+		d.init();
+		for (size_t i = 0; i < c.size(); ++i) {
+			d[i] = static_cast<double>(c[i]);
+		}
+	}
+	return decode(d);
+}
+
 // PROTECTED
 
+template<class G>
+problem<G> *problem<G>::acquire_neighbour() const {
+	if (neighbour_pool == nullptr) {
+		++n_neighbours_allocated;
+		return clone();
+	}
+	bool allocated = false;
+	problem<G> *p = neighbour_pool->acquire_clone(this, &allocated);
+	if (allocated) {
+		++n_neighbours_allocated;
+	}
+	return p;
+}
+
+template<class G>
+void problem<G>::release_neighbour(problem<G> *p) const {
+	if (neighbour_pool == nullptr) {
+		delete p;
+	}
+	else {
+		neighbour_pool->release(p);
+	}
+}
+
 // PUBLIC
 
+template<class G>
+problem<G>::problem(const problem<G>& p) {
+	n_neighbours_explored = p.n_neighbours_explored;
+}
+
+template<class G>
+problem<G>& problem<G>::operator= (const problem<G>& p) {
+	n_neighbours_explored = p.n_neighbours_explored;
+	return *this;
+}
+
+template<class G>
+double problem<G>::decode(const chromosome<float>& c) {
+	return decode_as_double(c);
+}
+
+template<class G>
+double problem<G>::decode(const chromosome<fixed16>& c) {
+	return decode_as_double(c);
+}
+
+template<class G>
+bool problem<G>::write_solution(std::ostream&) const {
+	return false;
+}
+
+template<class G>
+bool problem<G>::read_solution(std::istream&) {
+	return false;
+}
+
 template<class G>
 size_t problem<G>::get_n_neighbours_explored() const {
 	return n_neighbours_explored;
 }
 
+template<class G>
+size_t problem<G>::get_n_neighbours_allocated() const {
+	return n_neighbours_allocated;
+}
+
+template<class G>
+void problem<G>::set_neighbour_pool(problem_pool<G> *p) {
+	neighbour_pool = p;
+}
+
 } // -- namespace structures
 } // -- namespace metaheuristics
 
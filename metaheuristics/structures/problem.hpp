@@ -35,6 +35,8 @@
 namespace metaheuristics {
 namespace structures {
 
+template<class G> class problem_pool;
+
 /**
  * @brief Definition of the problem to be solved.
  * 
@@ -45,6 +47,13 @@ namespace structures {
  * and simple construction of solutions. Also, it defines functions
  * for debugging, like sanity checks, printing, ...
  * 
+ * The algorithms call these functions through this interface by
+ * default. They can also be given the class implementing the problem
+ * as a template parameter (for example, @ref algorithms::rkga<G,P>):
+ * if that class is declared @e final the calls in their inner loops
+ * (to @ref decode, @ref best_neighbour, @ref random_construct) are
+ * resolved at compile time and can be inlined.
+ * 
  * @param G The type of engine used in the random generator in function
  * @ref random_construct(drandom_generator<G,size_t>*, double).
  */
@@ -55,9 +64,14 @@ class problem {
 	public:
 		/// Default constructor.
 		problem() = default;
+		/// Copy constructor. The pool of neighbours is not copied.
+		problem(const problem& p);
 		/// Destructor.
 		virtual ~problem() = default;
 		
+		/// Copy assignment. The pool of neighbours is not copied.
+		problem& operator= (const problem& p);
+		
 		// Constructing a solution
 		
 		/**
@@ -88,6 +102,10 @@ class problem {
 		 * The best neighbour is the solution that maximises the
 		 * @ref evaluate() function.
 		 * 
+		 * The neighbours should be obtained with @ref acquire_neighbour,
+		 * and those discarded freed with @ref release_neighbour, so that
+		 * the local search can recycle them (see @ref set_neighbour_pool).
+		 * 
 		 * @param[out] best_neighbour The best neighbour of this problem.
 		 * @param[in] p The local search policy.
 		 * 
@@ -125,7 +143,27 @@ class problem {
 		 * @brief Constructs a solution from a given chromosome.
 		 * @returns Returns the evaluation of the solution (its cost).
 		 */
-		virtual double decode(const chromosome& c) noexcept(false) = 0;
+		virtual double decode(const chromosome<>& c) noexcept(false) = 0;
+		/**
+		 * @brief Constructs a solution from a chromosome with genes
+		 * of type float.
+		 * 
+		 * By default, copies the genes into a chromosome with genes of
+		 * type double and calls @ref decode(const chromosome<>&). Problems
+		 * solved with genes of type float should override this method.
+		 * @returns Returns the evaluation of the solution (its cost).
+		 */
+		virtual double decode(const chromosome<float>& c) noexcept(false);
+		/**
+		 * @brief Constructs a solution from a chromosome with genes
+		 * of type @ref fixed16.
+		 * 
+		 * By default, copies the genes into a chromosome with genes of
+		 * type double and calls @ref decode(const chromosome<>&). Problems
+		 * solved with genes of type @ref fixed16 should override this method.
+		 * @returns Returns the evaluation of the solution (its cost).
+		 */
+		virtual double decode(const chromosome<fixed16>& c) noexcept(false);
 		
 		// Evaluating a solution
 		
@@ -153,6 +191,26 @@ class problem {
 		virtual bool sanity_check(std::ostream& os, const std::string& tab = "")
 		const = 0;
 		
+		// Saving a solution
+		
+		/**
+		 * @brief Writes this solution into a binary stream.
+		 * 
+		 * Needed only by the algorithms that store a solution in
+		 * their checkpoints (see @ref algorithms::grasp). The default
+		 * implementation writes nothing.
+		 * @returns Returns false if the solution could not be written.
+		 */
+		virtual bool write_solution(std::ostream& os) const;
+		
+		/**
+		 * @brief Reads a solution written with @ref write_solution.
+		 * 
+		 * The default implementation reads nothing.
+		 * @returns Returns false if the solution could not be read.
+		 */
+		virtual bool read_solution(std::istream& is);
+		
 		// Memory handling
 		
 		/**
@@ -196,6 +254,27 @@ class problem {
 		 * This function returns the value of @ref n_neighbours_explored.
 		 */
 		size_t get_n_neighbours_explored() const;
+		/**
+		 * @brief Returns the number of neighbours allocated.
+		 * 
+		 * Counts the neighbours made by @ref acquire_neighbour that
+		 * could not be taken from the pool, since this object was
+		 * built. Unlike @ref n_neighbours_explored, it is not copied
+		 * along with the solution.
+		 */
+		size_t get_n_neighbours_allocated() const;
+		
+		// Setters
+		
+		/**
+		 * @brief Sets the pool from which the neighbours are taken.
+		 * 
+		 * The local search sets its pool of solutions before exploring
+		 * the neighbourhood of this solution, and resets it to nullptr
+		 * afterwards. The pool is not copied along with the solution.
+		 * @param p A pool of solutions of the same instance, or nullptr.
+		 */
+		void set_neighbour_pool(problem_pool<G> *p);
 
 	protected:
 		/**
@@ -203,6 +282,38 @@ class problem {
 		 * the procedure.
 		 */
 		size_t n_neighbours_explored = 0;
+		
+		/**
+		 * @brief Returns a copy of this solution to be made a neighbour.
+		 * 
+		 * The copy is taken from the pool set with @ref set_neighbour_pool
+		 * (see @ref problem_pool::acquire_clone), or is the result of
+		 * @ref clone if there is none. It must be freed with
+		 * @ref release_neighbour, unless it is returned by
+		 * @ref best_neighbour.
+		 */
+		problem *acquire_neighbour() const;
+		/**
+		 * @brief Frees a neighbour obtained with @ref acquire_neighbour.
+		 * 
+		 * The neighbour is released into the pool set with
+		 * @ref set_neighbour_pool, or deleted if there is none.
+		 * Does nothing if @e p is null.
+		 */
+		void release_neighbour(problem *p) const;
+
+	private:
+		/// Pool of the neighbours (see @ref set_neighbour_pool).
+		problem_pool<G> *neighbour_pool = nullptr;
+		/// Neighbours allocated (see @ref get_n_neighbours_allocated).
+		mutable size_t n_neighbours_allocated = 0;
+		
+		/**
+		 * @brief Decodes a copy of @e c with genes of type double.
+		 * @returns Returns the evaluation of the solution (its cost).
+		 */
+		template<typename T>
+		double decode_as_double(const chromosome<T>& c);
 };
 
 } // -- namespace structures
@@ -0,0 +1,131 @@
+/*********************************************************************
+ *
+ * Collection of heuristic and metaheuristic algorithms
+ *
+ * Copyright (C) 2018-2020  Lluís Alemany Puig
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Contact: Lluís Alemany Puig (lluis.alemany.puig@gmail.com)
+ * 
+ *********************************************************************/
+
+#pragma once
+
+#include <metaheuristics/structures/problem_pool.hpp>
+
+// C++ includes
+#include <atomic>
+
+namespace metaheuristics {
+namespace structures {
+
+// PUBLIC
+
+template<class G>
+problem_pool<G>::problem_pool(size_t c) {
+	static std::atomic<uint64_t> next_id(1);
+	capacity = c;
+	id = next_id++;
+}
+
+template<class G>
+problem_pool<G>::~problem_pool() {
+	clear();
+}
+
+template<class G>
+problem<G> *problem_pool<G>::acquire_empty(const problem<G> *p, bool *allocated) {
+	free_list& l = local_list();
+	if (allocated != nullptr) {
+		*allocated = l.empty();
+	}
+	if (l.empty()) {
+		return p->empty();
+	}
+	// the solutions are cleared when released
+	problem<G> *s = l.back();
+	l.pop_back();
+	return s;
+}
+
+template<class G>
+problem<G> *problem_pool<G>::acquire_clone(const problem<G> *p, bool *allocated) {
+	free_list& l = local_list();
+	if (allocated != nullptr) {
+		*allocated = l.empty();
+	}
+	if (l.empty()) {
+		return p->clone();
+	}
+	problem<G> *s = l.back();
+	l.pop_back();
+	s->copy(p);
+	return s;
+}
+
+template<class G>
+void problem_pool<G>::release(problem<G> *p) {
+	if (p == nullptr) {
+		return;
+	}
+	free_list& l = local_list();
+	if (l.size() >= capacity) {
+		delete p;
+		return;
+	}
+	p->clear();
+	l.push_back(p);
+}
+
+template<class G>
+void problem_pool<G>::clear() {
+	std::lock_guard<std::mutex> lock(m);
+	for (auto& tl : lists) {
+		for (problem<G> *p : *tl.second) {
+			delete p;
+		}
+		tl.second->clear();
+	}
+}
+
+template<class G>
+size_t problem_pool<G>::get_capacity() const {
+	return capacity;
+}
+
+// PRIVATE
+
+template<class G>
+typename problem_pool<G>::free_list& problem_pool<G>::local_list() {
+	// the list of the last pool used by this thread, so that the
+	// lists are looked up only when a thread changes of pool
+	static thread_local uint64_t cached_id = 0;
+	static thread_local free_list *cached_list = nullptr;
+	if (cached_id == id) {
+		return *cached_list;
+	}
+	
+	std::lock_guard<std::mutex> lock(m);
+	std::unique_ptr<free_list>& l = lists[std::this_thread::get_id()];
+	if (l == nullptr) {
+		l.reset(new free_list());
+	}
+	cached_id = id;
+	cached_list = l.get();
+	return *cached_list;
+}
+
+} // -- namespace structures
+} // -- namespace metaheuristics
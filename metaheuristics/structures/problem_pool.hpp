@@ -0,0 +1,149 @@
+/*********************************************************************
+ *
+ * Collection of heuristic and metaheuristic algorithms
+ *
+ * Copyright (C) 2018-2020  Lluís Alemany Puig
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * Contact: Lluís Alemany Puig (lluis.alemany.puig@gmail.com)
+ * 
+ *********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <map>
+
+// metaheuristics includes
+#include <metaheuristics/structures/problem.hpp>
+
+namespace metaheuristics {
+namespace structures {
+
+/**
+ * @brief Pool of solutions of a problem.
+ * 
+ * The algorithms allocate and free many solutions: an empty solution
+ * in every iteration of GRASP, a copy of the problem to decode every
+ * chromosome, a neighbour in every iteration of the local search.
+ * Instead of freeing them, they are released into a pool, cleared with
+ * @ref problem::clear, and handed out again when a new solution is
+ * needed. Problems whose method @ref problem::clear keeps the memory
+ * of the solution then need no allocations once the pool is warm.
+ * 
+ * Every thread has its own list of free solutions, so threads do not
+ * compete for the pool when they acquire or release solutions. A list
+ * keeps at most @ref get_capacity solutions: the ones released beyond
+ * that are freed.
+ * 
+ * All the solutions of a pool must be solutions of the same instance
+ * of the problem, since the solutions handed out are solutions
+ * released earlier.
+ * 
+ * @param G The type of engine used in the random generator of the problem.
+ */
+template<
+	class G = std::default_random_engine
+>
+class problem_pool {
+	public:
+		/**
+		 * @brief Constructor.
+		 * @param c Maximum number of free solutions of every thread
+		 * (see @ref get_capacity).
+		 */
+		problem_pool(size_t c = 16);
+		/// Destructor. Frees the solutions in the pool.
+		~problem_pool();
+		
+		problem_pool(const problem_pool&) = delete;
+		problem_pool& operator= (const problem_pool&) = delete;
+		
+		/**
+		 * @brief Returns an empty solution.
+		 * 
+		 * The solution is a free solution of the current thread or,
+		 * if there is none, the result of @ref problem::empty of @e p.
+		 * It must be released with @ref release.
+		 * @param p The solution whose empty solution is needed.
+		 * @param[out] allocated If not null, set to true if the solution
+		 * was allocated with @ref problem::empty, and to false if it
+		 * was taken from the pool.
+		 */
+		problem<G> *acquire_empty(const problem<G> *p, bool *allocated = nullptr);
+		/**
+		 * @brief Returns a copy of @e p.
+		 * 
+		 * The solution is a free solution of the current thread into
+		 * which @e p is copied (see @ref problem::copy) or, if there is
+		 * none, the result of @ref problem::clone of @e p. It must be
+		 * released with @ref release.
+		 * @param p The solution to be copied.
+		 * @param[out] allocated If not null, set to true if the solution
+		 * was allocated with @ref problem::clone, and to false if it
+		 * was taken from the pool.
+		 */
+		problem<G> *acquire_clone(const problem<G> *p, bool *allocated = nullptr);
+		/**
+		 * @brief Returns solution @e p to the pool.
+		 * 
+		 * The solution is cleared and kept in the list of the current
+		 * thread, or freed if the list is full. Solutions allocated
+		 * outside the pool (for example, by a @ref problem::best_neighbour
+		 * that clones its neighbours) can also be released. Does nothing
+		 * if @e p is null.
+		 */
+		void release(problem<G> *p);
+		
+		/**
+		 * @brief Frees all the solutions in the pool.
+		 * 
+		 * Must be called when no other thread is using the pool, for
+		 * example before the solutions of another instance of the
+		 * problem are released into it.
+		 */
+		void clear();
+		
+		/// Returns the maximum number of free solutions of every thread.
+		size_t get_capacity() const;
+
+	private:
+		/// Free solutions of a thread.
+		typedef std::vector<problem<G> *> free_list;
+		
+		/// Maximum number of free solutions of every thread.
+		size_t capacity;
+		/// Identifier of this pool, different from that of any other pool.
+		uint64_t id;
+		
+		/// Protects @ref lists.
+		std::mutex m;
+		/// List of free solutions of every thread.
+		std::map<std::thread::id, std::unique_ptr<free_list> > lists;
+		
+	private:
+		/// Returns the list of free solutions of the current thread.
+		free_list& local_list();
+};
+
+} // -- namespace structures
+} // -- namespace metaheuristics
+
+#include <metaheuristics/structures/problem_pool.cpp>